@@ -147,6 +147,15 @@ public:
     Q_DECLARE_FLAGS(WriteOptions, WriteFlag)
     Q_FLAG(WriteOptions)
 
+    enum ReadFlag : uint8_t
+    {
+        ReadAll = 0,
+        // Skip reading audio properties (duration, bitrate, sample rate etc.)
+        SkipAudioProperties = 1 << 0,
+    };
+    Q_DECLARE_FLAGS(ReadOptions, ReadFlag)
+    Q_FLAG(ReadOptions)
+
     virtual ~AudioReader() = default;
 
     /*!
@@ -180,6 +189,13 @@ public:
      */
     virtual bool init(const AudioSource& source);
 
+    /*!
+     * Sets the options used by subsequent @fn readTrack calls.
+     * @returns @c true if all options in @p options are supported.
+     * @note the base class implementation of this function supports no options.
+     */
+    virtual bool setReadOptions(ReadOptions options);
+
     /*!
      * Reads metadata/tags for the given Track @p track.
      * Will only be called after a successful @fn init call.
@@ -260,3 +276,4 @@ using ArchiveReaderCreator = std::function<std::unique_ptr<ArchiveReader>()>;
 
 Q_DECLARE_OPERATORS_FOR_FLAGS(Fooyin::AudioDecoder::DecoderOptions)
 Q_DECLARE_OPERATORS_FOR_FLAGS(Fooyin::AudioReader::WriteOptions)
+Q_DECLARE_OPERATORS_FOR_FLAGS(Fooyin::AudioReader::ReadOptions)
@@ -57,6 +57,7 @@ public:
     [[nodiscard]] std::unique_ptr<AudioDecoder> decoderForTrack(const Track& track) const;
     [[nodiscard]] std::unique_ptr<AudioReader> readerForFile(const QString& file) const;
     [[nodiscard]] std::unique_ptr<AudioReader> readerForTrack(const Track& track) const;
+    [[nodiscard]] QString readerNameForFile(const QString& file) const;
     [[nodiscard]] std::unique_ptr<ArchiveReader> archiveReaderForFile(const QString& file) const;
 
     [[nodiscard]] bool readTrackMetadata(Track& track) const;
@@ -28,7 +28,9 @@
 #include <QString>
 
 #include <mutex>
+#include <numeric>
 #include <ranges>
+#include <vector>
 
 namespace Fooyin {
 class LibraryManager;
@@ -43,147 +45,96 @@ public:
     ~TrackSorter();
 
     /*!
-     * Calculates the sort fields @p tracks using the @p sort script
-     * @param sort the sort script as a string
-     * @param tracks the tracks to calculate
-     * @returns a new TrackList with the calculated sortFields
+     * Evaluates @p sortScript for each of @p items into a side array of (index, key) pairs and sorts it.
+     * The items themselves aren't modified, so their tracks aren't detached.
+     * @param extractor returns a const reference to the Track of an item
+     * @returns the indexes of @p items in sorted order
+     * @see applyPermutation
      */
-    TrackList calcSortFields(const QString& sort, const TrackList& tracks);
+    template <typename Container, typename SortScript, typename Extractor>
+    std::vector<int> sortPermutation(const SortScript& sortScript, const Container& items, Extractor extractor,
+                                     Qt::SortOrder order = Qt::AscendingOrder)
+    {
+        std::vector<int> indexes(items.size());
+        std::iota(indexes.begin(), indexes.end(), 0);
+        return sortPermutation(sortScript, items, indexes, extractor, order);
+    }
 
     /*!
-     * Calculates the sort fields of @p tracks using the parsed @p sort script
-     * @param sortScript the parsed sort script
-     * @param tracks the tracks to calculate
-     * @returns a new TrackList with the calculated sortFields
+     * As above, but only sorts the items in the given @p indexes.
+     * Items not under an index in @p indexes retain their position.
      */
-    [[nodiscard]] TrackList calcSortFields(const ParsedScript& sortScript, const TrackList& tracks);
+    template <typename Container, typename SortScript, typename Extractor>
+    std::vector<int> sortPermutation(const SortScript& sortScript, const Container& items,
+                                     const std::vector<int>& indexes, Extractor extractor,
+                                     Qt::SortOrder order = Qt::AscendingOrder)
+    {
+        std::vector<int> permutation(items.size());
+        std::iota(permutation.begin(), permutation.end(), 0);
 
-    /*!
-     * Sorts @p tracks using their current sort fields
-     * @param tracks the tracks to sort
-     * @param order the order in which to sort the tracks
-     * @returns a new sorted TrackList
-     */
-    static TrackList sortTracks(const TrackList& tracks, Qt::SortOrder order = Qt::AscendingOrder);
+        std::vector<int> validIndexes;
+        std::ranges::copy_if(indexes, std::back_inserter(validIndexes), [&items](int index) {
+            return (index >= 0 && index < static_cast<int>(items.size()));
+        });
 
-    /*!
-     * Calculates the sort fields and then sorts @p tracks
-     * @param sort the sort script as a string
-     * @param tracks the tracks to sort
-     * @param order the order in which to sort the tracks
-     * @returns a new sorted TrackList
-     */
-    TrackList calcSortTracks(const QString& sort, const TrackList& tracks, Qt::SortOrder order = Qt::AscendingOrder);
+        std::vector<SortKey> keys;
+        keys.reserve(validIndexes.size());
+
+        {
+            const std::scoped_lock lock{m_parserGuard};
+            for(const int index : validIndexes) {
+                keys.push_back({.index = index, .key = m_parser.evaluate(sortScript, extractor(items.at(index)))});
+            }
+        }
+
+        sortKeys(keys, order);
+
+        for(size_t i{0}; i < keys.size(); ++i) {
+            permutation[validIndexes.at(i)] = keys.at(i).index;
+        }
+
+        return permutation;
+    }
 
     /*!
-     * Calculates the sort fields and then sorts @p tracks in the given @p indexes.
-     * @param sort the sort script as a string
-     * @param tracks the tracks to sort
-     * @param indexes the indexes to sort
-     * @param order the order in which to sort the tracks
-     * @returns a new sorted TrackList
+     * Evaluates the @p sort script for each of @p tracks, without modifying them.
+     * @returns the sort keys, in the same order as @p tracks
      */
-    TrackList calcSortTracks(const QString& sort, const TrackList& tracks, const std::vector<int>& indexes,
-                             Qt::SortOrder order = Qt::AscendingOrder);
+    std::vector<QString> calcSortKeys(const QString& sort, const TrackList& tracks);
 
     /*!
-     * Calculates the sort fields and then sorts @p tracks
-     * @param sortScript the parsed sort script
-     * @param tracks the tracks to sort
-     * @param order the order in which to sort the tracks
-     * @returns a new sorted TrackList
+     * Sorts previously calculated @p keys, so items kept alongside them can be resorted
+     * without evaluating the sort script again.
+     * @returns the indexes of @p keys in sorted order
+     * @see calcSortKeys
      */
-    TrackList calcSortTracks(const ParsedScript& sortScript, const TrackList& tracks,
-                             Qt::SortOrder order = Qt::AscendingOrder);
+    static std::vector<int> sortPermutation(const std::vector<QString>& keys, Qt::SortOrder order = Qt::AscendingOrder);
 
     /*!
-     * Calculates the sort fields and then sorts @p tracks in the given @p indexes.
-     * Tracks not under an index in @p indexes retain their position.
-     * @param sortScript the parsed sort script
-     * @param tracks the tracks to sort
-     * @param indexes the indexes to sort
-     * @param order the order in which to sort the tracks
-     * @returns a new sorted TrackList
+     * Returns a copy of @p items reordered by @p permutation, as returned by @fn sortPermutation.
      */
-    TrackList calcSortTracks(const ParsedScript& sortScript, const TrackList& tracks, const std::vector<int>& indexes,
-                             Qt::SortOrder order = Qt::AscendingOrder);
-
-    template <typename Container, typename SortScript, typename Extractor>
-    Container calcSortFields(const SortScript& sort, const Container& items, Extractor extractor)
-    {
-        Container calculatedTracks;
-        calculatedTracks.reserve(items.size());
-
-        const std::scoped_lock lock{m_parserGuard};
-
-        for(const auto& item : items) {
-            auto evalItem{item};
-            Track& track = extractor(evalItem);
-            track.setSort(m_parser.evaluate(sort, track));
-            calculatedTracks.push_back(evalItem);
-        }
-
-        return calculatedTracks;
-    }
-
-    template <typename Container, typename SortScript, typename SortExtractor, typename Extractor>
-    Container calcSortTracks(const SortScript& sort, const Container& items, SortExtractor sortExtractor,
-                             Extractor extractor, Qt::SortOrder order = Qt::AscendingOrder)
+    template <typename Container>
+    static Container applyPermutation(const Container& items, const std::vector<int>& permutation)
     {
-        Container sortedTracks = calcSortFields(sort, items, sortExtractor);
-        sortTracks(sortedTracks, extractor, order);
-        return sortedTracks;
-    }
-
-    template <typename Container, typename SortScript, typename SortExtractor, typename Extractor>
-    Container calcSortTracks(const SortScript& sortScript, const Container& items, const std::vector<int>& indexes,
-                             SortExtractor sortExtractor, Extractor extractor, Qt::SortOrder order = Qt::AscendingOrder)
-    {
-        Container sortedTracks{items};
-        Container tracksToSort;
-
-        auto validIndexes = indexes | std::views::filter([&items](int index) {
-                                return (index >= 0 && index < static_cast<int>(items.size()));
-                            });
-
-        for(const int index : validIndexes) {
-            tracksToSort.push_back(items.at(index));
-        }
+        Container sortedItems;
+        sortedItems.reserve(permutation.size());
 
-        Container sortedSubTracks = calcSortFields(sortScript, tracksToSort, sortExtractor);
-        sortTracks(sortedSubTracks, extractor, order);
-
-        for(auto i{0}; const int index : validIndexes) {
-            sortedTracks[index] = sortedSubTracks.at(i++);
+        for(const int index : permutation) {
+            sortedItems.push_back(items.at(index));
         }
 
-        return sortedTracks;
+        return sortedItems;
     }
 
 private:
-    ParsedScript parseScript(const QString& sort);
-
-    template <typename Container, typename Extractor>
-    static void sortTracks(Container& tracks, Extractor extractor, Qt::SortOrder order = Qt::AscendingOrder)
+    struct SortKey
     {
-        StringCollator collator;
+        int index;
+        QString key;
+    };
 
-        std::ranges::stable_sort(tracks, [order, &collator, extractor](const auto& lhs, const auto& rhs) {
-            const Track& leftTrack  = extractor(lhs);
-            const Track& rightTrack = extractor(rhs);
-
-            const auto cmp = collator.compare(leftTrack.sort(), rightTrack.sort());
-
-            if(cmp == 0) {
-                return false;
-            }
-
-            if(order == Qt::AscendingOrder) {
-                return cmp < 0;
-            }
-            return cmp > 0;
-        });
-    }
+    ParsedScript parseScript(const QString& sort);
+    static void sortKeys(std::vector<SortKey>& keys, Qt::SortOrder order);
 
     ScriptParser m_parser;
     std::mutex m_parserGuard;
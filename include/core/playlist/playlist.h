@@ -28,6 +28,10 @@
 #include <QVariant>
 
 namespace Fooyin {
+namespace Testing {
+class PlaylistDatabaseTest;
+} // namespace Testing
+
 class PlaylistPrivate;
 struct PlaylistTrack;
 class SettingsManager;
@@ -91,6 +95,30 @@ public:
     };
     Q_DECLARE_FLAGS(PlayModes, PlayMode)
 
+    /*!
+     * A change made to the tracks of a playlist.
+     * Indexes are relative to the tracks after all previous changes have been applied.
+     */
+    struct TrackChange
+    {
+        enum class Type : uint8_t
+        {
+            Insert,
+            Remove,
+            Move,
+        };
+
+        Type type{Type::Insert};
+        // Index of the first track affected
+        int index{-1};
+        int count{0};
+        // Index the first moved track ends up at (Move only)
+        int to{-1};
+        // Inserted tracks (Insert only)
+        TrackList tracks;
+    };
+    using TrackChanges = std::vector<TrackChange>;
+
     Playlist(PrivateKey, int dbId, QString name, int index, SettingsManager* settings);
 
     Playlist(const Playlist&)            = delete;
@@ -116,6 +144,11 @@ public:
     [[nodiscard]] bool modified() const;
     /** Returns @c true if this playlist's tracks have been changed. */
     [[nodiscard]] bool tracksModified() const;
+    /*!
+     * Returns the changes made to this playlist's tracks since the flags were last reset, or
+     * nothing if they weren't recorded and the tracks need to be saved in full.
+     */
+    [[nodiscard]] std::optional<TrackChanges> trackChanges() const;
     /** Returns @c true if this playlist does not persist (saved to db). */
     [[nodiscard]] bool isTemporary() const;
     /** Returns @c true if this an autoplaylist (generated from a query). */
@@ -154,6 +187,7 @@ public:
 private:
     friend class PlaylistHandler;
     friend class PlaylistHandlerPrivate;
+    friend class Testing::PlaylistDatabaseTest;
 
     static std::unique_ptr<Playlist> create(const QString& name, SettingsManager* settings);
     static std::unique_ptr<Playlist> create(int dbId, const QString& name, int index, SettingsManager* settings);
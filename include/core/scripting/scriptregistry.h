@@ -26,6 +26,8 @@
 
 #include <QObject>
 
+#include <optional>
+
 namespace Fooyin {
 class LibraryManager;
 class PlayerController;
@@ -52,6 +54,11 @@ public:
     [[nodiscard]] virtual ScriptResult value(const QString& var, const Track& track) const;
     [[nodiscard]] virtual ScriptResult value(const QString& var, const TrackList& tracks) const;
     [[nodiscard]] virtual ScriptResult value(const QString& var, const Playlist& playlist) const;
+    /*!
+     * Returns the value of @p var as a number, without formatting it as a string first.
+     * @returns nothing if @p var isn't a numeric field, or is unset for @p track.
+     */
+    [[nodiscard]] virtual std::optional<double> numericValue(const QString& var, const Track& track) const;
     [[nodiscard]] virtual ScriptResult function(const QString& func, const ScriptValueList& args,
                                                 const Track& track) const;
     [[nodiscard]] virtual ScriptResult function(const QString& func, const ScriptValueList& args,
@@ -24,6 +24,7 @@
 #include <QList>
 #include <QSharedDataPointer>
 
+#include <functional>
 #include <map>
 
 namespace Fooyin {
@@ -59,6 +60,11 @@ public:
 
     using ExtraTags       = QMap<QString, QStringList>;
     using ExtraProperties = QMap<QString, QString>;
+    /*!
+     * Fetches the deferred fields of the tracks with the given ids into @p tracks.
+     * May be called from any thread.
+     */
+    using DeferredLoader = std::function<bool(const TrackIds& ids, TrackList& tracks)>;
 
     Track();
     explicit Track(const QString& filepath);
@@ -71,7 +77,7 @@ public:
     bool operator!=(const Track& other) const;
     bool operator<(const Track& other) const;
 
-    QString generateHash();
+    uint64_t generateHash();
 
     [[nodiscard]] bool isValid() const;
     [[nodiscard]] bool isEnabled() const;
@@ -80,7 +86,6 @@ public:
     [[nodiscard]] bool metadataWasRead() const;
     [[nodiscard]] bool metadataWasModified() const;
     [[nodiscard]] bool exists() const;
-    [[nodiscard]] bool isNewTrack() const;
     [[nodiscard]] int libraryId() const;
 
     [[nodiscard]] bool isInArchive() const;
@@ -89,7 +94,11 @@ public:
     [[nodiscard]] QString relativeArchivePath() const;
 
     [[nodiscard]] int id() const;
-    [[nodiscard]] QString hash() const;
+    /*!
+     * Returns a hash of the track's artists, album, disc, track number, title and subsong.
+     * Used to match tracks which have moved and to associate them with their stats.
+     */
+    [[nodiscard]] uint64_t hash() const;
     [[nodiscard]] QString albumHash() const;
     [[nodiscard]] QString filepath() const;
     [[nodiscard]] QString uniqueFilepath() const;
@@ -114,6 +123,11 @@ public:
     [[nodiscard]] QString trackTotal() const;
     [[nodiscard]] QString discNumber() const;
     [[nodiscard]] QString discTotal() const;
+    /** Numeric forms of the above, parsed when set, or -1 if unset or not a number. */
+    [[nodiscard]] int trackNumberValue() const;
+    [[nodiscard]] int trackTotalValue() const;
+    [[nodiscard]] int discNumberValue() const;
+    [[nodiscard]] int discTotalValue() const;
     [[nodiscard]] QStringList genres() const;
     [[nodiscard]] QString genre() const;
     [[nodiscard]] QStringList composers() const;
@@ -179,13 +193,12 @@ public:
     [[nodiscard]] uint64_t firstPlayed() const;
     [[nodiscard]] uint64_t lastPlayed() const;
 
-    [[nodiscard]] QString sort() const;
     [[nodiscard]] bool hasMatch(const QString& term) const;
 
     void setLibraryId(int id);
     void setIsEnabled(bool enabled);
     void setId(int id);
-    void setHash(const QString& hash);
+    void setHash(uint64_t hash);
     void setFilePath(const QString& path);
     void setTitle(const QString& title);
     void setArtists(const QStringList& artists);
@@ -250,9 +263,27 @@ public:
     void setFirstPlayed(uint64_t time);
     void setLastPlayed(uint64_t time);
 
-    void setSort(const QString& sort);
     void clearWasModified();
 
+    /*!
+     * Returns @c true if the rarely used fields (comment, tool, tag types, encoding and extra properties)
+     * haven't been loaded yet.
+     * They're loaded on first access, or for many tracks at once using @fn loadDeferredFields.
+     */
+    [[nodiscard]] bool hasDeferredFields() const;
+    /*!
+     * Marks the rarely used fields as not loaded, so they're fetched by id when first needed.
+     * @note the track must already be stored in the database.
+     */
+    void setFieldsDeferred();
+
+    static void setDeferredLoader(DeferredLoader loader);
+    /*!
+     * Loads the deferred fields of @p tracks in a single batch.
+     * Should be called before reading those fields from many tracks.
+     */
+    static void loadDeferredFields(const TrackList& tracks);
+
     static QString findCommonField(const TrackList& tracks);
     static TrackIds trackIdsForTracks(const TrackList& tracks);
 
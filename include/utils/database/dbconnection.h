@@ -21,8 +21,12 @@
 
 #include "fyutils_export.h"
 
+#include "dbquery.h"
+
 #include <QSqlDatabase>
 
+#include <unordered_map>
+
 namespace Fooyin {
 class FYUTILS_EXPORT DbConnection
 {
@@ -33,16 +37,26 @@ public:
         QString connectOptions;
         QString hostName;
         QString filePath;
+        // Use SQLite's write-ahead log, so readers aren't blocked by writers
+        bool writeAheadLog{false};
+    };
+
+    enum class Mode : uint8_t
+    {
+        ReadWrite,
+        ReadOnly,
     };
 
     DbConnection(const DbParams& params, const QString& connectionName);
-    DbConnection(const DbConnection& original, const QString& connectionName);
+    DbConnection(const DbConnection& original, const QString& connectionName, Mode mode = Mode::ReadWrite);
     ~DbConnection();
 
     DbConnection(const DbConnection&)  = delete;
     DbConnection(const DbConnection&&) = delete;
 
     [[nodiscard]] QString name() const;
+    [[nodiscard]] Mode mode() const;
+    [[nodiscard]] std::shared_ptr<DbQueryStats> stats() const;
 
     bool open();
     void close();
@@ -51,7 +65,17 @@ public:
 
     [[nodiscard]] QSqlDatabase db() const;
 
+    /*!
+     * Returns a query for @p statement, prepared on first use and reset on each use after.
+     * Values bound previously are kept, so every placeholder should be bound again before executing.
+     * @note the query must not be used by more than one caller at a time.
+     */
+    DbQuery& cachedQuery(const QString& statement);
+
 private:
     QString m_name;
+    Mode m_mode;
+    std::shared_ptr<DbQueryStats> m_stats;
+    std::unordered_map<QString, DbQuery> m_statements;
 };
 } // namespace Fooyin
@@ -28,7 +28,8 @@ class FYUTILS_EXPORT DbConnectionHandler
 {
 public:
     DbConnectionHandler() = default;
-    explicit DbConnectionHandler(const DbConnectionPoolPtr& pDbConnectionPool);
+    explicit DbConnectionHandler(const DbConnectionPoolPtr& pDbConnectionPool,
+                                 DbConnection::Mode mode = DbConnection::Mode::ReadWrite);
     ~DbConnectionHandler();
 
     DbConnectionHandler(const DbConnectionHandler& other) = delete;
@@ -41,5 +42,6 @@ public:
 
 private:
     DbConnectionPoolPtr m_dbPool;
+    DbConnection::Mode m_mode{DbConnection::Mode::ReadWrite};
 };
 } // namespace Fooyin
@@ -25,15 +25,35 @@
 
 #include <QThreadStorage>
 
+#include <array>
+#include <mutex>
+
 namespace Fooyin {
 class DbConnectionPool;
 using DbConnectionPoolPtr = std::shared_ptr<DbConnectionPool>;
 
+/*!
+ * Provides each thread with its own connections, cloned from a prototype.
+ * A thread can hold a read-write connection and a read-only connection. With the write-ahead log
+ * enabled, reads made through a read-only connection never wait on a write transaction.
+ */
 class FYUTILS_EXPORT DbConnectionPool
 {
     struct PrivateKey;
 
 public:
+    struct ConnectionStats
+    {
+        QString name;
+        DbConnection::Mode mode{DbConnection::Mode::ReadWrite};
+        // Set for the combined totals of connections which have been closed
+        bool closed{false};
+        uint64_t statements{0};
+        uint64_t lockFailures{0};
+        std::chrono::nanoseconds execTime{0};
+        std::chrono::nanoseconds longestExec{0};
+    };
+
     DbConnectionPool(PrivateKey, const DbConnection::DbParams& params, const QString& connectionName);
 
     DbConnectionPool(const DbConnectionPool& other)  = delete;
@@ -41,18 +61,47 @@ public:
 
     static DbConnectionPoolPtr create(const DbConnection::DbParams& params, const QString& connectionName);
 
-    [[nodiscard]] bool hasThreadConnection() const;
+    [[nodiscard]] bool hasThreadConnection(DbConnection::Mode mode = DbConnection::Mode::ReadWrite) const;
+
+    /*!
+     * Returns the statement totals of each open connection, followed by the combined totals of
+     * connections which have since been closed.
+     * @see DbQueryStats
+     */
+    [[nodiscard]] std::vector<ConnectionStats> connectionStats() const;
 
 private:
     friend class DbConnectionProvider;
     friend class DbConnectionHandler;
 
-    [[nodiscard]] DbConnection* threadConnection() const;
-    bool createThreadConnection();
-    void destroyThreadConnection();
+    struct StatsEntry
+    {
+        QString name;
+        DbConnection::Mode mode;
+        std::shared_ptr<DbQueryStats> stats;
+    };
+
+    /*!
+     * Returns the current thread's connection for @p mode.
+     * A thread without a read-only connection uses its read-write connection for reads.
+     */
+    [[nodiscard]] DbConnection* threadConnection(DbConnection::Mode mode) const;
+    bool createThreadConnection(DbConnection::Mode mode);
+    void destroyThreadConnection(DbConnection::Mode mode);
+
+    [[nodiscard]] QThreadStorage<DbConnection*>& threadConnections(DbConnection::Mode mode);
+    [[nodiscard]] const QThreadStorage<DbConnection*>& threadConnections(DbConnection::Mode mode) const;
+
+    void addStats(const DbConnection& connection);
 
     QThreadStorage<DbConnection*> m_threadConnections;
+    QThreadStorage<DbConnection*> m_readConnections;
     std::atomic_int m_connectionCount;
     DbConnection m_prototype;
+    bool m_writeAheadLog;
+
+    mutable std::mutex m_statsMutex;
+    std::vector<StatsEntry> m_stats;
+    std::array<ConnectionStats, 2> m_closedStats;
 };
 } // namespace Fooyin
@@ -28,11 +28,23 @@ class FYUTILS_EXPORT DbConnectionProvider
 {
 public:
     DbConnectionProvider();
-    explicit DbConnectionProvider(DbConnectionPoolPtr pool);
+    /*!
+     * Provides the current thread's connection from @p pool.
+     * Modules only reading from the database can use a read-only connection, if the thread has one.
+     */
+    explicit DbConnectionProvider(DbConnectionPoolPtr pool, DbConnection::Mode mode = DbConnection::Mode::ReadWrite);
 
     [[nodiscard]] QSqlDatabase db() const;
+    /*!
+     * Returns a query for @p statement cached by the current thread's connection.
+     * @see DbConnection::cachedQuery
+     */
+    [[nodiscard]] DbQuery& cachedQuery(const QString& statement) const;
 
 private:
+    [[nodiscard]] DbConnection* connection() const;
+
     DbConnectionPoolPtr m_connectionPool;
+    DbConnection::Mode m_mode;
 };
 } // namespace Fooyin
@@ -37,6 +37,15 @@ public:
         return m_dbProvider.db();
     }
 
+    /*!
+     * Returns a prepared query for @p statement which is reused by later calls on the same thread.
+     * Intended for statements executed once per row, such as track inserts.
+     */
+    [[nodiscard]] DbQuery& cachedQuery(const QString& statement) const
+    {
+        return m_dbProvider.cachedQuery(statement);
+    }
+
 private:
     DbConnectionProvider m_dbProvider;
 };
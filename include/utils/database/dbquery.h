@@ -23,7 +23,31 @@
 
 #include <QSqlQuery>
 
+#include <atomic>
+#include <chrono>
+#include <memory>
+
 namespace Fooyin {
+/*!
+ * Totals for the statements executed on a connection.
+ * SQLite waits within a statement while another connection holds a conflicting lock, so time spent
+ * waiting on locks is counted as execution time, and as a lock failure once the busy timeout is reached.
+ */
+struct FYUTILS_EXPORT DbQueryStats
+{
+    std::atomic_uint64_t statements{0};
+    std::atomic_uint64_t lockFailures{0};
+    std::atomic_int64_t execTime{0};
+    std::atomic_int64_t longestExec{0};
+
+    void record(std::chrono::nanoseconds time, bool lockFailure);
+
+    /** Returns the stats of the connection named @p connectionName, if registered. */
+    static std::shared_ptr<DbQueryStats> find(const QString& connectionName);
+    static std::shared_ptr<DbQueryStats> registerConnection(const QString& connectionName);
+    static void unregisterConnection(const QString& connectionName);
+};
+
 class FYUTILS_EXPORT DbQuery
 {
 public:
@@ -46,6 +70,12 @@ public:
     [[nodiscard]] Status status() const;
     [[nodiscard]] QSqlError lastError() const;
 
+    /*!
+     * Finishes the active result, if any, so the statement can be executed again.
+     * Previously bound values are kept.
+     */
+    void reset();
+
     void bindValue(const QString& placeholder, const QVariant& value);
     [[nodiscard]] QString executedQuery() const;
     bool exec();
@@ -58,5 +88,6 @@ public:
 private:
     QSqlQuery m_query;
     Status m_status;
+    std::shared_ptr<DbQueryStats> m_stats;
 };
 } // namespace Fooyin
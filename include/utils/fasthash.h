@@ -0,0 +1,66 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "fyutils_export.h"
+
+#include <QByteArrayView>
+#include <QStringView>
+
+#include <array>
+#include <cstdint>
+
+namespace Fooyin {
+/*!
+ * Incremental 64-bit XXH64 hash.
+ * Fast and stable across runs, so suitable for persisted keys, but not for cryptographic use.
+ * Strings are hashed as UTF-16 without being converted.
+ */
+class FYUTILS_EXPORT FastHash
+{
+public:
+    explicit FastHash(uint64_t seed = 0);
+
+    void reset();
+
+    void addData(const void* data, size_t size);
+    void addData(QByteArrayView data);
+    void addData(QStringView str);
+
+    [[nodiscard]] uint64_t result() const;
+
+    template <typename... Args>
+    static uint64_t hash(const Args&... args)
+    {
+        FastHash hash;
+        (hash.addData(args), ...);
+        return hash.result();
+    }
+
+private:
+    void processStripe(const unsigned char* stripe);
+
+    uint64_t m_seed;
+    std::array<uint64_t, 4> m_acc;
+    std::array<unsigned char, 32> m_buffer;
+    size_t m_bufferSize;
+    uint64_t m_totalSize;
+};
+} // namespace Fooyin
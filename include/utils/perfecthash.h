@@ -0,0 +1,173 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <QChar>
+#include <QtGlobal>
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace Fooyin {
+/*!
+ * A fixed map of Latin-1 string keys, built at compile time around a perfect hash of the keys.
+ * Looking up a name hashes it once and compares it against at most one key, without allocating.
+ *
+ * Names can be any container of characters with a size(), such as QStringView, QString,
+ * std::string_view or TagLib::String. Case is ignored for ASCII letters unless Qt::CaseSensitive is passed.
+ */
+template <typename Value, size_t Size>
+class PerfectHashMap
+{
+    static_assert(Size > 0 && Size < 255, "Slots hold an 8-bit index");
+
+public:
+    template <typename Key>
+    consteval explicit PerfectHashMap(const std::array<std::pair<Key, Value>, Size>& entries,
+                                      Qt::CaseSensitivity cs = Qt::CaseInsensitive)
+        : m_cs{cs}
+    {
+        for(size_t i{0}; i < Size; ++i) {
+            m_entries[i] = {std::string_view{entries[i].first}, entries[i].second};
+            if(m_entries[i].first.empty()) {
+                throw "Keys can't be empty";
+            }
+            for(size_t j{0}; j < i; ++j) {
+                if(equal(m_entries[j].first, m_entries[i].first)) {
+                    throw "Duplicate key";
+                }
+            }
+        }
+
+        while(!build()) {
+            ++m_seed;
+        }
+    }
+
+    template <typename Name>
+    [[nodiscard]] constexpr std::optional<Value> find(const Name& name) const
+    {
+        const uint8_t slot = m_slots[hash(name, m_seed) & (TableSize - 1)];
+        if(slot == 0) {
+            return {};
+        }
+
+        const auto& [key, value] = m_entries[slot - 1];
+        if(!equal(key, name)) {
+            return {};
+        }
+        return value;
+    }
+
+    template <typename Name>
+    [[nodiscard]] constexpr bool contains(const Name& name) const
+    {
+        return find(name).has_value();
+    }
+
+    [[nodiscard]] static constexpr size_t size()
+    {
+        return Size;
+    }
+
+private:
+    // Sparse enough that a seed without collisions is found after a few attempts
+    static constexpr size_t TableSize = std::bit_ceil(Size * 8);
+
+    template <typename Char>
+    static constexpr char32_t code(Char ch)
+    {
+        if constexpr(std::is_same_v<Char, QChar>) {
+            return ch.unicode();
+        }
+        else {
+            return static_cast<char32_t>(static_cast<std::make_unsigned_t<Char>>(ch));
+        }
+    }
+
+    [[nodiscard]] constexpr char32_t fold(char32_t ch) const
+    {
+        if(m_cs == Qt::CaseInsensitive && ch >= U'a' && ch <= U'z') {
+            return ch - (U'a' - U'A');
+        }
+        return ch;
+    }
+
+    // FNV-1a with a final mix, as only the low bits are used
+    template <typename Name>
+    [[nodiscard]] constexpr uint32_t hash(const Name& name, uint32_t seed) const
+    {
+        uint32_t value = 2166136261U ^ seed;
+        for(const auto ch : name) {
+            value ^= fold(code(ch));
+            value *= 16777619U;
+        }
+        value ^= value >> 16;
+        value *= 0x7feb352dU;
+        value ^= value >> 15;
+        return value;
+    }
+
+    template <typename Name>
+    [[nodiscard]] constexpr bool equal(std::string_view key, const Name& name) const
+    {
+        if(static_cast<size_t>(name.size()) != key.size()) {
+            return false;
+        }
+
+        auto keyIt = key.cbegin();
+        for(const auto ch : name) {
+            if(fold(code(ch)) != fold(code(*keyIt++))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    constexpr bool build()
+    {
+        m_slots = {};
+        for(size_t i{0}; i < Size; ++i) {
+            uint8_t& slot = m_slots[hash(m_entries[i].first, m_seed) & (TableSize - 1)];
+            if(slot != 0) {
+                return false;
+            }
+            slot = static_cast<uint8_t>(i + 1);
+        }
+        return true;
+    }
+
+    Qt::CaseSensitivity m_cs;
+    uint32_t m_seed{0};
+    std::array<std::pair<std::string_view, Value>, Size> m_entries{};
+    // Index + 1 into m_entries, or 0 if empty
+    std::array<uint8_t, TableSize> m_slots{};
+};
+
+template <typename Key, typename Value, size_t Size>
+PerfectHashMap(const std::array<std::pair<Key, Value>, Size>&) -> PerfectHashMap<Value, Size>;
+template <typename Key, typename Value, size_t Size>
+PerfectHashMap(const std::array<std::pair<Key, Value>, Size>&, Qt::CaseSensitivity) -> PerfectHashMap<Value, Size>;
+} // namespace Fooyin
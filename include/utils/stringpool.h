@@ -0,0 +1,80 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "fyutils_export.h"
+
+#include <QString>
+#include <QStringList>
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <unordered_set>
+
+namespace Fooyin {
+/*!
+ * Process-wide, thread-safe pool of interned strings.
+ * Interning returns the pooled copy of an equal string, so values repeated across many
+ * objects (artists, albums, codecs etc.) share a single buffer rather than one each.
+ * Strings are kept until @fn prune is called and nothing else references them.
+ */
+class FYUTILS_EXPORT StringPool
+{
+public:
+    struct Stats
+    {
+        size_t strings{0};
+        // Size of the pooled strings, counted once each
+        size_t bytes{0};
+        size_t lookups{0};
+        size_t hits{0};
+        // Bytes that would've been allocated for duplicates which now share a pooled string
+        size_t bytesSaved{0};
+    };
+
+    static StringPool& instance();
+
+    /** Returns the pooled copy of @p str, adding it to the pool if needed. */
+    QString intern(const QString& str);
+    QStringList intern(const QStringList& strs);
+
+    /** Removes strings which are only referenced by the pool. */
+    size_t prune();
+
+    [[nodiscard]] Stats stats() const;
+    [[nodiscard]] QString report() const;
+
+private:
+    static constexpr size_t ShardCount = 16;
+
+    struct Shard
+    {
+        mutable std::mutex mutex;
+        std::unordered_set<QString> strings;
+        size_t bytes{0};
+    };
+
+    std::array<Shard, ShardCount> m_shards;
+    std::atomic<size_t> m_lookups{0};
+    std::atomic<size_t> m_hits{0};
+    std::atomic<size_t> m_bytesSaved{0};
+};
+} // namespace Fooyin
@@ -68,6 +68,7 @@ bool CommandLine::parse()
         {L"stop", no_argument, nullptr, 's'},
         {L"next", no_argument, nullptr, 'f'},
         {L"previous", no_argument, nullptr, 'r'},
+        {L"scan-benchmark", required_argument, nullptr, 'b'},
         {nullptr, 0, nullptr, 0
 #else
         {"help", no_argument, nullptr, 'h'},
@@ -79,6 +80,7 @@ bool CommandLine::parse()
         {"stop", no_argument, nullptr, 's'},
         {"next", no_argument, nullptr, 'f'},
         {"previous", no_argument, nullptr, 'r'},
+        {"scan-benchmark", required_argument, nullptr, 'b'},
         {nullptr, 0, nullptr, 0
 #endif
         }
@@ -87,25 +89,26 @@ bool CommandLine::parse()
     static const auto help = u"%1: fooyin [%2] [%3]\n"
                              "\n"
                              "%4:\n"
-                             "  -h, --help      %5\n"
-                             "  -v, --version   %6\n"
+                             "  -h, --help                  %5\n"
+                             "  -v, --version               %6\n"
+                             "  -b, --scan-benchmark <dir>  %7\n"
                              "\n"
-                             "%7:\n"
-                             "  -t, --play-pause  %8\n"
-                             "  -p, --play        %9\n"
-                             "  -u, --pause       %10\n"
-                             "  -s, --stop        %11\n"
-                             "  -f, --next        %12\n"
-                             "  -r, --previous    %13\n"
+                             "%8:\n"
+                             "  -t, --play-pause  %9\n"
+                             "  -p, --play        %10\n"
+                             "  -u, --pause       %11\n"
+                             "  -s, --stop        %12\n"
+                             "  -f, --next        %13\n"
+                             "  -r, --previous    %14\n"
                              "\n"
-                             "%14:\n"
-                             "  urls            %15\n"_s;
+                             "%15:\n"
+                             "  urls            %16\n"_s;
 
     for(;;) {
 #ifdef Q_OS_WIN
-        const int c = getopt_long(m_argc, m_argv, L"hvxtpusfr", cmdOptions, nullptr);
+        const int c = getopt_long(m_argc, m_argv, L"hvxtpusfrb:", cmdOptions, nullptr);
 #else
-        const int c = getopt_long(m_argc, m_argv, "hvxtpusfr", cmdOptions, nullptr);
+        const int c = getopt_long(m_argc, m_argv, "hvxtpusfrb:", cmdOptions, nullptr);
 #endif
         if(c == -1) {
             break;
@@ -116,6 +119,7 @@ bool CommandLine::parse()
                 const auto helpText = QString{help}.arg(
                     QObject::tr("Usage"), QObject::tr("options"), QObject::tr("urls"), QObject::tr("Options"),
                     QObject::tr("Display help on command line options"), QObject::tr("Display version information"),
+                    QObject::tr("Scan a directory into a temporary library and print the time taken by each stage"),
                     QObject::tr("Player options"), QObject::tr("Toggle playback"), QObject::tr("Start playback"),
                     QObject::tr("Pause playback"), QObject::tr("Stop playback"), QObject::tr("Skip to next track"),
                     QObject::tr("Skip to previous track"), QObject::tr("Arguments"), QObject::tr("Files to open"));
@@ -148,6 +152,9 @@ bool CommandLine::parse()
             case('r'):
                 m_playerAction = PlayerAction::Previous;
                 break;
+            case('b'):
+                m_scanBenchmarkPath = decodeName(optarg);
+                break;
             default:
                 return false;
         }
@@ -184,6 +191,11 @@ CommandLine::PlayerAction CommandLine::playerAction() const
     return m_playerAction;
 }
 
+QString CommandLine::scanBenchmarkPath() const
+{
+    return m_scanBenchmarkPath;
+}
+
 QByteArray CommandLine::saveOptions() const
 {
     QByteArray out;
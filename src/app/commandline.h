@@ -48,6 +48,7 @@ public:
     [[nodiscard]] QList<QUrl> files() const;
     [[nodiscard]] bool skipSingleApp() const;
     [[nodiscard]] PlayerAction playerAction() const;
+    [[nodiscard]] QString scanBenchmarkPath() const;
 
     [[nodiscard]] QByteArray saveOptions() const;
     void loadOptions(const QByteArray& options);
@@ -62,4 +63,5 @@ private:
     QList<QUrl> m_files;
     bool m_skipSingle;
     PlayerAction m_playerAction;
+    QString m_scanBenchmarkPath;
 };
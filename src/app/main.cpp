@@ -22,6 +22,7 @@
 #include "commandline.h"
 
 #include <core/application.h>
+#include <core/library/scanbenchmark.h>
 #include <core/player/playercontroller.h>
 #include <core/playlist/playlisthandler.h>
 #include <gui/guiapplication.h>
@@ -31,6 +32,8 @@
 #include <QApplication>
 #include <QLoggingCategory>
 
+#include <iostream>
+
 using namespace Qt::StringLiterals;
 
 namespace {
@@ -80,6 +83,19 @@ void parseCmdOptions(Fooyin::Application& app, Fooyin::GuiApplication& guiApp, C
         guiApp.openFiles(files);
     }
 }
+
+int runScanBenchmark(const QString& path)
+{
+    Fooyin::ScanBenchmark benchmark;
+
+    const auto stats = benchmark.run(path);
+    if(!stats) {
+        return 1;
+    }
+
+    std::cout << stats->report().toLocal8Bit().constData() << '\n';
+    return 0;
+}
 } // namespace
 
 int main(int argc, char** argv)
@@ -117,11 +133,16 @@ int main(int argc, char** argv)
 
     {
         const QCoreApplication app{argc, argv};
-        KDSingleApplication instance{QCoreApplication::applicationName(),
-                                     KDSingleApplication::Option::IncludeUsernameInSocketName};
         if(!commandLine.parse()) {
             return 1;
         }
+        // Headless, so doesn't interact with a running instance
+        if(const QString benchmarkPath = commandLine.scanBenchmarkPath(); !benchmarkPath.isEmpty()) {
+            return runScanBenchmark(benchmarkPath);
+        }
+
+        KDSingleApplication instance{QCoreApplication::applicationName(),
+                                     KDSingleApplication::Option::IncludeUsernameInSocketName};
         if(!checkInstance(instance)) {
             return 0;
         }
@@ -45,6 +45,16 @@ QString playlistsPath()
     return QDir::cleanPath(Utils::sharePath().append("/playlists"_L1));
 }
 
+QString librarySnapshotPath()
+{
+    return QDir::cleanPath(Utils::cachePath().append("/library.snapshot"_L1));
+}
+
+QString trackStatsJournalPath()
+{
+    return QDir::cleanPath(Utils::sharePath().append("/trackstats.journal"_L1));
+}
+
 QStringList pluginPaths()
 {
     QStringList paths;
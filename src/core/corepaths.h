@@ -27,6 +27,8 @@ namespace Fooyin::Core {
 FYCORE_EXPORT QString settingsPath();
 FYCORE_EXPORT QString statePath();
 FYCORE_EXPORT QString playlistsPath();
+FYCORE_EXPORT QString librarySnapshotPath();
+FYCORE_EXPORT QString trackStatsJournalPath();
 FYCORE_EXPORT QStringList pluginPaths();
 FYCORE_EXPORT QString userPluginsPath();
 FYCORE_EXPORT QString translationsPath();
@@ -20,6 +20,8 @@
 #include "database.h"
 
 #include "dbschema.h"
+#include "generaldatabase.h"
+#include "trackdatabase.h"
 
 #include <core/coresettings.h>
 #include <utils/fileutils.h>
@@ -27,18 +29,22 @@
 #include <utils/settings/settingsmanager.h>
 
 #include <QFileInfo>
+#include <QLoggingCategory>
+
+Q_LOGGING_CATEGORY(DATABASE, "fy.db")
 
 using namespace Qt::StringLiterals;
 
-constexpr auto CurrentSchemaVersion = 14;
+constexpr auto CurrentSchemaVersion = 18;
 
 namespace {
-Fooyin::DbConnection::DbParams dbConnectionParams()
+Fooyin::DbConnection::DbParams dbConnectionParams(const QString& filepath)
 {
     Fooyin::DbConnection::DbParams params;
     params.type           = u"QSQLITE"_s;
     params.connectOptions = u"QSQLITE_OPEN_URI"_s;
-    params.filePath       = Fooyin::Utils::sharePath() + u"/fooyin.db"_s;
+    params.filePath       = filepath;
+    params.writeAheadLog  = true;
 
     return params;
 }
@@ -46,8 +52,12 @@ Fooyin::DbConnection::DbParams dbConnectionParams()
 
 namespace Fooyin {
 Database::Database(QObject* parent)
+    : Database{Utils::sharePath() + u"/fooyin.db"_s, u"fooyin"_s, parent}
+{ }
+
+Database::Database(const QString& filepath, const QString& connectionName, QObject* parent)
     : QObject{parent}
-    , m_dbPool(DbConnectionPool::create(dbConnectionParams(), u"fooyin"_s))
+    , m_dbPool(DbConnectionPool::create(dbConnectionParams(filepath), connectionName))
     , m_connectionHandler{m_dbPool}
     , m_status{Status::Ok}
     , m_previousRevision{0}
@@ -57,7 +67,32 @@ Database::Database(QObject* parent)
         return;
     }
 
-    initSchema();
+    if(initSchema()) {
+        m_readConnectionHandler = DbConnectionHandler{m_dbPool, DbConnection::Mode::ReadOnly};
+    }
+}
+
+Database::~Database()
+{
+    if(!DATABASE().isDebugEnabled()) {
+        return;
+    }
+
+    using Ms = std::chrono::duration<double, std::milli>;
+
+    for(const auto& stats : m_dbPool->connectionStats()) {
+        QString name = stats.name;
+        if(stats.mode == DbConnection::Mode::ReadOnly) {
+            name.append(u" (read-only)"_s);
+        }
+        if(stats.closed) {
+            name.append(u" (closed)"_s);
+        }
+
+        qCDebug(DATABASE).nospace().noquote()
+            << name << ": " << stats.statements << " statements, " << stats.lockFailures << " lock failures, "
+            << Ms{stats.execTime}.count() << " ms total, " << Ms{stats.longestExec}.count() << " ms longest";
+    }
 }
 
 DbConnectionPoolPtr Database::connectionPool() const
@@ -88,11 +123,22 @@ bool Database::initSchema()
     DbSchema schema{dbProvider};
     m_previousRevision = schema.currentVersion();
 
+    // Must be set before any tables are created
+    GeneralDatabase::enableIncrementalVacuum(dbProvider.db());
+
     const auto upgradeResult = schema.upgradeDatabase(CurrentSchemaVersion, u"://dbschema.xml"_s);
 
     switch(upgradeResult) {
         case(DbSchema::UpgradeResult::Success):
         case(DbSchema::UpgradeResult::IsCurrent):
+            // Retried on each start until it succeeds
+            if(!TrackDatabase::migrateTrackHashes(dbProvider.db())
+               || !TrackDatabase::finishBulkImport(dbProvider.db())) {
+                changeStatus(Status::DbError);
+                return false;
+            }
+            changeStatus(Status::Ok);
+            return true;
         case(DbSchema::UpgradeResult::BackwardsCompatible):
             changeStatus(Status::Ok);
             return true;
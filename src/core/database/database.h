@@ -42,6 +42,8 @@ public:
     };
 
     explicit Database(QObject* parent = nullptr);
+    Database(const QString& filepath, const QString& connectionName, QObject* parent = nullptr);
+    ~Database() override;
 
     [[nodiscard]] DbConnectionPoolPtr connectionPool() const;
 
@@ -58,6 +60,7 @@ private:
 
     DbConnectionPoolPtr m_dbPool;
     DbConnectionHandler m_connectionHandler;
+    DbConnectionHandler m_readConnectionHandler;
     Status m_status;
     int m_previousRevision;
 };
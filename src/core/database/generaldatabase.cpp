@@ -23,13 +23,92 @@
 
 using namespace Qt::StringLiterals;
 
+namespace {
+int pragmaValue(const QSqlDatabase& db, const QString& pragma)
+{
+    Fooyin::DbQuery query{db, u"PRAGMA %1;"_s.arg(pragma)};
+
+    if(!query.exec() || !query.next()) {
+        return -1;
+    }
+
+    return query.value(0).toInt();
+}
+} // namespace
+
 namespace Fooyin {
 void GeneralDatabase::optimiseDatabase()
 {
+    // Takes effect as part of the VACUUM below
+    enableIncrementalVacuum(db());
+
     DbQuery vacuumQuery{db(), u"VACUUM;"_s};
     if(vacuumQuery.exec()) {
         DbQuery analyzeQuery{db(), u"ANALYZE;"_s};
         analyzeQuery.exec();
     }
 }
+
+int GeneralDatabase::pageCount() const
+{
+    return pragmaValue(db(), u"page_count"_s);
+}
+
+int GeneralDatabase::freePageCount() const
+{
+    return pragmaValue(db(), u"freelist_count"_s);
+}
+
+bool GeneralDatabase::incrementalVacuumEnabled() const
+{
+    // 0 = NONE, 1 = FULL, 2 = INCREMENTAL
+    return pragmaValue(db(), u"auto_vacuum"_s) == 2;
+}
+
+QStringList GeneralDatabase::tables() const
+{
+    DbQuery query{db(), u"SELECT name FROM sqlite_master WHERE type = 'table' AND name NOT LIKE 'sqlite_%';"_s};
+
+    if(!query.exec()) {
+        return {};
+    }
+
+    QStringList tables;
+    while(query.next()) {
+        tables.append(query.value(0).toString());
+    }
+
+    return tables;
+}
+
+bool GeneralDatabase::incrementalVacuum(int pages)
+{
+    DbQuery query{db(), u"PRAGMA incremental_vacuum(%1);"_s.arg(pages)};
+
+    if(!query.exec()) {
+        return false;
+    }
+
+    // Pages are only freed as the result rows are stepped through
+    while(query.next()) { }
+
+    return true;
+}
+
+bool GeneralDatabase::analyseTable(const QString& table, int limit)
+{
+    DbQuery limitQuery{db(), u"PRAGMA analysis_limit = %1;"_s.arg(limit)};
+    if(!limitQuery.exec()) {
+        return false;
+    }
+
+    DbQuery analyseQuery{db(), u"ANALYZE \"%1\";"_s.arg(table)};
+    return analyseQuery.exec();
+}
+
+void GeneralDatabase::enableIncrementalVacuum(const QSqlDatabase& db)
+{
+    DbQuery query{db, u"PRAGMA auto_vacuum = INCREMENTAL;"_s};
+    query.exec();
+}
 } // namespace Fooyin
@@ -23,10 +23,28 @@
 
 #include <utils/database/dbmodule.h>
 
+#include <QStringList>
+
 namespace Fooyin {
 class FYCORE_EXPORT GeneralDatabase : public DbModule
 {
 public:
     void optimiseDatabase();
+
+    [[nodiscard]] int pageCount() const;
+    [[nodiscard]] int freePageCount() const;
+    [[nodiscard]] bool incrementalVacuumEnabled() const;
+    [[nodiscard]] QStringList tables() const;
+
+    /** Returns up to @p pages free pages to the filesystem. */
+    bool incrementalVacuum(int pages);
+    /** Updates the query planner statistics of @p table, reading roughly @p limit rows of each index. */
+    bool analyseTable(const QString& table, int limit);
+
+    /*!
+     * Switches @p db to incremental auto vacuum.
+     * This only applies immediately to new databases; existing ones switch on their next full VACUUM.
+     */
+    static void enableIncrementalVacuum(const QSqlDatabase& db);
 };
 } // namespace Fooyin
@@ -20,6 +20,7 @@
 #include "librarydatabase.h"
 
 #include <utils/database/dbquery.h>
+#include <utils/database/dbtransaction.h>
 
 using namespace Qt::StringLiterals;
 
@@ -95,4 +96,74 @@ bool LibraryDatabase::renameLibrary(int id, const QString& name)
 
     return query.exec();
 }
+
+bool LibraryDatabase::getDirectoryManifest(int libraryId, DirectoryManifest& manifest)
+{
+    const QString statement = u"SELECT Path, ModifiedTime, EntryCount, MaxModifiedTime FROM LibraryDirectories "
+                              "WHERE LibraryID = :id;"_s;
+
+    DbQuery query{db(), statement};
+
+    query.bindValue(u":id"_s, libraryId);
+
+    if(!query.exec()) {
+        return false;
+    }
+
+    while(query.next()) {
+        DirectoryFingerprint fingerprint;
+        fingerprint.modifiedTime    = query.value(1).toULongLong();
+        fingerprint.entryCount      = query.value(2).toInt();
+        fingerprint.maxModifiedTime = query.value(3).toULongLong();
+
+        manifest.emplace(query.value(0).toString(), fingerprint);
+    }
+
+    return true;
+}
+
+bool LibraryDatabase::storeDirectoryManifest(int libraryId, const DirectoryManifest& manifest, bool replace)
+{
+    if(libraryId < 0) {
+        return false;
+    }
+
+    DbTransaction transaction{db()};
+
+    if(!transaction) {
+        return false;
+    }
+
+    if(replace) {
+        const QString statement = u"DELETE FROM LibraryDirectories WHERE LibraryID = :id;"_s;
+
+        DbQuery query{db(), statement};
+
+        query.bindValue(u":id"_s, libraryId);
+
+        if(!query.exec()) {
+            return false;
+        }
+    }
+
+    const QString statement
+        = u"INSERT OR REPLACE INTO LibraryDirectories (LibraryID, Path, ModifiedTime, EntryCount, MaxModifiedTime) "
+          "VALUES (:id, :path, :modifiedTime, :entryCount, :maxModifiedTime);"_s;
+
+    for(const auto& [path, fingerprint] : manifest) {
+        DbQuery query{db(), statement};
+
+        query.bindValue(u":id"_s, libraryId);
+        query.bindValue(u":path"_s, path);
+        query.bindValue(u":modifiedTime"_s, QVariant::fromValue(fingerprint.modifiedTime));
+        query.bindValue(u":entryCount"_s, fingerprint.entryCount);
+        query.bindValue(u":maxModifiedTime"_s, QVariant::fromValue(fingerprint.maxModifiedTime));
+
+        if(!query.exec()) {
+            return false;
+        }
+    }
+
+    return transaction.commit();
+}
 } // namespace Fooyin
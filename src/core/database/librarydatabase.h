@@ -22,7 +22,29 @@
 #include <core/library/libraryinfo.h>
 #include <utils/database/dbmodule.h>
 
+#include <unordered_map>
+
 namespace Fooyin {
+/*!
+ * Fingerprint of a single library directory, used to skip unchanged
+ * directories when refreshing a library.
+ * The directory's own modified time only changes when entries are added, removed or renamed,
+ * so the newest modified time of its files is compared too, to catch files rewritten in place.
+ */
+struct DirectoryFingerprint
+{
+    uint64_t modifiedTime{0};
+    int entryCount{0};
+    uint64_t maxModifiedTime{0};
+
+    [[nodiscard]] bool isSameAs(const DirectoryFingerprint& other) const
+    {
+        return modifiedTime > 0 && modifiedTime == other.modifiedTime && entryCount == other.entryCount
+            && maxModifiedTime == other.maxModifiedTime;
+    }
+};
+using DirectoryManifest = std::unordered_map<QString, DirectoryFingerprint>;
+
 class LibraryDatabase : public DbModule
 {
 public:
@@ -32,5 +54,8 @@ public:
 
     bool removeLibrary(int id);
     bool renameLibrary(int id, const QString& name);
+
+    bool getDirectoryManifest(int libraryId, DirectoryManifest& manifest);
+    bool storeDirectoryManifest(int libraryId, const DirectoryManifest& manifest, bool replace);
 };
 } // namespace Fooyin
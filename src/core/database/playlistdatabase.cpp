@@ -53,9 +53,10 @@ std::vector<PlaylistInfo> PlaylistDatabase::getAllPlaylists()
     return playlists;
 }
 
-TrackList PlaylistDatabase::getPlaylistTracks(const Playlist& playlist, const std::unordered_map<int, Track>& tracks)
+TrackList PlaylistDatabase::getPlaylistTracks(const Playlist& playlist, const std::unordered_map<int, Track>& tracks,
+                                              bool* inSync)
 {
-    return populatePlaylistTracks(playlist, tracks);
+    return populatePlaylistTracks(playlist, tracks, inSync);
 }
 
 int PlaylistDatabase::insertPlaylist(const QString& name, int index, bool isAutoPlaylist, const QString& autoQuery)
@@ -88,7 +89,7 @@ bool PlaylistDatabase::savePlaylist(Playlist& playlist)
         const auto statement = u"UPDATE Playlists SET Name = :name, PlaylistIndex = :index, IsAutoPlaylist = "
                                ":isAutoPlaylist, Query = :query WHERE PlaylistID = :id;"_s;
 
-        DbQuery query{db(), statement};
+        DbQuery& query = cachedQuery(statement);
 
         query.bindValue(u":name"_s, playlist.name());
         query.bindValue(u":index"_s, playlist.index());
@@ -100,7 +101,11 @@ bool PlaylistDatabase::savePlaylist(Playlist& playlist)
     }
 
     if(!playlist.isAutoPlaylist() && playlist.tracksModified()) {
-        updated = insertPlaylistTracks(playlist.dbId(), playlist.tracks());
+        const auto changes = playlist.trackChanges();
+        updated            = changes && applyTrackChanges(playlist.dbId(), changes.value());
+        if(!updated) {
+            updated = insertPlaylistTracks(playlist.dbId(), playlist.tracks());
+        }
     }
 
     if(updated) {
@@ -152,7 +157,7 @@ bool PlaylistDatabase::insertPlaylistTrack(int playlistId, const Track& track, i
     const QString statement
         = u"INSERT INTO PlaylistTracks (PlaylistID, TrackID, TrackIndex) VALUES (:playlistId, :trackId, :index);"_s;
 
-    DbQuery query{db(), statement};
+    DbQuery& query = cachedQuery(statement);
     query.bindValue(u":playlistId"_s, playlistId);
     query.bindValue(u":trackId"_s, track.id());
     query.bindValue(u":index"_s, index);
@@ -169,28 +174,136 @@ bool PlaylistDatabase::insertPlaylistTracks(int playlistId, const TrackList& tra
     // Remove current playlist tracks
     const auto statement = u"DELETE FROM PlaylistTracks WHERE PlaylistID = :id;"_s;
 
-    DbQuery query{db(), statement};
+    DbQuery& query = cachedQuery(statement);
     query.bindValue(u":id"_s, playlistId);
 
     if(!query.exec()) {
         return false;
     }
 
+    // Indexes are kept in line with the playlist, leaving gaps for any tracks skipped
     for(int i{0}; const auto& track : tracks) {
         if(track.isValid() && track.isInDatabase()) {
-            if(!insertPlaylistTrack(playlistId, track, i++)) {
+            if(!insertPlaylistTrack(playlistId, track, i)) {
                 return false;
             }
         }
+        ++i;
+    }
+
+    return true;
+}
+
+bool PlaylistDatabase::applyTrackChanges(int playlistId, const Playlist::TrackChanges& changes)
+{
+    if(playlistId < 0) {
+        return false;
+    }
+
+    using Type = Playlist::TrackChange::Type;
+
+    for(const auto& change : changes) {
+        bool applied{false};
+
+        switch(change.type) {
+            case(Type::Insert):
+                applied = insertTrackRange(playlistId, change.index, change.tracks);
+                break;
+            case(Type::Remove):
+                applied = removeTrackRange(playlistId, change.index, change.count);
+                break;
+            case(Type::Move):
+                applied = moveTrackRange(playlistId, change.index, change.count, change.to);
+                break;
+        }
+
+        if(!applied) {
+            return false;
+        }
     }
 
     return true;
 }
 
+bool PlaylistDatabase::shiftTrackIndexes(int playlistId, int from, int offset)
+{
+    const auto statement = u"UPDATE PlaylistTracks SET TrackIndex = TrackIndex + :offset "
+                           "WHERE PlaylistID = :id AND TrackIndex >= :from;"_s;
+
+    DbQuery& query = cachedQuery(statement);
+    query.bindValue(u":offset"_s, offset);
+    query.bindValue(u":id"_s, playlistId);
+    query.bindValue(u":from"_s, from);
+
+    return query.exec();
+}
+
+bool PlaylistDatabase::insertTrackRange(int playlistId, int index, const TrackList& tracks)
+{
+    const auto count = static_cast<int>(tracks.size());
+
+    if(!shiftTrackIndexes(playlistId, index, count)) {
+        return false;
+    }
+
+    for(int i{index}; const auto& track : tracks) {
+        if(track.isValid() && track.isInDatabase()) {
+            if(!insertPlaylistTrack(playlistId, track, i)) {
+                return false;
+            }
+        }
+        ++i;
+    }
+
+    return true;
+}
+
+bool PlaylistDatabase::removeTrackRange(int playlistId, int index, int count)
+{
+    const auto statement
+        = u"DELETE FROM PlaylistTracks WHERE PlaylistID = :id AND TrackIndex >= :first AND TrackIndex < :last;"_s;
+
+    DbQuery& query = cachedQuery(statement);
+    query.bindValue(u":id"_s, playlistId);
+    query.bindValue(u":first"_s, index);
+    query.bindValue(u":last"_s, index + count);
+
+    if(!query.exec()) {
+        return false;
+    }
+
+    return shiftTrackIndexes(playlistId, index + count, -count);
+}
+
+bool PlaylistDatabase::moveTrackRange(int playlistId, int index, int count, int to)
+{
+    if(index == to) {
+        return true;
+    }
+
+    // The moved tracks swap places with the tracks between them and their destination
+    const auto statement = u"UPDATE PlaylistTracks SET TrackIndex = CASE "
+                           "WHEN TrackIndex >= :first AND TrackIndex < :last THEN TrackIndex + :offset "
+                           "ELSE TrackIndex + :shift END "
+                           "WHERE PlaylistID = :id AND TrackIndex >= :low AND TrackIndex < :high;"_s;
+
+    DbQuery& query = cachedQuery(statement);
+    query.bindValue(u":first"_s, index);
+    query.bindValue(u":last"_s, index + count);
+    query.bindValue(u":offset"_s, to - index);
+    query.bindValue(u":shift"_s, to > index ? -count : count);
+    query.bindValue(u":id"_s, playlistId);
+    query.bindValue(u":low"_s, std::min(index, to));
+    query.bindValue(u":high"_s, std::max(index, to) + count);
+
+    return query.exec();
+}
+
 TrackList PlaylistDatabase::populatePlaylistTracks(const Playlist& playlist,
-                                                   const std::unordered_map<int, Track>& tracks)
+                                                   const std::unordered_map<int, Track>& tracks, bool* inSync)
 {
-    const auto statement = u"SELECT TrackID FROM PlaylistTracks WHERE PlaylistID=:playlistId ORDER BY TrackIndex;"_s;
+    const auto statement
+        = u"SELECT TrackID, TrackIndex FROM PlaylistTracks WHERE PlaylistID=:playlistId ORDER BY TrackIndex;"_s;
 
     DbQuery query{db(), statement};
     query.bindValue(u":playlistId"_s, playlist.dbId());
@@ -200,12 +313,21 @@ TrackList PlaylistDatabase::populatePlaylistTracks(const Playlist& playlist,
     }
 
     TrackList playlistTracks;
+    bool indexesMatch{true};
 
     while(query.next()) {
         const int trackId = query.value(0).toInt();
         if(tracks.contains(trackId)) {
+            indexesMatch = indexesMatch && query.value(1).toInt() == static_cast<int>(playlistTracks.size());
             playlistTracks.push_back(tracks.at(trackId));
         }
+        else {
+            indexesMatch = false;
+        }
+    }
+
+    if(inSync) {
+        *inSync = indexesMatch;
     }
 
     return playlistTracks;
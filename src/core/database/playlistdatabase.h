@@ -37,7 +37,13 @@ class PlaylistDatabase : public DbModule
 {
 public:
     std::vector<PlaylistInfo> getAllPlaylists();
-    TrackList getPlaylistTracks(const Playlist& playlist, const std::unordered_map<int, Track>& tracks);
+    /*!
+     * Returns the stored tracks of @p playlist found in @p tracks.
+     * If @p inSync is set, it's set to @c true if the stored track indexes match the returned tracks,
+     * so later changes can be saved without rewriting them all.
+     */
+    TrackList getPlaylistTracks(const Playlist& playlist, const std::unordered_map<int, Track>& tracks,
+                                bool* inSync = nullptr);
 
     int insertPlaylist(const QString& name, int index, bool isAutoPlaylist, const QString& autoQuery);
 
@@ -49,6 +55,12 @@ public:
 private:
     bool insertPlaylistTrack(int playlistId, const Fooyin::Track& track, int index);
     bool insertPlaylistTracks(int playlistId, const TrackList& tracks);
-    TrackList populatePlaylistTracks(const Playlist& playlist, const std::unordered_map<int, Track>& tracks);
+    bool applyTrackChanges(int playlistId, const Playlist::TrackChanges& changes);
+    bool shiftTrackIndexes(int playlistId, int from, int offset);
+    bool insertTrackRange(int playlistId, int index, const TrackList& tracks);
+    bool removeTrackRange(int playlistId, int index, int count);
+    bool moveTrackRange(int playlistId, int index, int count, int to);
+    TrackList populatePlaylistTracks(const Playlist& playlist, const std::unordered_map<int, Track>& tracks,
+                                     bool* inSync);
 };
 } // namespace Fooyin
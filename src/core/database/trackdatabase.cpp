@@ -27,6 +27,12 @@
 
 #include <QFileInfo>
 #include <QLoggingCategory>
+#include <QRegularExpression>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <unordered_map>
 
 Q_LOGGING_CATEGORY(TRK_DB, "fy.trackdb")
 
@@ -34,7 +40,27 @@ using namespace Qt::StringLiterals;
 
 using BindingsMap = std::map<QString, QVariant>;
 
+// Rows per insert when bulk importing. Kept under 999 parameters, the limit before SQLite 3.32.
+constexpr auto BulkInsertRows = 25;
+// Settings entry bumped by bumpLibraryRevision once per write to Tracks. Stats changes don't bump it.
+constexpr auto LibraryRevisionKey = "LibraryRevision";
+// Track ids per insert when filling the id table
+constexpr auto IdTableBatch = 500;
+// Rows per stats upsert, kept under 999 parameters
+constexpr auto StatsUpsertRows = 150;
+
 namespace {
+// SQLite integers are signed, so hashes are stored with the same bits
+qint64 toDbHash(uint64_t hash)
+{
+    return std::bit_cast<qint64>(hash);
+}
+
+uint64_t fromDbHash(const QVariant& value)
+{
+    return std::bit_cast<uint64_t>(value.toLongLong());
+}
+
 QString fetchTrackColumns()
 {
     static const QString columns = u"TrackID,"
@@ -84,6 +110,199 @@ QString fetchTrackColumns()
     return columns;
 }
 
+// Same as fetchTrackColumns, but with the rarely used columns left out (as NULL) to speed up loading the library.
+// See Track::setFieldsDeferred.
+QString hotTrackColumns()
+{
+    static const QString columns = [] {
+        // CodecProfile is kept as it's used by the default codec column
+        static constexpr std::array DeferredColumns{"Comment"_L1, "Tool"_L1, "TagTypes"_L1, "Encoding"_L1,
+                                                    "ExtraProperties"_L1};
+
+        QStringList hotColumns = fetchTrackColumns().split(u',');
+        for(QString& column : hotColumns) {
+            if(std::ranges::find(DeferredColumns, column) != DeferredColumns.cend()) {
+                column = u"NULL"_s;
+            }
+        }
+        return hotColumns.join(u',');
+    }();
+
+    return columns;
+}
+
+QString insertTrackStatement()
+{
+    static const auto statement = u"INSERT INTO Tracks ("
+                                  "FilePath,"
+                                  "Subsong,"
+                                  "Title,"
+                                  "TrackNumber,"
+                                  "TrackTotal,"
+                                  "Artists,"
+                                  "AlbumArtist,"
+                                  "Album,"
+                                  "DiscNumber,"
+                                  "DiscTotal,"
+                                  "Date,"
+                                  "Composer,"
+                                  "Performer,"
+                                  "Genres,"
+                                  "Comment,"
+                                  "CuePath,"
+                                  "Offset,"
+                                  "Duration,"
+                                  "FileSize,"
+                                  "BitRate,"
+                                  "SampleRate,"
+                                  "Channels,"
+                                  "BitDepth,"
+                                  "Codec,"
+                                  "CodecProfile,"
+                                  "Tool,"
+                                  "TagTypes,"
+                                  "Encoding,"
+                                  "ExtraTags,"
+                                  "ExtraProperties,"
+                                  "ModifiedDate,"
+                                  "TrackHash,"
+                                  "LibraryID,"
+                                  "RGTrackGain,"
+                                  "RGAlbumGain,"
+                                  "RGTrackPeak,"
+                                  "RGAlbumPeak"
+                                  ") "
+                                  "VALUES ("
+                                  ":filePath,"
+                                  ":subsong,"
+                                  ":title, "
+                                  ":trackNumber,"
+                                  ":trackTotal,"
+                                  ":artists,"
+                                  ":albumArtist,"
+                                  ":album,"
+                                  ":discNumber,"
+                                  ":discTotal,"
+                                  ":date, "
+                                  ":composer,"
+                                  ":performer,"
+                                  ":genres,"
+                                  ":comment,"
+                                  ":cuePath,"
+                                  ":offset,"
+                                  ":duration,"
+                                  ":fileSize,"
+                                  ":bitRate,"
+                                  ":sampleRate,"
+                                  ":channels,"
+                                  ":bitDepth,"
+                                  ":codec,"
+                                  ":codecProfile,"
+                                  ":tool,"
+                                  ":tagTypes,"
+                                  ":encoding,"
+                                  ":extraTags,"
+                                  ":extraProperties,"
+                                  ":modifiedDate,"
+                                  ":trackHash,"
+                                  ":libraryID,"
+                                  ":rgTrackGain,"
+                                  ":rgAlbumGain,"
+                                  ":rgTrackPeak,"
+                                  ":rgAlbumPeak"
+                                  ");"_s;
+
+    return statement;
+}
+
+QString pendingStatsStatement()
+{
+    static const auto statement = u"INSERT INTO PendingTrackStats "
+                                  "(TrackHash, AddedDate, FirstPlayed, LastPlayed, PlayCount, Rating) VALUES "
+                                  "(:trackHash, :addedDate, :firstPlayed, :lastPlayed, :playCount, :rating);"_s;
+    return statement;
+}
+
+// Merges with the existing row the same way as insertOrUpdateStats, skipping rows which wouldn't change
+QString statsUpsertStatement(const QString& valuesStatement)
+{
+    return valuesStatement.chopped(1)
+         + " ON CONFLICT(TrackHash) DO UPDATE SET "
+           "AddedDate = CASE WHEN IFNULL(AddedDate, 0) = 0 OR (excluded.AddedDate > 0 AND excluded.AddedDate "
+           "< AddedDate) THEN excluded.AddedDate ELSE AddedDate END, "
+           "FirstPlayed = CASE WHEN IFNULL(FirstPlayed, 0) = 0 OR (excluded.FirstPlayed > 0 AND "
+           "excluded.FirstPlayed < FirstPlayed) THEN excluded.FirstPlayed ELSE FirstPlayed END, "
+           "LastPlayed = MAX(IFNULL(LastPlayed, 0), excluded.LastPlayed), "
+           "PlayCount = MAX(IFNULL(PlayCount, 0), excluded.PlayCount), "
+           "Rating = excluded.Rating "
+           "WHERE (excluded.AddedDate > 0 AND (IFNULL(AddedDate, 0) = 0 OR excluded.AddedDate < AddedDate)) "
+           "OR (excluded.FirstPlayed > 0 AND (IFNULL(FirstPlayed, 0) = 0 OR excluded.FirstPlayed < FirstPlayed)) "
+           "OR excluded.LastPlayed > IFNULL(LastPlayed, 0) OR excluded.PlayCount > IFNULL(PlayCount, 0) "
+           "OR excluded.Rating IS NOT Rating;"_L1;
+}
+
+QString rowPlaceholder(const QString& placeholder, int row)
+{
+    return row == 0 ? placeholder : placeholder + u'_' + QString::number(row);
+}
+
+// Repeats the values of a single row insert @p rows times, using rowPlaceholder for each row
+QString multiRowInsert(const QString& statement, int rows)
+{
+    static const QRegularExpression placeholderPattern{u"(:\\w+)"_s};
+
+    const auto valuesPos = statement.indexOf("VALUES"_L1);
+    const QString values = statement.sliced(valuesPos + 6).trimmed().chopped(1);
+
+    QStringList rowValues{values};
+    for(int row{1}; row < rows; ++row) {
+        rowValues.append(QString{values}.replace(placeholderPattern, u"\\1_"_s + QString::number(row)));
+    }
+
+    return statement.first(valuesPos) + "VALUES "_L1 + rowValues.join(u',') + u';';
+}
+
+bool execStatement(const QSqlDatabase& db, const QString& statement)
+{
+    Fooyin::DbQuery query{db, statement};
+    return query.exec();
+}
+
+/*!
+ * Fills the connection's temporary LoadTrackIds table with @p ids, so any number of tracks
+ * can be read in one query using 'TrackID IN temp.LoadTrackIds'.
+ * A bound list can't be expanded into an IN clause by SQLite.
+ */
+bool fillIdTable(const QSqlDatabase& db, const Fooyin::TrackIds& ids)
+{
+    if(!execStatement(db, u"CREATE TEMP TABLE IF NOT EXISTS LoadTrackIds (TrackID INTEGER PRIMARY KEY);"_s)
+       || !execStatement(db, u"DELETE FROM temp.LoadTrackIds;"_s)) {
+        return false;
+    }
+
+    for(size_t start{0}; start < ids.size(); start += IdTableBatch) {
+        const size_t count = std::min<size_t>(IdTableBatch, ids.size() - start);
+
+        QStringList rows;
+        rows.reserve(static_cast<qsizetype>(count));
+        for(size_t i{start}; i < start + count; ++i) {
+            rows.append(u"("_s + QString::number(ids.at(i)) + u')');
+        }
+
+        // Ids are integers, so are safe to embed
+        if(!execStatement(db, u"INSERT OR IGNORE INTO temp.LoadTrackIds (TrackID) VALUES %1;"_s.arg(rows.join(u',')))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void clearIdTable(const QSqlDatabase& db)
+{
+    execStatement(db, u"DELETE FROM temp.LoadTrackIds;"_s);
+}
+
 BindingsMap trackBindings(const Fooyin::Track& track)
 {
     return {{u":filePath"_s, track.filepath()},
@@ -117,7 +336,7 @@ BindingsMap trackBindings(const Fooyin::Track& track)
             {u":extraTags"_s, track.serialiseExtraTags()},
             {u":extraProperties"_s, track.serialiseExtraProperties()},
             {u":modifiedDate"_s, static_cast<quint64>(track.modifiedTime())},
-            {u":trackHash"_s, track.hash()},
+            {u":trackHash"_s, toDbHash(track.hash())},
             {u":libraryID"_s, track.libraryId()},
             {u":rgTrackGain"_s, track.rgTrackGain()},
             {u":rgAlbumGain"_s, track.rgAlbumGain()},
@@ -162,7 +381,7 @@ Fooyin::Track readToTrack(const Fooyin::DbQuery& q)
     track.storeExtraProperties(q.value(30).toByteArray());
     track.setModifiedTime(q.value(31).toULongLong());
     track.setLibraryId(q.value(32).toInt());
-    track.setHash(q.value(33).toString());
+    track.setHash(fromDbHash(q.value(33)));
 
     bool isValid{false};
     if(const auto rgTrackGain = q.value(34).toFloat(&isValid); isValid) {
@@ -203,33 +422,158 @@ bool TrackDatabase::storeTracks(TrackList& tracks)
         return false;
     }
 
-    for(auto& track : tracks) {
-        if(track.id() < 0) {
-            insertTrack(track);
+    int stored{0};
+
+    if(m_bulkImport) {
+        std::vector<Track*> newTracks;
+        for(auto& track : tracks) {
+            if(track.id() < 0) {
+                newTracks.push_back(&track);
+            }
+        }
+
+        for(size_t start{0}; start < newTracks.size(); start += BulkInsertRows) {
+            const size_t count = std::min<size_t>(BulkInsertRows, newTracks.size() - start);
+            const std::span<Track*> chunk{newTracks.data() + start, count};
+
+            if(insertTracks(chunk)) {
+                stored += static_cast<int>(count);
+                continue;
+            }
+
+            // A single conflicting row fails the whole statement, so don't lose the rest of the chunk
+            qCWarning(TRK_DB) << "Unable to insert" << count << "tracks at once, retrying individually";
+            for(Track* track : chunk) {
+                const bool inserted = track->id() >= 0 ? insertOrUpdateStats(*track) : insertTrack(*track);
+                if(!inserted) {
+                    qCWarning(TRK_DB) << "Unable to insert track" << track->filepath();
+                }
+                if(track->id() >= 0) {
+                    ++stored;
+                }
+            }
+        }
+    }
+    else {
+        for(auto& track : tracks) {
+            if(track.id() < 0 && insertTrack(track)) {
+                ++stored;
+            }
         }
     }
 
+    bumpLibraryRevision(db(), stored);
+
     return transaction.commit();
 }
 
+bool TrackDatabase::beginBulkImport()
+{
+    if(m_bulkImport) {
+        return true;
+    }
+
+    DbQuery modeQuery{db(), u"PRAGMA journal_mode;"_s};
+    if(modeQuery.exec() && modeQuery.next()) {
+        m_journalMode = modeQuery.value(0).toString();
+    }
+
+    DbQuery syncQuery{db(), u"PRAGMA synchronous;"_s};
+    if(syncQuery.exec() && syncQuery.next()) {
+        m_synchronous = syncQuery.value(0).toString();
+    }
+
+    // The track hash index is rebuilt in one pass by endBulkImport
+    const bool success
+        = execStatement(db(), u"PRAGMA journal_mode = WAL;"_s) && execStatement(db(), u"PRAGMA synchronous = NORMAL;"_s)
+       && execStatement(db(), u"DROP INDEX IF EXISTS TrackIndex;"_s)
+       && execStatement(db(), u"CREATE TABLE IF NOT EXISTS PendingTrackStats (TrackHash INTEGER, AddedDate INTEGER, "
+                               "FirstPlayed INTEGER, LastPlayed INTEGER, PlayCount INTEGER, Rating REAL);"_s);
+
+    if(!success) {
+        qCWarning(TRK_DB) << "Unable to start bulk import";
+        endBulkImport();
+        return false;
+    }
+
+    m_bulkImport = true;
+    return true;
+}
+
+bool TrackDatabase::endBulkImport()
+{
+    m_bulkImport = false;
+
+    const bool success = finishBulkImport(db());
+
+    // The connection may already use WAL mode, with its own synchronous setting
+    execStatement(db(), u"PRAGMA synchronous = %1;"_s.arg(m_synchronous.isEmpty() ? u"FULL"_s : m_synchronous));
+    if(!m_journalMode.isEmpty() && m_journalMode.compare("wal"_L1, Qt::CaseInsensitive) != 0) {
+        execStatement(db(), u"PRAGMA journal_mode = %1;"_s.arg(m_journalMode));
+    }
+    m_journalMode.clear();
+    m_synchronous.clear();
+
+    return success;
+}
+
+bool TrackDatabase::finishBulkImport(const QSqlDatabase& db)
+{
+    bool success{true};
+
+    DbQuery tableQuery{db, u"SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = 'PendingTrackStats';"_s};
+    if(tableQuery.exec() && tableQuery.next()) {
+        tableQuery.reset();
+
+        // Merged the same way as insertOrUpdateStats
+        const auto mergeStatement
+            = u"INSERT INTO TrackStats (TrackHash, AddedDate, FirstPlayed, LastPlayed, PlayCount, Rating) "
+              "SELECT TrackHash, IFNULL(MIN(NULLIF(AddedDate, 0)), 0), IFNULL(MIN(NULLIF(FirstPlayed, 0)), 0), "
+              "MAX(LastPlayed), MAX(PlayCount), MAX(Rating) FROM PendingTrackStats WHERE true GROUP BY TrackHash "
+              "ON CONFLICT(TrackHash) DO UPDATE SET "
+              "AddedDate = CASE WHEN IFNULL(AddedDate, 0) = 0 OR (excluded.AddedDate > 0 AND excluded.AddedDate "
+              "< AddedDate) THEN excluded.AddedDate ELSE AddedDate END, "
+              "FirstPlayed = CASE WHEN IFNULL(FirstPlayed, 0) = 0 OR (excluded.FirstPlayed > 0 AND "
+              "excluded.FirstPlayed < FirstPlayed) THEN excluded.FirstPlayed ELSE FirstPlayed END, "
+              "LastPlayed = MAX(IFNULL(LastPlayed, 0), excluded.LastPlayed), "
+              "PlayCount = MAX(IFNULL(PlayCount, 0), excluded.PlayCount), "
+              "Rating = excluded.Rating;"_s;
+
+        DbTransaction transaction{db};
+        success = transaction && execStatement(db, mergeStatement)
+               && execStatement(db, u"DROP TABLE PendingTrackStats;"_s) && transaction.commit();
+        if(!success) {
+            qCWarning(TRK_DB) << "Unable to write track stats from bulk import";
+        }
+    }
+
+    return execStatement(db, u"CREATE INDEX IF NOT EXISTS TrackIndex ON Tracks(TrackHash);"_s) && success;
+}
+
 bool TrackDatabase::updateTracks(TrackList& tracks)
 {
     if(tracks.empty()) {
         return true;
     }
 
+    // Written back with the rest of the track
+    Track::loadDeferredFields(tracks);
+
     DbTransaction transaction{db()};
 
     if(!transaction) {
         return false;
     }
 
+    int updated{0};
     for(auto& track : tracks) {
-        if(track.id() >= 0) {
-            updateTrack(track);
+        if(track.id() >= 0 && updateTrackRow(track)) {
+            ++updated;
         }
     }
 
+    bumpLibraryRevision(db(), updated);
+
     return transaction.commit();
 }
 
@@ -254,32 +598,108 @@ bool TrackDatabase::reloadTrack(Track& track) const
 
 bool TrackDatabase::reloadTracks(TrackList& tracks) const
 {
-    const auto statement = u"SELECT %1 FROM TracksView WHERE TrackID IN (:trackIds);"_s.arg(fetchTrackColumns());
+    TrackIds ids;
+    ids.reserve(tracks.size());
+    for(const Track& track : tracks) {
+        if(track.id() >= 0) {
+            ids.push_back(track.id());
+        }
+    }
 
-    DbQuery q{db(), statement};
+    if(ids.empty()) {
+        return true;
+    }
+
+    TrackList reloaded;
+    if(!tracksById(ids, reloaded)) {
+        return false;
+    }
 
-    QStringList trackIds;
-    std::transform(tracks.cbegin(), tracks.cend(), std::back_inserter(trackIds),
-                   [](const Track& track) { return QString::number(track.id()); });
+    std::unordered_map<int, Track> idTracks;
+    idTracks.reserve(reloaded.size());
+    for(Track& track : reloaded) {
+        idTracks.emplace(track.id(), std::move(track));
+    }
+
+    for(Track& track : tracks) {
+        if(const auto trackIt = idTracks.find(track.id()); trackIt != idTracks.cend()) {
+            track = trackIt->second;
+        }
+    }
+
+    return true;
+}
+
+bool TrackDatabase::reloadTrackStats(TrackList& tracks) const
+{
+    const auto statement
+        = u"SELECT TrackHash, AddedDate, FirstPlayed, LastPlayed, PlayCount, Rating FROM TrackStats;"_s;
 
-    q.bindValue(u":trackIds"_s, trackIds);
+    DbQuery query{db(), statement};
+
+    if(!query.exec()) {
+        return false;
+    }
+
+    std::unordered_map<qint64, std::vector<Track*>> hashTracks;
+    hashTracks.reserve(tracks.size());
+    for(Track& track : tracks) {
+        hashTracks[toDbHash(track.hash())].push_back(&track);
+    }
+
+    while(query.next()) {
+        const auto hashIt = hashTracks.find(query.value(0).toLongLong());
+        if(hashIt == hashTracks.cend()) {
+            continue;
+        }
+
+        for(Track* track : hashIt->second) {
+            track->setAddedTime(query.value(1).toULongLong());
+            track->setFirstPlayed(query.value(2).toULongLong());
+            track->setLastPlayed(query.value(3).toULongLong());
+            track->setPlayCount(query.value(4).toInt());
+            track->setRating(query.value(5).toFloat());
+        }
+    }
+
+    return true;
+}
+
+bool TrackDatabase::tracksById(const TrackIds& ids, TrackList& tracks) const
+{
+    if(ids.empty()) {
+        return true;
+    }
+
+    if(!fillIdTable(db(), ids)) {
+        return false;
+    }
+
+    const auto statement
+        = u"SELECT %1 FROM TracksView WHERE TrackID IN temp.LoadTrackIds;"_s.arg(fetchTrackColumns());
+
+    DbQuery q{db(), statement};
 
     if(!q.exec()) {
+        clearIdTable(db());
         return false;
     }
 
-    tracks.clear();
+    tracks.reserve(tracks.size() + ids.size());
 
     while(q.next()) {
         tracks.emplace_back(readToTrack(q));
     }
 
+    q.reset();
+    clearIdTable(db());
+
     return true;
 }
 
 TrackList TrackDatabase::getAllTracks() const
 {
-    const auto statement = u"SELECT %1 FROM TracksView"_s.arg(fetchTrackColumns());
+    const auto statement = u"SELECT %1 FROM TracksView"_s.arg(hotTrackColumns());
 
     DbQuery q{db(), statement};
 
@@ -295,19 +715,57 @@ TrackList TrackDatabase::getAllTracks() const
     }
 
     while(q.next()) {
-        tracks.emplace_back(readToTrack(q));
+        tracks.emplace_back(readToTrack(q)).setFieldsDeferred();
     }
 
     return tracks;
 }
 
-TrackList TrackDatabase::tracksByHash(const QString& hash) const
+bool TrackDatabase::loadDeferredFields(const TrackIds& ids, TrackList& tracks) const
+{
+    if(ids.empty()) {
+        return true;
+    }
+
+    if(!fillIdTable(db(), ids)) {
+        return false;
+    }
+
+    const auto statement = u"SELECT TrackID, Comment, Tool, TagTypes, Encoding, ExtraProperties "
+                           "FROM Tracks WHERE TrackID IN temp.LoadTrackIds;"_s;
+
+    DbQuery q{db(), statement};
+
+    if(!q.exec()) {
+        clearIdTable(db());
+        return false;
+    }
+
+    tracks.reserve(tracks.size() + ids.size());
+
+    while(q.next()) {
+        Track& track = tracks.emplace_back();
+        track.setId(q.value(0).toInt());
+        track.setComment(q.value(1).toString());
+        track.setTool(q.value(2).toString());
+        track.setTagTypes(q.value(3).toString().split(QLatin1String{Constants::UnitSeparator}));
+        track.setEncoding(q.value(4).toString());
+        track.storeExtraProperties(q.value(5).toByteArray());
+    }
+
+    q.reset();
+    clearIdTable(db());
+
+    return true;
+}
+
+TrackList TrackDatabase::tracksByHash(uint64_t hash) const
 {
     const auto statement = u"SELECT %1 FROM TracksView WHERE TrackHash = :trackHash"_s.arg(fetchTrackColumns());
 
     DbQuery q{db(), statement};
 
-    q.bindValue(u":trackHash"_s, hash);
+    q.bindValue(u":trackHash"_s, toDbHash(hash));
 
     TrackList tracks;
 
@@ -324,11 +782,12 @@ TrackList TrackDatabase::tracksByHash(const QString& hash) const
 
 int TrackDatabase::idForTrack(Track& track) const
 {
-    const QString statement = u"SELECT TrackID FROM Tracks WHERE FilePath = :path;"_s;
+    const QString statement = u"SELECT TrackID FROM Tracks WHERE FilePath = :path AND Subsong = :subsong;"_s;
 
     DbQuery query{db(), statement};
 
     query.bindValue(u":path"_s, track.filepath());
+    query.bindValue(u":subsong"_s, track.subsong());
 
     if(!query.exec()) {
         return -1;
@@ -342,6 +801,16 @@ int TrackDatabase::idForTrack(Track& track) const
 }
 
 bool TrackDatabase::updateTrack(const Track& track)
+{
+    if(!updateTrackRow(track)) {
+        return false;
+    }
+
+    bumpLibraryRevision(db(), 1);
+    return true;
+}
+
+bool TrackDatabase::updateTrackRow(const Track& track) const
 {
     if(track.id() < 0) {
         qCWarning(TRK_DB) << "Cannot update track" << track.filepath() << "(Invalid ID)";
@@ -388,7 +857,7 @@ bool TrackDatabase::updateTrack(const Track& track)
                            "RGAlbumPeak = :rgAlbumPeak"
                            " WHERE TrackID = :trackId;"_s;
 
-    DbQuery query{db(), statement};
+    DbQuery& query = cachedQuery(statement);
 
     query.bindValue(u":trackId"_s, track.id());
 
@@ -407,24 +876,50 @@ bool TrackDatabase::updateTrackStats(const Track& track)
 
 bool TrackDatabase::updateTrackStats(const TrackList& tracks)
 {
-    bool success{true};
+    std::vector<const Track*> hashedTracks;
+    for(const Track& track : tracks) {
+        if(track.hash() != 0) {
+            hashedTracks.push_back(&track);
+        }
+    }
+    if(hashedTracks.size() != tracks.size()) {
+        qCWarning(TRK_DB) << "Cannot insert/update track stats (Hash empty)";
+    }
+    if(hashedTracks.empty()) {
+        return hashedTracks.size() == tracks.size();
+    }
 
     DbTransaction transaction{db()};
 
-    for(const Track& track : tracks) {
-        if(!insertOrUpdateStats(track)) {
-            success = false;
+    if(!transaction) {
+        return false;
+    }
+
+    for(size_t start{0}; start < hashedTracks.size(); start += StatsUpsertRows) {
+        const size_t count = std::min<size_t>(StatsUpsertRows, hashedTracks.size() - start);
+        if(!upsertStats({hashedTracks.data() + start, count})) {
+            return false;
         }
     }
 
-    return success && transaction.commit();
+    return transaction.commit() && hashedTracks.size() == tracks.size();
 }
 
 bool TrackDatabase::deleteTrack(int id)
+{
+    if(!deleteTrackRow(id)) {
+        return false;
+    }
+
+    bumpLibraryRevision(db(), 1);
+    return true;
+}
+
+bool TrackDatabase::deleteTrackRow(int id) const
 {
     const QString statement = u"DELETE FROM Tracks WHERE TrackID = :trackID;"_s;
 
-    DbQuery query{db(), statement};
+    DbQuery& query = cachedQuery(statement);
 
     query.bindValue(u":trackID"_s, id);
 
@@ -443,8 +938,10 @@ bool TrackDatabase::deleteTracks(const TrackList& tracks)
         return false;
     }
 
-    const int fileCount = static_cast<int>(
-        std::count_if(tracks.cbegin(), tracks.cend(), [this](const Track& track) { return deleteTrack(track.id()); }));
+    const int fileCount = static_cast<int>(std::count_if(
+        tracks.cbegin(), tracks.cend(), [this](const Track& track) { return deleteTrackRow(track.id()); }));
+
+    bumpLibraryRevision(db(), fileCount);
 
     const auto success = transaction.commit();
 
@@ -483,6 +980,8 @@ std::set<int> TrackDatabase::deleteLibraryTracks(int libraryId)
         if(!query.exec()) {
             return {};
         }
+
+        bumpLibraryRevision(db(), query.numRowsAffected());
     }
 
     const auto statement = u"UPDATE Tracks SET LibraryID = :nonLibraryId WHERE LibraryID = :libraryId;"_s;
@@ -496,6 +995,8 @@ std::set<int> TrackDatabase::deleteLibraryTracks(int libraryId)
         return {};
     }
 
+    bumpLibraryRevision(db(), query.numRowsAffected());
+
     return tracksToRemove;
 }
 
@@ -506,6 +1007,75 @@ void TrackDatabase::cleanupTracks()
     deleteExpiredStats();
 }
 
+bool TrackDatabase::migrateTrackHashes(const QSqlDatabase& db)
+{
+    {
+        DbQuery query{db, u"SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = 'TrackHashesOld';"_s};
+        if(!query.exec()) {
+            return false;
+        }
+        if(!query.next()) {
+            return true;
+        }
+    }
+
+    qCInfo(TRK_DB) << "Migrating track hashes";
+
+    DbTransaction transaction{db};
+    if(!transaction) {
+        return false;
+    }
+
+    DbQuery tracksQuery{db, u"SELECT TrackID, FilePath, Subsong, Title, TrackNumber, Artists, Album, DiscNumber, "
+                            "TrackHashesOld.TrackHash FROM Tracks JOIN TrackHashesOld USING (TrackID);"_s};
+    if(!tracksQuery.exec()) {
+        return false;
+    }
+
+    DbQuery updateQuery{db, u"UPDATE Tracks SET TrackHash = :trackHash WHERE TrackID = :trackId;"_s};
+    DbQuery statsQuery{db, u"INSERT OR IGNORE INTO TrackStats "
+                           "(TrackHash, LastSeen, AddedDate, FirstPlayed, LastPlayed, PlayCount, Rating) "
+                           "SELECT :trackHash, LastSeen, AddedDate, FirstPlayed, LastPlayed, PlayCount, Rating "
+                           "FROM TrackStatsOld WHERE TrackHash = :oldHash;"_s};
+
+    int migrated{0};
+    while(tracksQuery.next()) {
+        Track track;
+        track.setFilePath(tracksQuery.value(1).toString());
+        track.setSubsong(tracksQuery.value(2).toInt());
+        track.setTitle(tracksQuery.value(3).toString());
+        track.setTrackNumber(tracksQuery.value(4).toString());
+        track.setArtists(tracksQuery.value(5).toString().split(QLatin1String{Constants::UnitSeparator}));
+        track.setAlbum(tracksQuery.value(6).toString());
+        track.setDiscNumber(tracksQuery.value(7).toString());
+
+        const qint64 hash = toDbHash(track.generateHash());
+
+        updateQuery.bindValue(u":trackHash"_s, hash);
+        updateQuery.bindValue(u":trackId"_s, tracksQuery.value(0).toInt());
+        statsQuery.bindValue(u":trackHash"_s, hash);
+        statsQuery.bindValue(u":oldHash"_s, tracksQuery.value(8).toString());
+
+        if(!updateQuery.exec() || !statsQuery.exec()) {
+            return false;
+        }
+        ++migrated;
+    }
+
+    bumpLibraryRevision(db, migrated);
+
+    // Stats of tracks no longer in the database can't be rehashed without their metadata, so are dropped
+    const std::array statements{u"DROP TABLE TrackStatsOld;"_s, u"DROP TABLE TrackHashesOld;"_s};
+    for(const auto& statement : statements) {
+        DbQuery query{db, statement};
+        if(!query.exec()) {
+            return false;
+        }
+    }
+
+    return transaction.commit();
+}
+
 void TrackDatabase::dropViews(const QSqlDatabase& db)
 {
     const auto statement = u"DROP VIEW IF EXISTS TracksView;"_s;
@@ -570,6 +1140,36 @@ void TrackDatabase::insertViews(const QSqlDatabase& db)
     query.exec();
 }
 
+bool TrackDatabase::bumpLibraryRevision(const QSqlDatabase& db, int rows)
+{
+    if(rows <= 0) {
+        return true;
+    }
+
+    // Bumped once per write rather than by triggers, which would update Settings for every row
+    const auto statement = u"UPDATE Settings SET Value = Value + :rows WHERE Name = :name;"_s;
+
+    DbQuery query{db, statement};
+    query.bindValue(u":rows"_s, rows);
+    query.bindValue(u":name"_s, QLatin1String{LibraryRevisionKey});
+
+    return query.exec();
+}
+
+int64_t TrackDatabase::libraryRevision() const
+{
+    const auto statement = u"SELECT Value FROM Settings WHERE Name = :name;"_s;
+
+    DbQuery query{db(), statement};
+    query.bindValue(u":name"_s, QLatin1String{LibraryRevisionKey});
+
+    if(!query.exec() || !query.next()) {
+        return -1;
+    }
+
+    return query.value(0).toLongLong();
+}
+
 int TrackDatabase::trackCount() const
 {
     const auto statement = u"SELECT COUNT(*) FROM Tracks;"_s;
@@ -589,86 +1189,9 @@ int TrackDatabase::trackCount() const
 
 bool TrackDatabase::insertTrack(Track& track) const
 {
-    const auto statement = u"INSERT INTO Tracks ("
-                           "FilePath,"
-                           "Subsong,"
-                           "Title,"
-                           "TrackNumber,"
-                           "TrackTotal,"
-                           "Artists,"
-                           "AlbumArtist,"
-                           "Album,"
-                           "DiscNumber,"
-                           "DiscTotal,"
-                           "Date,"
-                           "Composer,"
-                           "Performer,"
-                           "Genres,"
-                           "Comment,"
-                           "CuePath,"
-                           "Offset,"
-                           "Duration,"
-                           "FileSize,"
-                           "BitRate,"
-                           "SampleRate,"
-                           "Channels,"
-                           "BitDepth,"
-                           "Codec,"
-                           "CodecProfile,"
-                           "Tool,"
-                           "TagTypes,"
-                           "Encoding,"
-                           "ExtraTags,"
-                           "ExtraProperties,"
-                           "ModifiedDate,"
-                           "TrackHash,"
-                           "LibraryID,"
-                           "RGTrackGain,"
-                           "RGAlbumGain,"
-                           "RGTrackPeak,"
-                           "RGAlbumPeak"
-                           ") "
-                           "VALUES ("
-                           ":filePath,"
-                           ":subsong,"
-                           ":title, "
-                           ":trackNumber,"
-                           ":trackTotal,"
-                           ":artists,"
-                           ":albumArtist,"
-                           ":album,"
-                           ":discNumber,"
-                           ":discTotal,"
-                           ":date, "
-                           ":composer,"
-                           ":performer,"
-                           ":genres,"
-                           ":comment,"
-                           ":cuePath,"
-                           ":offset,"
-                           ":duration,"
-                           ":fileSize,"
-                           ":bitRate,"
-                           ":sampleRate,"
-                           ":channels,"
-                           ":bitDepth,"
-                           ":codec,"
-                           ":codecProfile,"
-                           ":tool,"
-                           ":tagTypes,"
-                           ":encoding,"
-                           ":extraTags,"
-                           ":extraProperties,"
-                           ":modifiedDate,"
-                           ":trackHash,"
-                           ":libraryID,"
-                           ":rgTrackGain,"
-                           ":rgAlbumGain,"
-                           ":rgTrackPeak,"
-                           ":rgAlbumPeak"
-                           ");"_s;
+    const QString statement = insertTrackStatement();
 
-    DbQuery query{db(), statement};
+    DbQuery& query = cachedQuery(statement);
 
     const auto bindings = trackBindings(track);
     for(const auto& [name, value] : bindings) {
@@ -684,9 +1207,71 @@ bool TrackDatabase::insertTrack(Track& track) const
     return insertOrUpdateStats(track);
 }
 
+bool TrackDatabase::insertTracks(std::span<Track*> tracks) const
+{
+    const int rows = static_cast<int>(tracks.size());
+
+    DbQuery& query = cachedQuery(multiRowInsert(insertTrackStatement(), rows));
+
+    for(int row{0}; row < rows; ++row) {
+        const auto bindings = trackBindings(*tracks[row]);
+        for(const auto& [name, value] : bindings) {
+            query.bindValue(rowPlaceholder(name, row), value);
+        }
+    }
+
+    if(!query.exec()) {
+        return false;
+    }
+
+    // TrackID is AUTOINCREMENT, so the rows of a single insert have consecutive ids
+    const int firstId = query.lastInsertId().toInt() - rows + 1;
+    for(int row{0}; row < rows; ++row) {
+        tracks[row]->setId(firstId + row);
+    }
+
+    // Stats are merged into TrackStats by endBulkImport
+    std::vector<const Track*> hashedTracks;
+    std::ranges::copy_if(tracks, std::back_inserter(hashedTracks),
+                         [](const Track* track) { return track->hash() != 0; });
+    if(hashedTracks.empty()) {
+        return true;
+    }
+
+    DbQuery& statsQuery = cachedQuery(multiRowInsert(pendingStatsStatement(), static_cast<int>(hashedTracks.size())));
+    bindStats(statsQuery, hashedTracks);
+
+    return statsQuery.exec();
+}
+
+bool TrackDatabase::upsertStats(std::span<const Track* const> tracks) const
+{
+    static const auto statement = u"INSERT INTO TrackStats "
+                                  "(TrackHash, AddedDate, FirstPlayed, LastPlayed, PlayCount, Rating) VALUES "
+                                  "(:trackHash, :addedDate, :firstPlayed, :lastPlayed, :playCount, :rating);"_s;
+
+    DbQuery& query = cachedQuery(statsUpsertStatement(multiRowInsert(statement, static_cast<int>(tracks.size()))));
+    bindStats(query, tracks);
+
+    return query.exec();
+}
+
+void TrackDatabase::bindStats(DbQuery& query, std::span<const Track* const> tracks)
+{
+    for(int row{0}; const Track* track : tracks) {
+        query.bindValue(rowPlaceholder(u":trackHash"_s, row), toDbHash(track->hash()));
+        query.bindValue(rowPlaceholder(u":addedDate"_s, row), QVariant::fromValue(track->addedTime()));
+        query.bindValue(rowPlaceholder(u":firstPlayed"_s, row), QVariant::fromValue(track->firstPlayed()));
+        query.bindValue(rowPlaceholder(u":lastPlayed"_s, row), QVariant::fromValue(track->lastPlayed()));
+        query.bindValue(rowPlaceholder(u":playCount"_s, row), track->playCount());
+        query.bindValue(rowPlaceholder(u":rating"_s, row), track->rating());
+        ++row;
+    }
+}
+
 bool TrackDatabase::insertOrUpdateStats(const Track& track) const
 {
-    if(track.hash().isEmpty()) {
+    if(track.hash() == 0) {
         qCWarning(TRK_DB) << "Cannot insert/update track stats (Hash empty)";
         return false;
     }
@@ -701,9 +1286,9 @@ bool TrackDatabase::insertOrUpdateStats(const Track& track) const
         const auto statement = u"SELECT AddedDate, FirstPlayed, LastPlayed, PlayCount, Rating FROM "
                                "TrackStats WHERE TrackHash = :trackHash;"_s;
 
-        DbQuery query{db(), statement};
+        DbQuery& query = cachedQuery(statement);
 
-        query.bindValue(u":trackHash"_s, track.hash());
+        query.bindValue(u":trackHash"_s, toDbHash(track.hash()));
 
         if(!query.exec()) {
             return false;
@@ -716,6 +1301,9 @@ bool TrackDatabase::insertOrUpdateStats(const Track& track) const
             playCount   = query.value(3).toInt();
             rating      = query.value(4).toFloat();
         }
+
+        // Release the read lock held by an unfinished select
+        query.reset();
     }
 
     bool dbNeedsUpdate{false};
@@ -763,9 +1351,9 @@ bool TrackDatabase::insertOrUpdateStats(const Track& track) const
                            u"PlayCount, Rating) VALUES "
                            "(:trackHash, :addedDate, :firstPlayed, :lastPlayed, :playCount, :rating);"_s;
 
-    DbQuery query{db(), statement};
+    DbQuery& query = cachedQuery(statement);
 
-    query.bindValue(u":trackHash"_s, track.hash());
+    query.bindValue(u":trackHash"_s, toDbHash(track.hash()));
     query.bindValue(u":addedDate"_s, QVariant::fromValue(added));
     query.bindValue(u":firstPlayed"_s, QVariant::fromValue(firstPlayed));
     query.bindValue(u":lastPlayed"_s, QVariant::fromValue(lastPlayed));
@@ -782,7 +1370,9 @@ void TrackDatabase::removeUnmanagedTracks() const
 
     DbQuery query{db(), statement};
 
-    query.exec();
+    if(query.exec()) {
+        bumpLibraryRevision(db(), query.numRowsAffected());
+    }
 }
 
 void TrackDatabase::updateLastSeenStats() const
@@ -25,6 +25,7 @@
 #include <utils/database/dbmodule.h>
 
 #include <set>
+#include <span>
 
 namespace Fooyin {
 class FYCORE_EXPORT TrackDatabase : public DbModule
@@ -33,14 +34,52 @@ public:
     bool storeTracks(TrackList& tracks);
     bool updateTracks(TrackList& tracks);
 
+    /*!
+     * Speeds up storing large numbers of tracks, such as on the first scan of a library.
+     * Until @fn endBulkImport is called, tracks are inserted several rows at a time with
+     * relaxed syncing, the track hash index is dropped, and stats are queued to be written at the end.
+     * @note both must be called from the same thread.
+     */
+    bool beginBulkImport();
+    /*!
+     * Writes the stats queued since @fn beginBulkImport and rebuilds the track hash index.
+     */
+    bool endBulkImport();
+    /*!
+     * Completes a bulk import which was interrupted, e.g. by a crash.
+     * Does nothing if there isn't one.
+     */
+    static bool finishBulkImport(const QSqlDatabase& db);
+
     bool reloadTrack(Track& track) const;
+    /*!
+     * Reloads @p tracks from the database in a single query.
+     * Tracks which aren't found are left unchanged.
+     */
     bool reloadTracks(TrackList& tracks) const;
+    /*!
+     * Reads the tracks with @p ids into @p tracks, in database order, using a single query
+     * however many ids are passed.
+     */
+    bool tracksById(const TrackIds& ids, TrackList& tracks) const;
+    /*!
+     * Returns all tracks, with rarely used fields deferred until needed.
+     * @see Track::setFieldsDeferred
+     */
     [[nodiscard]] TrackList getAllTracks() const;
-    [[nodiscard]] TrackList tracksByHash(const QString& hash) const;
+    /*!
+     * Reads the fields left out by @fn getAllTracks for the tracks with @p ids into @p tracks.
+     */
+    bool loadDeferredFields(const TrackIds& ids, TrackList& tracks) const;
+    [[nodiscard]] TrackList tracksByHash(uint64_t hash) const;
     int idForTrack(Track& track) const;
 
     bool updateTrack(const Track& track);
     bool updateTrackStats(const Track& track);
+    /*!
+     * Writes the stats of @p tracks in one transaction, using multi-row upserts merged the same
+     * way as for a single track.
+     */
     bool updateTrackStats(const TrackList& tracks);
 
     bool deleteTrack(int id);
@@ -48,6 +87,28 @@ public:
     std::set<int> deleteLibraryTracks(int libraryId);
 
     void cleanupTracks();
+    /** Marks when the stats of tracks no longer in the database were last seen. */
+    void updateLastSeenStats() const;
+    /** Deletes the stats of tracks that haven't been seen for four weeks. */
+    void deleteExpiredStats() const;
+
+    /*!
+     * Recalculates track hashes left unset by schema revision 16, carrying over their stats.
+     * Stats of tracks no longer in the database can't be carried over, so are dropped.
+     * Does nothing if they've already been migrated.
+     */
+    static bool migrateTrackHashes(const QSqlDatabase& db);
+
+    /*!
+     * Returns a counter incremented by the number of rows changed by each write to the tracks table,
+     * or -1 if it isn't available. Track stats don't affect it.
+     */
+    [[nodiscard]] int64_t libraryRevision() const;
+    /*!
+     * Reads the stats of all tracks, keyed by track hash, into @p tracks.
+     * Tracks without stats are left unchanged.
+     */
+    bool reloadTrackStats(TrackList& tracks) const;
 
     static void dropViews(const QSqlDatabase& db);
     static void insertViews(const QSqlDatabase& db);
@@ -55,9 +116,17 @@ public:
 private:
     [[nodiscard]] int trackCount() const;
     bool insertTrack(Track& track) const;
+    bool insertTracks(std::span<Track*> tracks) const;
+    bool updateTrackRow(const Track& track) const;
+    bool deleteTrackRow(int id) const;
+    static bool bumpLibraryRevision(const QSqlDatabase& db, int rows);
     bool insertOrUpdateStats(const Track& track) const;
+    bool upsertStats(std::span<const Track* const> tracks) const;
+    static void bindStats(DbQuery& query, std::span<const Track* const> tracks);
     void removeUnmanagedTracks() const;
-    void updateLastSeenStats() const;
-    void deleteExpiredStats() const;
+
+    bool m_bulkImport{false};
+    QString m_journalMode;
+    QString m_synchronous;
 };
 } // namespace Fooyin
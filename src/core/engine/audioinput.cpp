@@ -78,6 +78,11 @@ bool AudioReader::init(const AudioSource& /*source*/)
     return true;
 }
 
+bool AudioReader::setReadOptions(ReadOptions options)
+{
+    return options == ReadAll;
+}
+
 QByteArray AudioReader::readCover(const AudioSource& /*source*/, const Track& /*track*/, Track::Cover /*cover*/)
 {
     return {};
@@ -62,6 +62,23 @@ public:
     std::vector<AudioLoader::LoaderEntry<ArchiveReaderCreator>> m_archiveReaders;
 
     std::shared_mutex m_mutex;
+
+    [[nodiscard]] const AudioLoader::LoaderEntry<ReaderCreator>* findReader(const QString& file) const
+    {
+        const QString ext      = QFileInfo{file}.suffix().toLower();
+        const bool isInArchive = Track::isArchivePath(file);
+
+        for(const auto& loader : m_readers) {
+            if(!loader.enabled) {
+                continue;
+            }
+            if((isInArchive && loader.name == "Archive"_L1) || (!isInArchive && loader.extensions.contains(ext))) {
+                return &loader;
+            }
+        }
+
+        return nullptr;
+    }
 };
 
 AudioLoader::AudioLoader()
@@ -239,16 +256,8 @@ std::unique_ptr<AudioReader> AudioLoader::readerForFile(const QString& file) con
 {
     const std::shared_lock lock{p->m_mutex};
 
-    const QString ext      = QFileInfo{file}.suffix().toLower();
-    const bool isInArchive = Track::isArchivePath(file);
-
-    for(const auto& loader : p->m_readers) {
-        if(!loader.enabled) {
-            continue;
-        }
-        if((isInArchive && loader.name == "Archive"_L1) || (!isInArchive && loader.extensions.contains(ext))) {
-            return loader.creator();
-        }
+    if(const auto* loader = p->findReader(file)) {
+        return loader->creator();
     }
 
     return nullptr;
@@ -259,6 +268,17 @@ std::unique_ptr<AudioReader> AudioLoader::readerForTrack(const Track& track) con
     return readerForFile(track.filepath());
 }
 
+QString AudioLoader::readerNameForFile(const QString& file) const
+{
+    const std::shared_lock lock{p->m_mutex};
+
+    if(const auto* loader = p->findReader(file)) {
+        return loader->name;
+    }
+
+    return {};
+}
+
 std::unique_ptr<ArchiveReader> AudioLoader::archiveReaderForFile(const QString& file) const
 {
     const std::shared_lock lock{p->m_mutex};
@@ -24,6 +24,7 @@
 #include <core/constants.h>
 #include <core/track.h>
 #include <utils/helpers.h>
+#include <utils/perfecthash.h>
 
 #include <taglib/aifffile.h>
 #include <taglib/apefile.h>
@@ -487,22 +488,21 @@ constexpr std::array tagToMp4{
     std::pair("REPLAYGAIN_TRACK_PEAK", "----:com.apple.iTunes:replaygain_track_peak"),
 };
 
+constexpr Fooyin::PerfectHashMap Mp4ToTag{mp4ToTag, Qt::CaseSensitive};
+constexpr Fooyin::PerfectHashMap TagToMp4{tagToMp4, Qt::CaseSensitive};
+
 QString findMp4Tag(const TagLib::String& tag)
 {
-    for(const auto& [key, value] : mp4ToTag) {
-        if(tag == key) {
-            return QString::fromUtf8(value);
-        }
+    if(const auto name = Mp4ToTag.find(tag)) {
+        return QString::fromUtf8(*name);
     }
     return {};
 }
 
 TagLib::String findMp4Tag(const QString& tag)
 {
-    for(const auto& [key, value] : tagToMp4) {
-        if(tag == QLatin1String(key)) {
-            return value;
-        }
+    if(const auto name = TagToMp4.find(tag)) {
+        return *name;
     }
     return {};
 }
@@ -618,99 +618,176 @@ void readAudioProperties(const TagLib::File& file, Fooyin::Track& track)
     }
 }
 
+template <typename File>
+void readBitDepth(const File& file, Fooyin::Track& track)
+{
+    if(const auto* props = file.audioProperties()) {
+        if(const int bps = props->bitsPerSample(); bps > 0) {
+            track.setBitDepth(bps);
+        }
+    }
+}
+
+enum class TagField : uint8_t
+{
+    Title = 0,
+    Artist,
+    Album,
+    AlbumArtist,
+    Genre,
+    Composer,
+    Performer,
+    Comment,
+    Date,
+    Year,
+    Rating,
+    RatingAlt,
+    PlayCount,
+    Track,
+    TrackTotal,
+    Disc,
+    DiscTotal,
+    RGTrackGain,
+    RGAlbumGain,
+    RGTrackPeak,
+    RGAlbumPeak,
+};
+
+constexpr std::array tagFields{
+    std::pair(Fooyin::Tag::Title, TagField::Title),
+    std::pair(Fooyin::Tag::Artist, TagField::Artist),
+    std::pair(Fooyin::Tag::ArtistAlt, TagField::Artist),
+    std::pair(Fooyin::Tag::Album, TagField::Album),
+    std::pair(Fooyin::Tag::AlbumArtist, TagField::AlbumArtist),
+    std::pair(Fooyin::Tag::Genre, TagField::Genre),
+    std::pair(Fooyin::Tag::Composer, TagField::Composer),
+    std::pair(Fooyin::Tag::Performer, TagField::Performer),
+    std::pair(Fooyin::Tag::Comment, TagField::Comment),
+    std::pair(Fooyin::Tag::Date, TagField::Date),
+    std::pair(Fooyin::Tag::Year, TagField::Year),
+    std::pair(Fooyin::Tag::Rating, TagField::Rating),
+    std::pair(Fooyin::Tag::RatingAlt, TagField::RatingAlt),
+    std::pair(Fooyin::Tag::PlayCount, TagField::PlayCount),
+    std::pair(Fooyin::Tag::Track, TagField::Track),
+    std::pair(Fooyin::Tag::TrackAlt, TagField::Track),
+    std::pair(Fooyin::Tag::TrackTotal, TagField::TrackTotal),
+    std::pair(Fooyin::Tag::TrackTotalAlt, TagField::TrackTotal),
+    std::pair(Fooyin::Tag::Disc, TagField::Disc),
+    std::pair(Fooyin::Tag::DiscAlt, TagField::Disc),
+    std::pair(Fooyin::Tag::DiscTotal, TagField::DiscTotal),
+    std::pair(Fooyin::Tag::DiscTotalAlt, TagField::DiscTotal),
+    std::pair(Fooyin::Tag::ReplayGain::TrackGain, TagField::RGTrackGain),
+    std::pair(Fooyin::Tag::ReplayGain::TrackGainAlt, TagField::RGTrackGain),
+    std::pair(Fooyin::Tag::ReplayGain::AlbumGain, TagField::RGAlbumGain),
+    std::pair(Fooyin::Tag::ReplayGain::AlbumGainAlt, TagField::RGAlbumGain),
+    std::pair(Fooyin::Tag::ReplayGain::TrackPeak, TagField::RGTrackPeak),
+    std::pair(Fooyin::Tag::ReplayGain::TrackPeakAlt, TagField::RGTrackPeak),
+    std::pair(Fooyin::Tag::ReplayGain::AlbumPeak, TagField::RGAlbumPeak),
+    std::pair(Fooyin::Tag::ReplayGain::AlbumPeakAlt, TagField::RGAlbumPeak),
+};
+
+constexpr Fooyin::PerfectHashMap TagFields{tagFields, Qt::CaseSensitive};
+
 void readGeneralProperties(const TagLib::PropertyMap& props, Fooyin::Track& track)
 {
     track.clearExtraTags();
 
-    using namespace Fooyin::Tag;
-
     for(const auto& [field, value] : props) {
-        if(field == Title) {
-            track.setTitle(convertString(value.toString()));
-        }
-        else if(field == Artist || field == ArtistAlt) {
-            track.setArtists(convertStringList(value));
-        }
-        else if(field == Album) {
-            track.setAlbum(convertString(value.toString()));
-        }
-        else if(field == AlbumArtist) {
-            track.setAlbumArtists(convertStringList(value));
-        }
-        else if(field == Genre) {
-            track.setGenres(convertStringList(value));
-        }
-        else if(field == Composer) {
-            track.setComposers(convertStringList(value));
-        }
-        else if(field == Performer) {
-            track.setPerformers(convertStringList(value));
-        }
-        else if(field == Comment) {
-            track.setComment(convertString(value.toString()));
-        }
-        else if(field == Date) {
-            track.setDate(convertString(value.toString()));
-        }
-        else if(field == Year) {
-            track.setYear(convertString(value.toString()).toInt());
-        }
-        else if(field == Track || field == TrackAlt) {
-            track.setTrackNumber(convertString(value.toString()));
-        }
-        else if(field == TrackTotal || field == TrackTotalAlt) {
-            track.setTrackTotal(convertString(value.toString()));
-        }
-        else if(field == Disc || field == DiscAlt) {
-            track.setDiscNumber(convertString(value.toString()));
-        }
-        else if(field == DiscTotal || field == DiscTotalAlt) {
-            track.setDiscTotal(convertString(value.toString()));
-        }
-        else if(field == Rating) {
-            const int rating = value.front().toInt();
-            if(rating > 0 && rating <= 100) {
-                float adjustedRating = static_cast<float>(rating) / 10;
-                if(adjustedRating > 1.0) {
-                    adjustedRating /= 10;
-                }
-                else {
-                    adjustedRating *= 2;
+        const auto tagField = TagFields.find(field);
+        if(!tagField) {
+            // Other ReplayGain fields aren't kept
+            if(!field.startsWith(Fooyin::Tag::ReplayGain::ReplayGainStart)) {
+                const auto tagEntry = convertString(field);
+                for(const auto& tagValue : value) {
+                    track.addExtraTag(tagEntry, convertString(tagValue));
                 }
-                track.setRating(adjustedRating);
             }
+            continue;
         }
-        else if(field == RatingAlt) {
-            const float rating = convertString(value.toString()).toFloat();
-            if(rating > 0) {
-                track.setRating(rating);
+
+        switch(*tagField) {
+            case(TagField::Title):
+                track.setTitle(convertString(value.toString()));
+                break;
+            case(TagField::Artist):
+                track.setArtists(convertStringList(value));
+                break;
+            case(TagField::Album):
+                track.setAlbum(convertString(value.toString()));
+                break;
+            case(TagField::AlbumArtist):
+                track.setAlbumArtists(convertStringList(value));
+                break;
+            case(TagField::Genre):
+                track.setGenres(convertStringList(value));
+                break;
+            case(TagField::Composer):
+                track.setComposers(convertStringList(value));
+                break;
+            case(TagField::Performer):
+                track.setPerformers(convertStringList(value));
+                break;
+            case(TagField::Comment):
+                track.setComment(convertString(value.toString()));
+                break;
+            case(TagField::Date):
+                track.setDate(convertString(value.toString()));
+                break;
+            case(TagField::Year):
+                track.setYear(convertString(value.toString()).toInt());
+                break;
+            case(TagField::Track):
+                track.setTrackNumber(convertString(value.toString()));
+                break;
+            case(TagField::TrackTotal):
+                track.setTrackTotal(convertString(value.toString()));
+                break;
+            case(TagField::Disc):
+                track.setDiscNumber(convertString(value.toString()));
+                break;
+            case(TagField::DiscTotal):
+                track.setDiscTotal(convertString(value.toString()));
+                break;
+            case(TagField::Rating): {
+                const int rating = value.front().toInt();
+                if(rating > 0 && rating <= 100) {
+                    float adjustedRating = static_cast<float>(rating) / 10;
+                    if(adjustedRating > 1.0) {
+                        adjustedRating /= 10;
+                    }
+                    else {
+                        adjustedRating *= 2;
+                    }
+                    track.setRating(adjustedRating);
+                }
+                break;
             }
-        }
-        else if(field == PlayCount) {
-            const int count = convertString(value.toString()).toInt();
-            if(count > 0) {
-                track.setPlayCount(count);
+            case(TagField::RatingAlt): {
+                const float rating = convertString(value.toString()).toFloat();
+                if(rating > 0) {
+                    track.setRating(rating);
+                }
+                break;
             }
-        }
-        else if(field.startsWith(ReplayGain::ReplayGainStart)) {
-            if(field == ReplayGain::TrackGain || field == ReplayGain::TrackGainAlt) {
-                track.setRGTrackGain(gainStringToFloat(value.toString()));
+            case(TagField::PlayCount): {
+                const int count = convertString(value.toString()).toInt();
+                if(count > 0) {
+                    track.setPlayCount(count);
+                }
+                break;
             }
-            else if(field == ReplayGain::AlbumGain || field == ReplayGain::AlbumGainAlt) {
+            case(TagField::RGTrackGain):
+                track.setRGTrackGain(gainStringToFloat(value.toString()));
+                break;
+            case(TagField::RGAlbumGain):
                 track.setRGAlbumGain(gainStringToFloat(value.toString()));
-            }
-            else if(field == ReplayGain::TrackPeak || field == ReplayGain::TrackPeakAlt) {
+                break;
+            case(TagField::RGTrackPeak):
                 track.setRGTrackPeak(convertString(value.toString()).toFloat());
-            }
-            else if(field == ReplayGain::AlbumPeak || field == ReplayGain::AlbumPeakAlt) {
+                break;
+            case(TagField::RGAlbumPeak):
                 track.setRGAlbumPeak(convertString(value.toString()).toFloat());
-            }
-        }
-        else {
-            const auto tagEntry = convertString(field);
-            for(const auto& tagValue : value) {
-                track.addExtraTag(tagEntry, convertString(tagValue));
-            }
+                break;
         }
     }
 }
@@ -2090,6 +2167,12 @@ bool TagLibReader::canWriteMetaData() const
     return true;
 }
 
+bool TagLibReader::setReadOptions(ReadOptions options)
+{
+    m_readOptions = options;
+    return true;
+}
+
 enum VbrMethod : uint8_t
 {
     Unknown  = 0,
@@ -2271,6 +2354,8 @@ bool TagLibReader::readTrack(const AudioSource& source, Track& track)
     const QMimeDatabase mimeDb;
     QString mimeType = mimeDb.mimeTypeForFile(source.filepath).name();
     const auto style = TagLib::AudioProperties::Average;
+    // Files opened without audio properties return null from audioProperties()
+    const bool readAudioProps = !(m_readOptions & SkipAudioProperties);
 
     const auto readProperties = [&track](const TagLib::File& file) {
         readAudioProperties(file, track);
@@ -2283,13 +2368,15 @@ bool TagLibReader::readTrack(const AudioSource& source, Track& track)
     }
     if(mimeType == "audio/mpeg"_L1 || mimeType == "audio/mpeg3"_L1 || mimeType == "audio/x-mpeg"_L1) {
 #if (TAGLIB_MAJOR_VERSION >= 2)
-        TagLib::MPEG::File file(&stream, true, style, TagLib::ID3v2::FrameFactory::instance());
+        TagLib::MPEG::File file(&stream, readAudioProps, style, TagLib::ID3v2::FrameFactory::instance());
 #else
-        TagLib::MPEG::File file(&stream, TagLib::ID3v2::FrameFactory::instance(), true, style);
+        TagLib::MPEG::File file(&stream, TagLib::ID3v2::FrameFactory::instance(), readAudioProps, style);
 #endif
         if(file.isValid()) {
             readProperties(file);
-            checkXingHeader(&file, track);
+            if(readAudioProps) {
+                checkXingHeader(&file, track);
+            }
             track.setEncoding(u"Lossy"_s);
 
             QStringList types;
@@ -2308,14 +2395,12 @@ bool TagLibReader::readTrack(const AudioSource& source, Track& track)
         }
     }
     else if(mimeType == "audio/x-aiff"_L1 || mimeType == "audio/x-aifc"_L1) {
-        const TagLib::RIFF::AIFF::File file(&stream, true, style);
+        const TagLib::RIFF::AIFF::File file(&stream, readAudioProps, style);
         if(file.isValid()) {
             readProperties(file);
             track.setEncoding(u"Lossless"_s);
 
-            if(const int bps = file.audioProperties()->bitsPerSample(); bps > 0) {
-                track.setBitDepth(bps);
-            }
+            readBitDepth(file, track);
             if(file.hasID3v2Tag()) {
                 const auto* id3Tag = file.tag();
                 readId3Tags(id3Tag, track);
@@ -2324,14 +2409,12 @@ bool TagLibReader::readTrack(const AudioSource& source, Track& track)
         }
     }
     else if(mimeType == "audio/vnd.wave"_L1 || mimeType == "audio/wav"_L1 || mimeType == "audio/x-wav"_L1) {
-        const TagLib::RIFF::WAV::File file(&stream, true, style);
+        const TagLib::RIFF::WAV::File file(&stream, readAudioProps, style);
         if(file.isValid()) {
             readProperties(file);
             track.setEncoding(u"Lossless"_s);
 
-            if(const int bps = file.audioProperties()->bitsPerSample(); bps > 0) {
-                track.setBitDepth(bps);
-            }
+            readBitDepth(file, track);
             if(file.hasID3v2Tag()) {
                 const auto* id3Tag = file.ID3v2Tag();
                 readId3Tags(id3Tag, track);
@@ -2340,7 +2423,7 @@ bool TagLibReader::readTrack(const AudioSource& source, Track& track)
         }
     }
     else if(mimeType == "audio/x-musepack"_L1) {
-        TagLib::MPC::File file(&stream, true, style);
+        TagLib::MPC::File file(&stream, readAudioProps, style);
         if(file.isValid()) {
             readProperties(file);
             track.setEncoding(u"Lossy"_s);
@@ -2360,14 +2443,12 @@ bool TagLibReader::readTrack(const AudioSource& source, Track& track)
         }
     }
     else if(mimeType == "audio/x-ape"_L1) {
-        TagLib::APE::File file(&stream, true, style);
+        TagLib::APE::File file(&stream, readAudioProps, style);
         if(file.isValid()) {
             readProperties(file);
             track.setEncoding(u"Lossless"_s);
 
-            if(const int bps = file.audioProperties()->bitsPerSample(); bps > 0) {
-                track.setBitDepth(bps);
-            }
+            readBitDepth(file, track);
 
             QStringList types;
 
@@ -2385,15 +2466,15 @@ bool TagLibReader::readTrack(const AudioSource& source, Track& track)
         }
     }
     else if(mimeType == "audio/x-wavpack"_L1) {
-        TagLib::WavPack::File file(&stream, true, style);
+        TagLib::WavPack::File file(&stream, readAudioProps, style);
         if(file.isValid()) {
             readProperties(file);
 
-            if(const int bps = file.audioProperties()->bitsPerSample(); bps > 0) {
-                track.setBitDepth(bps);
-            }
+            readBitDepth(file, track);
 
-            track.setEncoding(file.audioProperties()->isLossless() ? u"Lossless"_s : u"Lossy"_s);
+            if(const auto* props = file.audioProperties()) {
+                track.setEncoding(props->isLossless() ? u"Lossless"_s : u"Lossy"_s);
+            }
 
             QStringList types;
 
@@ -2409,26 +2490,25 @@ bool TagLibReader::readTrack(const AudioSource& source, Track& track)
         }
     }
     else if(mimeType == "audio/mp4"_L1 || mimeType == "video/mp4"_L1 || mimeType == "audio/vnd.audible.aax"_L1) {
-        const TagLib::MP4::File file(&stream, true, style);
+        const TagLib::MP4::File file(&stream, readAudioProps, style);
         if(file.isValid()) {
             readProperties(file);
 
-            if(const int bps = file.audioProperties()->bitsPerSample(); bps > 0) {
-                track.setBitDepth(bps);
-            }
-
-            const auto codec = file.audioProperties()->codec();
-            switch(codec) {
-                case(TagLib::MP4::Properties::AAC):
-                    track.setCodec(u"AAC"_s);
-                    track.setEncoding(u"Lossy"_s);
-                    break;
-                case(TagLib::MP4::Properties::ALAC):
-                    track.setCodec(u"ALAC"_s);
-                    track.setEncoding(u"Lossless"_s);
-                    break;
-                case(TagLib::MP4::Properties::Unknown):
-                    break;
+            readBitDepth(file, track);
+
+            if(const auto* props = file.audioProperties()) {
+                switch(props->codec()) {
+                    case(TagLib::MP4::Properties::AAC):
+                        track.setCodec(u"AAC"_s);
+                        track.setEncoding(u"Lossy"_s);
+                        break;
+                    case(TagLib::MP4::Properties::ALAC):
+                        track.setCodec(u"ALAC"_s);
+                        track.setEncoding(u"Lossless"_s);
+                        break;
+                    case(TagLib::MP4::Properties::Unknown):
+                        break;
+                }
             }
 
             if(file.hasMP4Tag()) {
@@ -2438,17 +2518,15 @@ bool TagLibReader::readTrack(const AudioSource& source, Track& track)
     }
     else if(mimeType == "audio/flac"_L1 || mimeType == "audio/x-flac"_L1) {
 #if (TAGLIB_MAJOR_VERSION >= 2)
-        TagLib::FLAC::File file(&stream, true, style, TagLib::ID3v2::FrameFactory::instance());
+        TagLib::FLAC::File file(&stream, readAudioProps, style, TagLib::ID3v2::FrameFactory::instance());
 #else
-        TagLib::FLAC::File file(&stream, TagLib::ID3v2::FrameFactory::instance(), true, style);
+        TagLib::FLAC::File file(&stream, TagLib::ID3v2::FrameFactory::instance(), readAudioProps, style);
 #endif
         if(file.isValid()) {
             readProperties(file);
             track.setEncoding(u"Lossless"_s);
 
-            if(const int bps = file.audioProperties()->bitsPerSample(); bps > 0) {
-                track.setBitDepth(bps);
-            }
+            readBitDepth(file, track);
             if(file.hasXiphComment()) {
                 readXiphComment(file.xiphComment(), track);
                 track.setTagTypes({u"XiphComment"_s});
@@ -2457,7 +2535,7 @@ bool TagLibReader::readTrack(const AudioSource& source, Track& track)
     }
     else if(mimeType == "audio/ogg"_L1 || mimeType == "audio/x-vorbis+ogg"_L1 || mimeType == "audio/vorbis"_L1
             || mimeType == "application/ogg"_L1) {
-        const TagLib::Ogg::Vorbis::File file(&stream, true, style);
+        const TagLib::Ogg::Vorbis::File file(&stream, readAudioProps, style);
         if(file.isValid()) {
             readProperties(file);
             track.setEncoding(u"Lossy"_s);
@@ -2469,7 +2547,7 @@ bool TagLibReader::readTrack(const AudioSource& source, Track& track)
         }
     }
     else if(mimeType == "audio/opus"_L1 || mimeType == "audio/x-opus+ogg"_L1) {
-        const TagLib::Ogg::Opus::File file(&stream, true, style);
+        const TagLib::Ogg::Opus::File file(&stream, readAudioProps, style);
         if(file.isValid()) {
             readProperties(file);
             track.setEncoding(u"Lossy"_s);
@@ -2482,34 +2560,34 @@ bool TagLibReader::readTrack(const AudioSource& source, Track& track)
     }
     else if(mimeType == "audio/x-ms-wma"_L1 || mimeType == "video/x-ms-asf"_L1
             || mimeType == "application/vnd.ms-asf"_L1) {
-        const TagLib::ASF::File file(&stream, true, style);
+        const TagLib::ASF::File file(&stream, readAudioProps, style);
         if(file.isValid()) {
             readProperties(file);
 
-            switch(file.audioProperties()->codec()) {
-                case(TagLib::ASF::Properties::WMA1):
-                    track.setCodecProfile(u"V1"_s);
-                    track.setEncoding(u"Lossy"_s);
-                    break;
-                case(TagLib::ASF::Properties::WMA2):
-                    track.setCodecProfile(u"V2"_s);
-                    track.setEncoding(u"Lossy"_s);
-                    break;
-                case(TagLib::ASF::Properties::WMA9Pro):
-                    track.setCodecProfile(u"V9"_s);
-                    track.setEncoding(u"Lossy"_s);
-                    break;
-                case(TagLib::ASF::Properties::WMA9Lossless):
-                    track.setCodecProfile(u"V9"_s);
-                    track.setEncoding(u"Lossless"_s);
-                    break;
-                default:
-                    break;
-            }
-
-            if(const int bps = file.audioProperties()->bitsPerSample(); bps > 0) {
-                track.setBitDepth(bps);
+            if(const auto* props = file.audioProperties()) {
+                switch(props->codec()) {
+                    case(TagLib::ASF::Properties::WMA1):
+                        track.setCodecProfile(u"V1"_s);
+                        track.setEncoding(u"Lossy"_s);
+                        break;
+                    case(TagLib::ASF::Properties::WMA2):
+                        track.setCodecProfile(u"V2"_s);
+                        track.setEncoding(u"Lossy"_s);
+                        break;
+                    case(TagLib::ASF::Properties::WMA9Pro):
+                        track.setCodecProfile(u"V9"_s);
+                        track.setEncoding(u"Lossy"_s);
+                        break;
+                    case(TagLib::ASF::Properties::WMA9Lossless):
+                        track.setCodecProfile(u"V9"_s);
+                        track.setEncoding(u"Lossless"_s);
+                        break;
+                    default:
+                        break;
+                }
             }
+
+            readBitDepth(file, track);
             if(file.tag()) {
                 readAsfTags(file.tag(), track);
             }
@@ -2517,14 +2595,12 @@ bool TagLibReader::readTrack(const AudioSource& source, Track& track)
     }
 #if (TAGLIB_MAJOR_VERSION >= 2)
     else if(mimeType == "audio/x-dsf"_L1) {
-        const TagLib::DSF::File file(&stream, true, style);
+        const TagLib::DSF::File file(&stream, readAudioProps, style);
         if(file.isValid()) {
             readProperties(file);
             track.setEncoding(u"Lossless"_s);
 
-            if(const int bps = file.audioProperties()->bitsPerSample(); bps > 0) {
-                track.setBitDepth(bps);
-            }
+            readBitDepth(file, track);
 
             if(file.tag()) {
                 readId3Tags(file.tag(), track);
@@ -2533,14 +2609,12 @@ bool TagLibReader::readTrack(const AudioSource& source, Track& track)
         }
     }
     else if(mimeType == "audio/x-dff"_L1) {
-        const TagLib::DSDIFF::File file(&stream, true, style);
+        const TagLib::DSDIFF::File file(&stream, readAudioProps, style);
         if(file.isValid()) {
             readProperties(file);
             track.setEncoding(u"Lossless"_s);
 
-            if(const int bps = file.audioProperties()->bitsPerSample(); bps > 0) {
-                track.setBitDepth(bps);
-            }
+            readBitDepth(file, track);
             if(file.hasID3v2Tag()) {
                 readId3Tags(file.ID3v2Tag(), track);
                 track.setTagTypes({u"ID3v2.%1"_s.arg(file.ID3v2Tag()->header()->majorVersion())});
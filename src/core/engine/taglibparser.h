@@ -31,10 +31,15 @@ public:
     [[nodiscard]] bool canReadCover() const override;
     [[nodiscard]] bool canWriteMetaData() const override;
 
+    bool setReadOptions(ReadOptions options) override;
+
     [[nodiscard]] bool readTrack(const AudioSource& source, Track& track) override;
     [[nodiscard]] QByteArray readCover(const AudioSource& source, const Track& track, Track::Cover cover) override;
     [[nodiscard]] bool writeTrack(const AudioSource& source, const Track& track, WriteOptions options) override;
     [[nodiscard]] bool writeCover(const AudioSource& source, const Track& track, const TrackCovers& covers,
                                   WriteOptions options) override;
+
+private:
+    ReadOptions m_readOptions;
 };
 } // namespace Fooyin
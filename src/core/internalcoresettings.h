@@ -83,6 +83,8 @@ constexpr auto LibraryRestrictTypes    = "Library/RestrictTypes";
 constexpr auto LibraryExcludeTypes     = "Library/ExcludeTypes";
 constexpr auto ExternalRestrictTypes   = "Library/ExternalRestrictTypes";
 constexpr auto ExternalExcludeTypes    = "Library/ExternalExcludeTypes";
+constexpr auto LibraryScanThreads      = "Library/ScanThreads";
+constexpr auto LibraryDeferProperties  = "Library/DeferAudioProperties";
 constexpr auto FFmpegAllExtensions     = "Engine/FFmpegAllExtensions";
 
 enum CoreInternalSettings : uint32_t
@@ -0,0 +1,158 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cuesheetindex.h"
+
+#include <core/playlist/playlistparser.h>
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+
+using namespace Qt::StringLiterals;
+
+namespace {
+QString baseNameKey(const QString& dir, const QString& baseName)
+{
+    return dir + u'/' + baseName.toLower();
+}
+
+QString parseFileEntry(QStringView line)
+{
+    line = line.sliced(4).trimmed();
+    if(line.isEmpty()) {
+        return {};
+    }
+
+    if(line.front() == u'"') {
+        const auto end = line.indexOf(u'"', 1);
+        return end > 1 ? line.sliced(1, end - 1).toString() : QString{};
+    }
+
+    // Unquoted: FILE name.flac WAVE
+    const auto end = line.lastIndexOf(u' ');
+    return (end > 0 ? line.first(end) : line).trimmed().toString();
+}
+
+QStringList readFileReferences(const QString& cuePath)
+{
+    QFile file{cuePath};
+    if(!file.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+
+    const QDir dir         = QFileInfo{cuePath}.absoluteDir();
+    const QString contents = QString::fromUtf8(Fooyin::PlaylistParser::toUtf8(&file));
+    const auto lines       = QStringView{contents}.split(u'\n', Qt::SkipEmptyParts);
+
+    QStringList files;
+
+    for(const QStringView rawLine : lines) {
+        const QStringView line = rawLine.trimmed();
+        if(line.size() <= 5 || !line.startsWith("FILE"_L1, Qt::CaseInsensitive) || !line.at(4).isSpace()) {
+            continue;
+        }
+
+        const QString entry = parseFileEntry(line);
+        if(entry.isEmpty()) {
+            continue;
+        }
+
+        files.append(QDir::cleanPath(QDir::isAbsolutePath(entry) ? entry : dir.absoluteFilePath(entry)));
+    }
+
+    return files;
+}
+} // namespace
+
+namespace Fooyin {
+void CueSheetIndex::addReference(const QString& cue, const QString& filepath)
+{
+    m_referencedFiles.emplace(filepath, cue);
+}
+
+void CueSheetIndex::addCueSheets(const QString& dir, const QStringList& cues)
+{
+    m_directories.insert_or_assign(dir, cues);
+
+    for(const QString& cue : cues) {
+        const QStringList files = readFileReferences(cue);
+        for(const QString& file : files) {
+            const QFileInfo info{file};
+            m_referencedFiles.emplace(file, cue);
+            // The cue parser falls back to a file with the same name if the referenced one doesn't exist
+            m_referencedBaseNames.emplace(baseNameKey(info.path(), info.completeBaseName()), cue);
+        }
+    }
+}
+
+std::optional<QString> CueSheetIndex::cueForFile(const QString& filepath)
+{
+    const QFileInfo info{filepath};
+    const QString dir = info.absolutePath();
+
+    if(!m_directories.contains(dir)) {
+        static const QStringList cueExtensions{u"*.cue"_s};
+
+        QStringList cues;
+        const QDir cueDir{dir};
+        const QStringList entries = cueDir.entryList(cueExtensions, QDir::Files);
+        for(const QString& entry : entries) {
+            cues.append(cueDir.absoluteFilePath(entry));
+        }
+        addCueSheets(dir, cues);
+    }
+
+    if(const auto fileIt = m_referencedFiles.find(info.absoluteFilePath()); fileIt != m_referencedFiles.cend()) {
+        return fileIt->second;
+    }
+    if(const auto nameIt = m_referencedBaseNames.find(baseNameKey(dir, info.completeBaseName()));
+       nameIt != m_referencedBaseNames.cend()) {
+        return nameIt->second;
+    }
+
+    // Cue sheets which couldn't be read, or which reference other files
+    const QStringList& cues = m_directories.at(dir);
+    for(const QString& cue : cues) {
+        const QFileInfo cueInfo{cue};
+        if(cueInfo.completeBaseName() == info.completeBaseName() || cueInfo.fileName().contains(info.fileName())) {
+            return cue;
+        }
+    }
+
+    return {};
+}
+
+bool CueSheetIndex::isReferenced(const QString& filepath) const
+{
+    if(m_referencedFiles.contains(filepath)) {
+        return true;
+    }
+
+    const QFileInfo info{filepath};
+    return m_referencedBaseNames.contains(baseNameKey(info.path(), info.completeBaseName()));
+}
+
+void CueSheetIndex::clear()
+{
+    m_directories.clear();
+    m_referencedFiles.clear();
+    m_referencedBaseNames.clear();
+}
+} // namespace Fooyin
@@ -0,0 +1,67 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <QStringList>
+
+#include <optional>
+#include <unordered_map>
+
+namespace Fooyin {
+/*!
+ * Index of the cue sheets found during a scan, and the audio files they reference.
+ *
+ * Library scans add the files of the tracks built from each cue sheet using addReference,
+ * so a cue sheet is only parsed once, by the scanner, and its files are then skipped.
+ * Otherwise cueForFile lists each directory, and reads each cue sheet for its FILE entries, at most once.
+ */
+class CueSheetIndex
+{
+public:
+    /*!
+     * Marks @p filepath as read as part of @p cue.
+     */
+    void addReference(const QString& cue, const QString& filepath);
+
+    /*!
+     * Returns the cue sheet for the audio file at @p filepath, listing its directory if
+     * it hasn't been indexed yet. A cue sheet which references the file is preferred,
+     * followed by one with a matching name.
+     */
+    [[nodiscard]] std::optional<QString> cueForFile(const QString& filepath);
+
+    /*!
+     * Returns true if @p filepath is referenced by a cue sheet already in the index.
+     */
+    [[nodiscard]] bool isReferenced(const QString& filepath) const;
+
+    void clear();
+
+private:
+    void addCueSheets(const QString& dir, const QStringList& cues);
+
+    // Directory -> cue sheets
+    std::unordered_map<QString, QStringList> m_directories;
+    // Referenced file path -> cue sheet
+    std::unordered_map<QString, QString> m_referencedFiles;
+    // Directory and lowercase base name of referenced files -> cue sheet
+    std::unordered_map<QString, QString> m_referencedBaseNames;
+};
+} // namespace Fooyin
@@ -0,0 +1,182 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "databasemaintenance.h"
+
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QLoggingCategory>
+
+Q_LOGGING_CATEGORY(DB_MAINT, "fy.dbmaintenance")
+
+using namespace Qt::StringLiterals;
+
+// Time spent on each call to runMaintenance
+constexpr auto StepBudget = 50;
+// Pages freed by each incremental vacuum
+constexpr auto VacuumPages = 128;
+// Free pages needed before vacuuming
+constexpr auto MinFreePages = 256;
+// Rows changed in Tracks or TrackStats before the database is analysed again
+constexpr auto AnalyseChurn = 1000;
+// Rows of each index read by ANALYZE
+constexpr auto AnalysisLimit = 1000;
+constexpr auto StatsCleanupInterval = 24LL * 60 * 60 * 1000;
+
+constexpr auto AnalysedRevisionKey = "MaintenanceRevision";
+constexpr auto StatsCleanupKey     = "StatsCleanupTime";
+
+namespace Fooyin {
+QString DbMaintenanceReport::report() const
+{
+    using Ms = std::chrono::duration<double, std::milli>;
+
+    return u"Database maintenance ran %1 steps in %2 ms: %3 pages reclaimed, %4 tables analysed, stats %5"_s.arg(steps)
+        .arg(Ms{time}.count(), 0, 'f', 1)
+        .arg(pagesReclaimed)
+        .arg(tablesAnalysed)
+        .arg(statsCleaned ? u"cleaned"_s : u"not cleaned"_s);
+}
+
+DatabaseMaintenance::DatabaseMaintenance(DbConnectionPoolPtr dbPool, QObject* parent)
+    : Worker{parent}
+    , m_dbPool{std::move(dbPool)}
+{ }
+
+void DatabaseMaintenance::initialiseThread()
+{
+    Worker::initialiseThread();
+
+    m_dbHandler = std::make_unique<DbConnectionHandler>(m_dbPool);
+
+    const DbConnectionProvider dbProvider{m_dbPool};
+    m_generalDatabase.initialise(dbProvider);
+    m_settingsDatabase.initialise(dbProvider);
+    m_trackDatabase.initialise(dbProvider);
+}
+
+void DatabaseMaintenance::runMaintenance()
+{
+    setState(Running);
+
+    if(m_steps.empty()) {
+        planPass();
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    while(!m_steps.empty() && mayRun() && timer.elapsed() < StepBudget) {
+        if(runStep(m_steps.front())) {
+            m_steps.pop_front();
+        }
+        ++m_report.steps;
+    }
+
+    m_report.time += std::chrono::nanoseconds{timer.nsecsElapsed()};
+
+    if(m_steps.empty()) {
+        finishPass();
+    }
+
+    setState(Idle);
+    emit maintenanceRan(!m_steps.empty());
+}
+
+void DatabaseMaintenance::planPass()
+{
+    m_report         = {};
+    m_startPageCount = m_generalDatabase.pageCount();
+
+    const auto lastCleanup
+        = m_settingsDatabase.value(QString::fromLatin1(StatsCleanupKey), u"0"_s).toLongLong();
+    if(QDateTime::currentMSecsSinceEpoch() - lastCleanup >= StatsCleanupInterval) {
+        m_steps.push_back(Step::MarkStats);
+        m_steps.push_back(Step::DeleteExpiredStats);
+    }
+
+    // The library revision is bumped by the number of rows changed
+    const int64_t revision = m_trackDatabase.libraryRevision();
+    const auto analysedRevision
+        = m_settingsDatabase.value(QString::fromLatin1(AnalysedRevisionKey), u"-1"_s).toLongLong();
+    if(revision >= 0 && (analysedRevision < 0 || revision - analysedRevision >= AnalyseChurn)) {
+        m_tablesToAnalyse = m_generalDatabase.tables();
+        if(!m_tablesToAnalyse.empty()) {
+            m_steps.push_back(Step::Analyse);
+        }
+    }
+
+    // Last, as cleaning up stats may free more pages
+    const int freePages = m_generalDatabase.freePageCount();
+    if(m_generalDatabase.incrementalVacuumEnabled() && freePages >= MinFreePages) {
+        m_steps.push_back(Step::Vacuum);
+    }
+
+    qCDebug(DB_MAINT) << "Planned" << m_steps.size() << "steps with" << freePages << "free pages and"
+                      << (revision - analysedRevision) << "rows changed since last analysed";
+}
+
+bool DatabaseMaintenance::runStep(Step step)
+{
+    switch(step) {
+        case(Step::MarkStats):
+            m_trackDatabase.updateLastSeenStats();
+            return true;
+        case(Step::DeleteExpiredStats):
+            m_trackDatabase.deleteExpiredStats();
+            m_settingsDatabase.set(QString::fromLatin1(StatsCleanupKey), QDateTime::currentMSecsSinceEpoch());
+            m_report.statsCleaned = true;
+            return true;
+        case(Step::Analyse): {
+            const QString table = m_tablesToAnalyse.takeFirst();
+            if(m_generalDatabase.analyseTable(table, AnalysisLimit)) {
+                ++m_report.tablesAnalysed;
+            }
+            if(m_tablesToAnalyse.empty()) {
+                m_settingsDatabase.set(QString::fromLatin1(AnalysedRevisionKey),
+                                       QVariant::fromValue(m_trackDatabase.libraryRevision()));
+                return true;
+            }
+            return false;
+        }
+        case(Step::Vacuum):
+            if(!m_generalDatabase.incrementalVacuum(VacuumPages)) {
+                qCWarning(DB_MAINT) << "Incremental vacuum failed";
+                return true;
+            }
+            return m_generalDatabase.freePageCount() <= 0;
+    }
+
+    return true;
+}
+
+void DatabaseMaintenance::finishPass()
+{
+    if(m_report.steps == 0) {
+        return;
+    }
+
+    m_report.pagesReclaimed = m_startPageCount - m_generalDatabase.pageCount();
+    qCInfo(DB_MAINT).noquote() << m_report.report();
+
+    m_report = {};
+}
+} // namespace Fooyin
+
+#include "moc_databasemaintenance.cpp"
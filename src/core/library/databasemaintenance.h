@@ -0,0 +1,99 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "database/generaldatabase.h"
+#include "database/settingsdatabase.h"
+#include "database/trackdatabase.h"
+
+#include <utils/database/dbconnectionhandler.h>
+#include <utils/worker.h>
+
+#include <QString>
+
+#include <chrono>
+#include <deque>
+
+namespace Fooyin {
+/*!
+ * Work done by a single pass of DatabaseMaintenance.
+ */
+struct DbMaintenanceReport
+{
+    using Duration = std::chrono::nanoseconds;
+
+    // Time spent running steps, excluding the gaps between them
+    Duration time{0};
+    int steps{0};
+    int pagesReclaimed{0};
+    int tablesAnalysed{0};
+    bool statsCleaned{false};
+
+    [[nodiscard]] QString report() const;
+};
+
+/*!
+ * Keeps the library database in shape while fooyin is otherwise idle.
+ * Each pass is planned from the free page count, the rows changed since the last ANALYZE and the
+ * time since stats were last cleaned up, then run as a series of short steps so the database is
+ * never locked for long.
+ */
+class DatabaseMaintenance : public Worker
+{
+    Q_OBJECT
+
+public:
+    explicit DatabaseMaintenance(DbConnectionPoolPtr dbPool, QObject* parent = nullptr);
+
+    void initialiseThread() override;
+
+signals:
+    /** Emitted after each call to runMaintenance; @p morePending if the current pass isn't complete. */
+    void maintenanceRan(bool morePending);
+
+public slots:
+    /** Runs steps of the current pass (planning a new one if needed) until the time budget is spent. */
+    void runMaintenance();
+
+private:
+    enum class Step : uint8_t
+    {
+        MarkStats,
+        DeleteExpiredStats,
+        Analyse,
+        Vacuum,
+    };
+
+    void planPass();
+    bool runStep(Step step);
+    void finishPass();
+
+    DbConnectionPoolPtr m_dbPool;
+    std::unique_ptr<DbConnectionHandler> m_dbHandler;
+    GeneralDatabase m_generalDatabase;
+    SettingsDatabase m_settingsDatabase;
+    TrackDatabase m_trackDatabase;
+
+    std::deque<Step> m_steps;
+    QStringList m_tablesToAnalyse;
+    int m_startPageCount{0};
+    DbMaintenanceReport m_report;
+};
+} // namespace Fooyin
@@ -0,0 +1,379 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "directoryenumerator.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QLoggingCategory>
+
+#ifdef Q_OS_UNIX
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+
+Q_LOGGING_CATEGORY(DIR_ENUM, "fy.direnum")
+
+namespace {
+QChar asciiLower(QChar ch)
+{
+    return ch >= u'A' && ch <= u'Z' ? QChar{ch.unicode() + 32} : ch;
+}
+
+char asciiLower(char ch)
+{
+    return ch >= 'A' && ch <= 'Z' ? static_cast<char>(ch + 32) : ch;
+}
+
+std::vector<QByteArray> toExtensionList(const QStringList& extensions)
+{
+    std::vector<QByteArray> extensionList;
+
+    for(const QString& extension : extensions) {
+        QByteArray ext = extension.toUtf8();
+        std::ranges::transform(ext, ext.begin(), [](char ch) { return asciiLower(ch); });
+        if(!ext.isEmpty() && std::ranges::find(extensionList, ext) == extensionList.cend()) {
+            extensionList.push_back(ext);
+        }
+    }
+
+    return extensionList;
+}
+
+void sortDirectoryFiles(QStringList& files)
+{
+    std::ranges::sort(files);
+    std::ranges::stable_partition(files, Fooyin::DirectoryEnumerator::isCueFile);
+}
+
+#ifdef Q_OS_UNIX
+uint64_t modifiedTime(const struct stat& st)
+{
+#ifdef Q_OS_DARWIN
+    const timespec& time = st.st_mtimespec;
+#else
+    const timespec& time = st.st_mtim;
+#endif
+    return static_cast<uint64_t>(time.tv_sec) * 1000 + static_cast<uint64_t>(time.tv_nsec) / 1000000;
+}
+
+// Closes the directory stream (and its descriptor) on scope exit
+struct DirCloser
+{
+    void operator()(DIR* dir) const
+    {
+        closedir(dir);
+    }
+};
+#else
+uint64_t modifiedTime(const QFileInfo& info)
+{
+    const QDateTime lastModified = info.lastModified();
+    return lastModified.isValid() ? static_cast<uint64_t>(lastModified.toMSecsSinceEpoch()) : 0;
+}
+#endif
+} // namespace
+
+namespace Fooyin {
+DirectoryEnumerator::DirectoryEnumerator(const QStringList& extensions)
+    : m_previousManifest{nullptr}
+    , m_manifest{nullptr}
+    , m_directoryCount{0}
+    , m_skippedCount{0}
+{
+    m_extensions = toExtensionList(extensions);
+}
+
+void DirectoryEnumerator::setManifest(const DirectoryManifest* previousManifest, DirectoryManifest* manifest)
+{
+    m_previousManifest = previousManifest;
+    m_manifest         = manifest;
+}
+
+void DirectoryEnumerator::setPresenceHandler(const QStringList& extensions, PresenceHandler handler)
+{
+    m_presenceExtensions = toExtensionList(extensions);
+    m_presenceHandler    = std::move(handler);
+}
+
+bool DirectoryEnumerator::enumerate(const QString& path, const FilesHandler& handler)
+{
+    const QFileInfo root{path};
+
+    if(!root.isDir()) {
+        if(root.isFile()) {
+            const QByteArray name = QFile::encodeName(root.fileName());
+            const auto length     = static_cast<size_t>(name.size());
+            const bool isScanned  = matchesExtension(m_extensions, name.constData(), length);
+
+            if(m_presenceHandler && (isScanned || matchesExtension(m_presenceExtensions, name.constData(), length))) {
+                m_presenceHandler(root.absoluteFilePath());
+            }
+            if(isScanned && root.size() > 0) {
+                return handler(root.absolutePath(), {root.absoluteFilePath()});
+            }
+        }
+        return true;
+    }
+
+    // Depth-first, so only the directories still to visit are held in memory
+    std::vector<QString> pending{QDir::cleanPath(root.absoluteFilePath())};
+
+    while(!pending.empty()) {
+        const QString dirPath = pending.back();
+        pending.pop_back();
+
+        DirectoryListing listing;
+        if(!readDirectory(dirPath, listing)) {
+            continue;
+        }
+
+        ++m_directoryCount;
+
+        std::ranges::sort(listing.dirs, std::greater{});
+        for(const QString& dir : listing.dirs) {
+            pending.push_back(dirPath + u'/' + dir);
+        }
+
+        if(listing.unchanged) {
+            ++m_skippedCount;
+            if(m_manifest) {
+                m_manifest->insert_or_assign(dirPath, m_previousManifest->at(dirPath));
+            }
+            continue;
+        }
+
+        if(m_manifest) {
+            m_manifest->insert_or_assign(dirPath, listing.fingerprint);
+        }
+
+        if(listing.files.empty()) {
+            continue;
+        }
+
+        sortDirectoryFiles(listing.files);
+        for(QString& file : listing.files) {
+            file.prepend(dirPath + u'/');
+        }
+
+        if(!handler(dirPath, listing.files)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int DirectoryEnumerator::directoryCount() const
+{
+    return m_directoryCount;
+}
+
+int DirectoryEnumerator::skippedDirectoryCount() const
+{
+    return m_skippedCount;
+}
+
+bool DirectoryEnumerator::isCueFile(const QString& filepath)
+{
+    if(filepath.size() < 4 || filepath.at(filepath.size() - 4) != u'.') {
+        return false;
+    }
+    return asciiLower(filepath.at(filepath.size() - 3)) == u'c' && asciiLower(filepath.at(filepath.size() - 2)) == u'u'
+        && asciiLower(filepath.at(filepath.size() - 1)) == u'e';
+}
+
+bool DirectoryEnumerator::matchesExtension(const std::vector<QByteArray>& extensions, const char* name, size_t length)
+{
+    size_t dot{length};
+    while(dot > 0 && name[dot - 1] != '.') {
+        --dot;
+    }
+    if(dot <= 1) {
+        return false;
+    }
+
+    const char* suffix       = name + dot;
+    const auto suffixLength  = static_cast<qsizetype>(length - dot);
+    const auto matchesSuffix = [suffix, suffixLength](const QByteArray& ext) {
+        if(ext.size() != suffixLength) {
+            return false;
+        }
+        for(qsizetype i{0}; i < suffixLength; ++i) {
+            if(asciiLower(suffix[i]) != ext.at(i)) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    return std::ranges::any_of(extensions, matchesSuffix);
+}
+
+#ifdef Q_OS_UNIX
+bool DirectoryEnumerator::readDirectory(const QString& path, DirectoryListing& listing)
+{
+    const int dirFd = open(QFile::encodeName(path).constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if(dirFd < 0) {
+        qCDebug(DIR_ENUM) << "Failed to open directory" << path << ":" << std::strerror(errno);
+        return false;
+    }
+
+    const std::unique_ptr<DIR, DirCloser> dir{fdopendir(dirFd)};
+    if(!dir) {
+        close(dirFd);
+        return false;
+    }
+
+    struct stat dirStat{};
+    if(fstat(dirFd, &dirStat) != 0) {
+        return false;
+    }
+
+    // Guard against symlink loops and directories reachable from more than one root
+    if(!m_visitedDirs.emplace(static_cast<uint64_t>(dirStat.st_dev), static_cast<uint64_t>(dirStat.st_ino)).second) {
+        return false;
+    }
+
+    listing.fingerprint.modifiedTime = modifiedTime(dirStat);
+
+    std::vector<QByteArray> fileNames;
+
+    while(const dirent* entry = readdir(dir.get())) {
+        const char* name = entry->d_name;
+        // Hidden entries, '.' and '..'
+        if(name[0] == '.') {
+            continue;
+        }
+
+        const size_t length = std::strlen(name);
+
+        bool isDir{entry->d_type == DT_DIR};
+        bool isFile{entry->d_type == DT_REG};
+
+        if(entry->d_type == DT_LNK || entry->d_type == DT_UNKNOWN) {
+            // Resolve symlinks, and entries on filesystems that do not report a type
+            struct stat entryStat{};
+            if(fstatat(dirFd, name, &entryStat, 0) != 0) {
+                continue;
+            }
+            isDir  = S_ISDIR(entryStat.st_mode);
+            isFile = S_ISREG(entryStat.st_mode);
+        }
+
+        if(isDir) {
+            listing.dirs.append(QFile::decodeName(QByteArray{name, static_cast<qsizetype>(length)}));
+        }
+        else if(isFile) {
+            if(matchesExtension(m_extensions, name, length)) {
+                fileNames.emplace_back(name, static_cast<qsizetype>(length));
+                if(m_presenceHandler) {
+                    m_presenceHandler(path + u'/' + QFile::decodeName(fileNames.back()));
+                }
+            }
+            else if(m_presenceHandler && matchesExtension(m_presenceExtensions, name, length)) {
+                m_presenceHandler(path + u'/' + QFile::decodeName(QByteArray{name, static_cast<qsizetype>(length)}));
+            }
+        }
+    }
+
+    listing.fingerprint.entryCount = static_cast<int>(fileNames.size());
+    listing.files.reserve(static_cast<qsizetype>(fileNames.size()));
+
+    for(const QByteArray& name : fileNames) {
+        struct stat fileStat{};
+        if(fstatat(dirFd, name.constData(), &fileStat, 0) != 0 || fileStat.st_size <= 0) {
+            continue;
+        }
+        listing.fingerprint.maxModifiedTime = std::max(listing.fingerprint.maxModifiedTime, modifiedTime(fileStat));
+        listing.files.append(QFile::decodeName(name));
+    }
+
+    if(m_previousManifest) {
+        const auto prevIt = m_previousManifest->find(path);
+        if(prevIt != m_previousManifest->cend() && prevIt->second.isSameAs(listing.fingerprint)) {
+            // No entries have been added, removed, renamed or rewritten since the last scan
+            listing.files.clear();
+            listing.unchanged = true;
+        }
+    }
+
+    return true;
+}
+#else
+bool DirectoryEnumerator::readDirectory(const QString& path, DirectoryListing& listing)
+{
+    const QDir dir{path};
+    if(!dir.exists()) {
+        return false;
+    }
+
+    if(!m_visitedDirs.emplace(QFileInfo{path}.canonicalFilePath()).second) {
+        return false;
+    }
+
+    listing.fingerprint.modifiedTime = modifiedTime(QFileInfo{path});
+    listing.dirs                     = dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+
+    QStringList fileNames;
+    const QStringList entries = dir.entryList(QDir::Files);
+    for(const QString& entry : entries) {
+        const QByteArray name = QFile::encodeName(entry);
+        const auto length     = static_cast<size_t>(name.size());
+
+        if(matchesExtension(m_extensions, name.constData(), length)) {
+            fileNames.append(entry);
+            if(m_presenceHandler) {
+                m_presenceHandler(dir.filePath(entry));
+            }
+        }
+        else if(m_presenceHandler && matchesExtension(m_presenceExtensions, name.constData(), length)) {
+            m_presenceHandler(dir.filePath(entry));
+        }
+    }
+
+    listing.fingerprint.entryCount = static_cast<int>(fileNames.size());
+
+    for(const QString& fileName : fileNames) {
+        const QFileInfo info{dir.filePath(fileName)};
+        if(info.size() > 0) {
+            listing.fingerprint.maxModifiedTime = std::max(listing.fingerprint.maxModifiedTime, modifiedTime(info));
+            listing.files.append(fileName);
+        }
+    }
+
+    if(m_previousManifest) {
+        const auto prevIt = m_previousManifest->find(path);
+        if(prevIt != m_previousManifest->cend() && prevIt->second.isSameAs(listing.fingerprint)) {
+            listing.files.clear();
+            listing.unchanged = true;
+        }
+    }
+
+    return true;
+}
+#endif
+} // namespace Fooyin
@@ -0,0 +1,99 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "database/librarydatabase.h"
+
+#include <QStringList>
+
+#include <functional>
+#include <set>
+
+namespace Fooyin {
+/*!
+ * Walks a directory tree one directory at a time, without first collecting the whole tree.
+ * Entries are filtered by extension on their raw names, and the matching files of each
+ * directory are passed on as soon as it has been read, with cue sheets ordered first.
+ *
+ * If a manifest is set, directories whose files are unchanged since it was recorded are not passed on.
+ * Every file found can also be reported through a presence handler, including those in
+ * unchanged directories, so callers can tell which known files still exist without
+ * checking each one.
+ */
+class DirectoryEnumerator
+{
+public:
+    /*!
+     * Called with the sorted files of each directory visited.
+     * Return false to stop enumerating.
+     */
+    using FilesHandler = std::function<bool(const QString& dir, const QStringList& files)>;
+
+    using PresenceHandler = std::function<void(const QString& filepath)>;
+
+    explicit DirectoryEnumerator(const QStringList& extensions);
+
+    void setManifest(const DirectoryManifest* previousManifest, DirectoryManifest* manifest);
+    /*!
+     * Sets a handler called with the path of every file found with one of the scanned
+     * extensions or @p extensions, regardless of whether its directory has changed.
+     */
+    void setPresenceHandler(const QStringList& extensions, PresenceHandler handler);
+
+    /*!
+     * Enumerates @p path recursively, following symlinks.
+     * Directories already visited by this enumerator are skipped.
+     * @returns false if the handler stopped enumeration.
+     */
+    bool enumerate(const QString& path, const FilesHandler& handler);
+
+    [[nodiscard]] int directoryCount() const;
+    [[nodiscard]] int skippedDirectoryCount() const;
+
+    [[nodiscard]] static bool isCueFile(const QString& filepath);
+
+private:
+    struct DirectoryListing
+    {
+        QStringList files;
+        QStringList dirs;
+        DirectoryFingerprint fingerprint;
+        bool unchanged{false};
+    };
+
+    [[nodiscard]] static bool matchesExtension(const std::vector<QByteArray>& extensions, const char* name,
+                                               size_t length);
+    bool readDirectory(const QString& path, DirectoryListing& listing);
+
+    std::vector<QByteArray> m_extensions;
+    std::vector<QByteArray> m_presenceExtensions;
+    PresenceHandler m_presenceHandler;
+    const DirectoryManifest* m_previousManifest;
+    DirectoryManifest* m_manifest;
+
+#ifdef Q_OS_UNIX
+    std::set<std::pair<uint64_t, uint64_t>> m_visitedDirs;
+#else
+    std::set<QString> m_visitedDirs;
+#endif
+    int m_directoryCount;
+    int m_skippedCount;
+};
+} // namespace Fooyin
@@ -19,19 +19,22 @@
 
 #include "libraryscanner.h"
 
+#include "database/librarydatabase.h"
 #include "database/trackdatabase.h"
+#include "cuesheetindex.h"
+#include "directoryenumerator.h"
 #include "internalcoresettings.h"
 #include "librarywatcher.h"
 #include "playlist/playlistloader.h"
 
 #include <core/coresettings.h>
+#include <core/engine/audioloader.h>
 #include <core/library/libraryinfo.h>
 #include <core/playlist/playlist.h>
 #include <core/playlist/playlistparser.h>
 #include <core/track.h>
 #include <utils/database/dbconnectionhandler.h>
 #include <utils/database/dbconnectionpool.h>
-#include <utils/fileutils.h>
 #include <utils/settings/settingsmanager.h>
 #include <utils/timer.h>
 #include <utils/utils.h>
@@ -39,19 +42,94 @@
 #include <QBuffer>
 #include <QDir>
 #include <QDirIterator>
-#include <QFileSystemWatcher>
 #include <QLoggingCategory>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrentMap>
 
+#include <deque>
 #include <ranges>
+#include <unordered_set>
+#include <utility>
 
 Q_LOGGING_CATEGORY(LIB_SCANNER, "fy.scanner")
 
 using namespace Qt::StringLiterals;
 
-constexpr auto BatchSize   = 250;
-constexpr auto ArchivePath = R"(unpack://%1|%2|file://%3!)";
+constexpr auto BatchSize           = 250;
+constexpr auto ReadChunkSize       = 1000;
+constexpr auto PropertiesBatchSize = 100;
+constexpr auto ArchivePath         = R"(unpack://%1|%2|file://%3!)";
 
 namespace {
+using Clock = std::chrono::steady_clock;
+
+// Adds the time until it goes out of scope to a scan stage
+class StageTimer
+{
+public:
+    explicit StageTimer(Fooyin::ScanStats::Duration& stage)
+        : m_stage{stage}
+        , m_start{Clock::now()}
+    { }
+
+    ~StageTimer()
+    {
+        m_stage += Clock::now() - m_start;
+    }
+
+    StageTimer(const StageTimer&)            = delete;
+    StageTimer& operator=(const StageTimer&) = delete;
+    StageTimer(StageTimer&&)                 = delete;
+    StageTimer& operator=(StageTimer&&)      = delete;
+
+private:
+    Fooyin::ScanStats::Duration& m_stage;
+    Clock::time_point m_start;
+};
+
+template <typename Func>
+auto timeStage(Fooyin::ScanStats::Duration& stage, Func&& func)
+{
+    const StageTimer timer{stage};
+    return std::forward<Func>(func)();
+}
+
+// Time spent reading a single file, gathered by the read pool and added to the scan stats in order
+struct FileReadStats
+{
+    QString reader;
+    uint64_t bytes{0};
+    Fooyin::ScanStats::Duration stat{0};
+    Fooyin::ScanStats::Duration tagParse{0};
+    Fooyin::ScanStats::Duration hash{0};
+};
+
+// Result of the read stage of a scan, applied in order by the scanner thread
+struct ScannedFile
+{
+    enum class Type : uint8_t
+    {
+        Skipped = 0,
+        Existing,
+        ExistingArchive,
+        New,
+        NewArchive,
+    };
+
+    QString filepath;
+    Type type{Type::Skipped};
+    Fooyin::TrackList tracks;
+    FileReadStats stats;
+};
+
+// Files being read by the read pool
+struct ReadChunk
+{
+    QStringList files;
+    QFuture<ScannedFile> results;
+};
+
 void sortFiles(QFileInfoList& files)
 {
     std::ranges::sort(files, {}, &QFileInfo::filePath);
@@ -68,28 +146,20 @@ void sortFiles(QFileInfoList& files)
     });
 }
 
-std::optional<QFileInfo> findMatchingCue(const QFileInfo& file)
-{
-    static const QStringList cueExtensions{u"*.cue"_s};
-
-    const QDir dir           = file.absoluteDir();
-    const QFileInfoList cues = dir.entryInfoList(cueExtensions, QDir::Files);
-
-    for(const auto& cue : cues) {
-        if(cue.completeBaseName() == file.completeBaseName() || cue.fileName().contains(file.fileName())) {
-            return cue;
-        }
-    }
-
-    return {};
-}
-
 QFileInfoList getFiles(const QStringList& paths, const QStringList& restrictExtensions,
                        const QStringList& excludeExtensions, const QStringList& playlistExtensions)
 {
     const Fooyin::Timer timer;
 
     QFileInfoList files;
+    std::unordered_set<QString> addedFiles;
+    Fooyin::CueSheetIndex cueIndex;
+
+    const auto addFile = [&files, &addedFiles](const QFileInfo& file) {
+        if(addedFiles.emplace(file.absoluteFilePath()).second) {
+            files.append(file);
+        }
+    };
 
     QStringList nameFilters{restrictExtensions};
     QStringList playlistFilters{playlistExtensions};
@@ -101,11 +171,6 @@ QFileInfoList getFiles(const QStringList& paths, const QStringList& restrictExte
 
     for(const QString& path : paths) {
         const QFileInfo file{path};
-
-        if(files.contains(file)) {
-            continue;
-        }
-
         const QString suffix = file.suffix().toLower();
 
         if(file.isDir()) {
@@ -115,19 +180,19 @@ QFileInfoList getFiles(const QStringList& paths, const QStringList& restrictExte
                 dirIt.next();
                 const QFileInfo info = dirIt.fileInfo();
                 if(info.size() > 0) {
-                    files.append(info);
+                    addFile(info);
                 }
             }
         }
         else {
             if(playlistFilters.contains(suffix)) {
-                files.emplace_back(file.absoluteFilePath());
+                addFile(file);
             }
             else if(nameFilters.contains(suffix)) {
-                if(const auto cue = findMatchingCue(file)) {
-                    files.emplace_back(cue.value());
+                if(const auto cue = cueIndex.cueForFile(file.absoluteFilePath())) {
+                    addFile(QFileInfo{cue.value()});
                 }
-                files.emplace_back(file.absoluteFilePath());
+                addFile(file);
             }
         }
     }
@@ -139,6 +204,24 @@ QFileInfoList getFiles(const QStringList& paths, const QStringList& restrictExte
     return files;
 }
 
+bool hasAudioProperties(const Fooyin::Track& track)
+{
+    return track.duration() > 0 || track.sampleRate() > 0;
+}
+
+void copyAudioProperties(const Fooyin::Track& source, Fooyin::Track& track)
+{
+    track.setDuration(source.duration());
+    track.setBitrate(source.bitrate());
+    track.setSampleRate(source.sampleRate());
+    track.setChannels(source.channels());
+    track.setBitDepth(source.bitDepth());
+    track.setCodec(source.codec());
+    track.setCodecProfile(source.codecProfile());
+    track.setTool(source.tool());
+    track.setEncoding(source.encoding());
+}
+
 void readFileProperties(Fooyin::Track& track)
 {
     const QFileInfo fileInfo{track.filepath()};
@@ -179,11 +262,20 @@ public:
     void fileScanned(const QString& file);
 
     Track matchMissingTrack(const Track& track);
+    void markFilePresent(const QString& filepath);
+    [[nodiscard]] QStringList presenceExtensions() const;
+
+    void startStats();
+    void finishStats();
+    void recordRead(const FileReadStats& stats);
 
     void checkBatchFinished();
+    void emitScanUpdate();
     void removeMissingTrack(const Track& track);
 
-    [[nodiscard]] TrackList readTracks(const QString& filepath);
+    [[nodiscard]] bool readTrackMetadata(Track& track);
+    [[nodiscard]] TrackList readTracks(const QString& filepath, FileReadStats& stats,
+                                       AudioReader::ReadOptions options = AudioReader::ReadAll);
     [[nodiscard]] TrackList readArchiveTracks(const QString& filepath);
     [[nodiscard]] TrackList readPlaylist(const QString& filepath);
     [[nodiscard]] TrackList readPlaylistTracks(const QString& filepath);
@@ -191,17 +283,36 @@ public:
 
     void updateExistingCueTracks(const TrackList& tracks, const QString& cue);
     void addNewCueTracks(const QString& cue, const QString& filename);
-    void readCue(const QString& cue, bool onlyModified);
+    void addCueSheet(const QString& cue, bool onlyModified);
+    [[nodiscard]] TrackList readAudioProperties(const TrackList& tracks);
 
     void setTrackProps(Track& track);
     void setTrackProps(Track& track, const QString& file);
 
     void updateExistingTrack(Track& track, const QString& file);
-    void readNewTrack(const QString& file);
+    void addNewTracks(const QString& file, TrackList& tracks);
+
+    [[nodiscard]] bool needsUpdate(const Track& libraryTrack, uint64_t lastModified, bool onlyModified) const;
+    void loadDeferredFields(const QStringList& files, bool onlyModified) const;
+    [[nodiscard]] ScannedFile readFileMetadata(const QString& file, bool onlyModified);
+    void processScannedFile(ScannedFile& scannedFile);
 
     void readFile(const QString& file, bool onlyModified);
+    bool queueFiles(const QStringList& files, bool onlyModified);
+    void startReadChunk(bool onlyModified);
+    bool processReadChunk();
+    bool finishReadChunks(bool onlyModified);
+    void cancelReadChunks();
     void populateExistingTracks(const TrackList& tracks, bool includeMissing = true);
+    void addMissingTrack(const Track& track);
+    void disableMissingTrack(const Track& track);
+    void saveScanResults();
+
+    [[nodiscard]] QStringList libraryExtensions() const;
+    void setupReadPool();
+
     bool getAndSaveAllTracks(const QStringList& paths, const TrackList& tracks, bool onlyModified);
+    bool applyLibraryChanges(const LibraryChanges& changes, const TrackList& tracks);
 
     void changeLibraryStatus(LibraryInfo::Status status);
 
@@ -213,10 +324,17 @@ public:
     std::shared_ptr<AudioLoader> m_audioLoader;
 
     std::unique_ptr<DbConnectionHandler> m_dbHandler;
+    QThreadPool m_readPool;
+    int m_readThreads{1};
+    AudioReader::ReadOptions m_readOptions;
+    QStringList m_queuedFiles;
+    std::deque<ReadChunk> m_readChunks;
+    CueSheetIndex m_cueIndex;
 
     bool m_monitor{false};
     LibraryInfo m_currentLibrary;
     TrackDatabase m_trackDatabase;
+    LibraryDatabase m_libraryDatabase;
 
     TrackList m_tracksToStore;
     TrackList m_tracksToUpdate;
@@ -224,14 +342,18 @@ public:
     std::unordered_map<QString, TrackList> m_trackPaths;
     std::unordered_map<QString, TrackList> m_existingArchives;
     std::unordered_map<QString, TrackList> m_missingFiles;
-    std::unordered_map<QString, Track> m_missingHashes;
+    std::unordered_map<uint64_t, Track> m_missingHashes;
     std::unordered_map<QString, TrackList> m_existingCueTracks;
     std::unordered_map<QString, TrackList> m_missingCueTracks;
-    std::set<QString> m_cueFilesScanned;
+
+    std::unordered_set<int> m_propertiesFailed;
 
     std::set<QString> m_filesScanned;
     size_t m_totalFiles{0};
 
+    ScanStats m_stats;
+    Clock::time_point m_scanStart;
+
     std::unordered_map<int, LibraryWatcher> m_watchers;
 };
 
@@ -258,24 +380,18 @@ void LibraryScannerPrivate::cleanupScan()
     m_missingHashes.clear();
     m_existingCueTracks.clear();
     m_missingCueTracks.clear();
-    m_cueFilesScanned.clear();
+    m_cueIndex.clear();
 }
 
 void LibraryScannerPrivate::addWatcher(const LibraryInfo& library)
 {
-    auto watchPaths = [this, library](const QString& path) {
-        QStringList dirs = Utils::File::getAllSubdirectories(path);
-        dirs.append(path);
-        m_watchers[library.id].addPaths(dirs);
-    };
-
-    watchPaths(library.path);
+    auto& watcher = m_watchers[library.id];
+    watcher.addRoot(library.path);
 
-    QObject::connect(&m_watchers.at(library.id), &LibraryWatcher::libraryDirsChanged, m_self,
-                     [this, watchPaths, library](const QStringList& dirs) {
-                         std::ranges::for_each(dirs, watchPaths);
-                         emit m_self->directoriesChanged(library, dirs);
-                     });
+    QObject::connect(&watcher, &LibraryWatcher::libraryDirsChanged, m_self,
+                     [this, library](const QStringList& dirs) { emit m_self->directoriesChanged(library, dirs); });
+    QObject::connect(&watcher, &LibraryWatcher::libraryChanged, m_self,
+                     [this, library](const LibraryChanges& changes) { emit m_self->libraryChanged(library, changes); });
 }
 
 void LibraryScannerPrivate::reportProgress(const QString& file) const
@@ -292,38 +408,135 @@ void LibraryScannerPrivate::fileScanned(const QString& file)
 Track LibraryScannerPrivate::matchMissingTrack(const Track& track)
 {
     const QString filename = track.filename();
-    const QString hash     = track.hash();
+    const uint64_t hash    = track.hash();
+
+    // Tracks not yet found may just be in a directory the scan hasn't reached, so confirm before matching
+    const auto isMissing = [](const Track& missingTrack) {
+        return !QFileInfo::exists(missingTrack.isInArchive() ? missingTrack.archivePath() : missingTrack.filepath());
+    };
 
     if(m_missingFiles.contains(filename)) {
         for(const auto& file : m_missingFiles.at(filename)) {
-            if(file.hash() == hash) {
+            if(file.hash() == hash && isMissing(file)) {
                 return file;
             }
         }
     }
 
-    if(m_missingHashes.contains(hash) && m_missingHashes.at(hash).duration() == track.duration()) {
+    // Tracks from a tag-only read have no duration to compare yet
+    if(m_missingHashes.contains(hash)
+       && (m_missingHashes.at(hash).duration() == track.duration() || !hasAudioProperties(track))
+       && isMissing(m_missingHashes.at(hash))) {
         return m_missingHashes.at(hash);
     }
 
     return {};
 }
 
+void LibraryScannerPrivate::markFilePresent(const QString& filepath)
+{
+    const auto markTracksPresent = [this](const TrackList& tracks) {
+        for(const Track& track : tracks) {
+            if(const auto filesIt = m_missingFiles.find(track.filename()); filesIt != m_missingFiles.end()) {
+                std::erase_if(filesIt->second,
+                              [&track](const Track& missingTrack) { return missingTrack.id() == track.id(); });
+                if(filesIt->second.empty()) {
+                    m_missingFiles.erase(filesIt);
+                }
+            }
+            if(const auto hashIt = m_missingHashes.find(track.hash());
+               hashIt != m_missingHashes.end() && hashIt->second.id() == track.id()) {
+                m_missingHashes.erase(hashIt);
+            }
+        }
+    };
+
+    if(const auto pathIt = m_trackPaths.find(filepath); pathIt != m_trackPaths.cend()) {
+        markTracksPresent(pathIt->second);
+    }
+    if(const auto archiveIt = m_existingArchives.find(filepath); archiveIt != m_existingArchives.cend()) {
+        markTracksPresent(archiveIt->second);
+    }
+
+    m_missingCueTracks.erase(filepath);
+}
+
+QStringList LibraryScannerPrivate::presenceExtensions() const
+{
+    std::set<QString> extensions{u"cue"_s};
+
+    const auto addExtension = [&extensions](const QString& filepath) {
+        const auto dot = filepath.lastIndexOf(u'.');
+        if(dot > filepath.lastIndexOf(u'/')) {
+            extensions.emplace(filepath.sliced(dot + 1).toLower());
+        }
+    };
+
+    for(const QString& filepath : m_trackPaths | std::views::keys) {
+        addExtension(filepath);
+    }
+    for(const QString& filepath : m_existingArchives | std::views::keys) {
+        addExtension(filepath);
+    }
+
+    return {extensions.cbegin(), extensions.cend()};
+}
+
+void LibraryScannerPrivate::startStats()
+{
+    m_stats     = {};
+    m_scanStart = Clock::now();
+}
+
+void LibraryScannerPrivate::finishStats()
+{
+    m_stats.total = Clock::now() - m_scanStart;
+    m_stats.files = m_filesScanned.size();
+
+    qCDebug(LIB_SCANNER).noquote() << m_stats.report();
+
+    emit m_self->statsChanged(m_stats);
+}
+
+void LibraryScannerPrivate::recordRead(const FileReadStats& stats)
+{
+    if(!stats.reader.isEmpty()) {
+        auto& readerStats = m_stats.readers[stats.reader];
+        ++readerStats.files;
+        readerStats.bytes += stats.bytes;
+        readerStats.time += stats.tagParse;
+    }
+
+    m_stats.stat += stats.stat;
+    m_stats.hash += stats.hash;
+}
+
 void LibraryScannerPrivate::checkBatchFinished()
 {
     if(m_tracksToStore.size() >= BatchSize || m_tracksToUpdate.size() > BatchSize) {
         if(m_tracksToStore.size() >= BatchSize) {
+            const StageTimer timer{m_stats.store};
             m_trackDatabase.storeTracks(m_tracksToStore);
         }
         if(m_tracksToUpdate.size() >= BatchSize) {
+            const StageTimer timer{m_stats.update};
             m_trackDatabase.updateTracks(m_tracksToUpdate);
         }
-        emit m_self->scanUpdate({.addedTracks = m_tracksToStore, .updatedTracks = m_tracksToUpdate});
+        emitScanUpdate();
         m_tracksToStore.clear();
         m_tracksToUpdate.clear();
     }
 }
 
+void LibraryScannerPrivate::emitScanUpdate()
+{
+    m_stats.tracksAdded += m_tracksToStore.size();
+    m_stats.tracksUpdated += m_tracksToUpdate.size();
+
+    const StageTimer timer{m_stats.emitUpdate};
+    emit m_self->scanUpdate({.addedTracks = m_tracksToStore, .updatedTracks = m_tracksToUpdate});
+}
+
 void LibraryScannerPrivate::removeMissingTrack(const Track& track)
 {
     if(m_missingFiles.contains(track.filename())) {
@@ -336,7 +549,22 @@ void LibraryScannerPrivate::removeMissingTrack(const Track& track)
     }
 }
 
-TrackList LibraryScannerPrivate::readTracks(const QString& filepath)
+bool LibraryScannerPrivate::readTrackMetadata(Track& track)
+{
+    const QString reader = m_audioLoader->readerNameForFile(track.filepath());
+    if(reader.isEmpty()) {
+        return m_audioLoader->readTrackMetadata(track);
+    }
+
+    auto& readerStats = m_stats.readers[reader];
+    ++readerStats.files;
+    readerStats.bytes += track.fileSize();
+
+    return timeStage(readerStats.time, [this, &track]() { return m_audioLoader->readTrackMetadata(track); });
+}
+
+TrackList LibraryScannerPrivate::readTracks(const QString& filepath, FileReadStats& stats,
+                                            AudioReader::ReadOptions options)
 {
     if(m_audioLoader->isArchive(filepath)) {
         return readArchiveTracks(filepath);
@@ -354,7 +582,13 @@ TrackList LibraryScannerPrivate::readTracks(const QString& filepath)
     }
     const AudioSource source{filepath, &file, nullptr};
 
-    if(!tagReader->init(source)) {
+    stats.reader = m_audioLoader->readerNameForFile(filepath);
+    stats.bytes  = file.size();
+
+    // Readers which can't skip audio properties read them anyway
+    tagReader->setReadOptions(options);
+
+    if(!timeStage(stats.tagParse, [&tagReader, &source]() { return tagReader->init(source); })) {
         qCDebug(LIB_SCANNER) << "Unsupported file:" << filepath;
         return {};
     }
@@ -366,9 +600,12 @@ TrackList LibraryScannerPrivate::readTracks(const QString& filepath)
         Track subTrack{filepath, subIndex};
         subTrack.setFileSize(file.size());
 
-        source.device->seek(0);
-        if(tagReader->readTrack(source, subTrack)) {
-            subTrack.generateHash();
+        const bool read = timeStage(stats.tagParse, [&tagReader, &source, &subTrack]() {
+            source.device->seek(0);
+            return tagReader->readTrack(source, subTrack);
+        });
+        if(read) {
+            timeStage(stats.hash, [&subTrack]() { subTrack.generateHash(); });
             tracks.push_back(subTrack);
         }
     }
@@ -414,7 +651,11 @@ TrackList LibraryScannerPrivate::readArchiveTracks(const QString& filepath)
         source.device        = device;
         source.archiveReader = archiveReader.get();
 
-        if(!fileReader->init(source)) {
+        auto& readerStats = m_stats.readers[m_audioLoader->readerNameForFile(entry)];
+        ++readerStats.files;
+        readerStats.bytes += device->size();
+
+        if(!timeStage(readerStats.time, [&fileReader, &source]() { return fileReader->init(source); })) {
             qCDebug(LIB_SCANNER) << "Unsupported file:" << entry;
             return;
         }
@@ -428,9 +669,12 @@ TrackList LibraryScannerPrivate::readArchiveTracks(const QString& filepath)
             subTrack.setModifiedTime(modifiedTime.isValid() ? modifiedTime.toMSecsSinceEpoch() : 0);
             source.filepath = subTrack.filepath();
 
-            device->seek(0);
-            if(fileReader->readTrack(source, subTrack)) {
-                subTrack.generateHash();
+            const bool read = timeStage(readerStats.time, [&fileReader, &source, &subTrack, device]() {
+                device->seek(0);
+                return fileReader->readTrack(source, subTrack);
+            });
+            if(read) {
+                timeStage(m_stats.hash, [&subTrack]() { subTrack.generateHash(); });
                 tracks.push_back(subTrack);
                 fileScanned(subTrack.prettyFilepath());
             }
@@ -496,13 +740,13 @@ TrackList LibraryScannerPrivate::readPlaylistTracks(const QString& path)
         }
 
         Track readTrack{playlistTrack};
-        readFileProperties(readTrack);
+        timeStage(m_stats.stat, [&readTrack]() { readFileProperties(readTrack); });
 
-        if(!m_audioLoader->readTrackMetadata(readTrack)) {
+        if(!readTrackMetadata(readTrack)) {
             return playlistTrack;
         }
 
-        readTrack.generateHash();
+        timeStage(m_stats.hash, [&readTrack]() { readTrack.generateHash(); });
 
         ++m_totalFiles;
         fileScanned(readTrack.prettyFilepath());
@@ -537,12 +781,12 @@ TrackList LibraryScannerPrivate::readEmbeddedPlaylistTracks(const Track& track)
 
         Track readTrack{playlistTrack};
 
-        if(!m_audioLoader->readTrackMetadata(readTrack)) {
+        if(!readTrackMetadata(readTrack)) {
             return playlistTrack;
         }
 
-        readFileProperties(readTrack);
-        readTrack.generateHash();
+        timeStage(m_stats.stat, [&readTrack]() { readFileProperties(readTrack); });
+        timeStage(m_stats.hash, [&readTrack]() { readTrack.generateHash(); });
 
         ++m_totalFiles;
         fileScanned(readTrack.prettyFilepath());
@@ -576,7 +820,7 @@ void LibraryScannerPrivate::updateExistingCueTracks(const TrackList& tracks, con
         }
         setTrackProps(track);
         m_tracksToUpdate.push_back(track);
-        m_cueFilesScanned.emplace(track.filepath());
+        m_cueIndex.addReference(cue, track.filepath());
     }
 }
 
@@ -587,6 +831,7 @@ void LibraryScannerPrivate::addNewCueTracks(const QString& cue, const QString& f
         for(Track& track : refoundCueTracks) {
             track.setCuePath(cue);
             m_tracksToUpdate.push_back(track);
+            m_cueIndex.addReference(cue, track.filepath());
         }
     }
     else {
@@ -595,15 +840,15 @@ void LibraryScannerPrivate::addNewCueTracks(const QString& cue, const QString& f
             Track track{cueTrack};
             setTrackProps(track);
             m_tracksToStore.push_back(track);
-            m_cueFilesScanned.emplace(track.filepath());
+            m_cueIndex.addReference(cue, track.filepath());
         }
     }
 }
 
-void LibraryScannerPrivate::readCue(const QString& cue, bool onlyModified)
+void LibraryScannerPrivate::addCueSheet(const QString& cue, bool onlyModified)
 {
     const QFileInfo info{cue};
-    const QDateTime lastModifiedTime{info.lastModified()};
+    const QDateTime lastModifiedTime = timeStage(m_stats.stat, [&info]() { return info.lastModified(); });
     uint64_t lastModified{0};
 
     if(lastModifiedTime.isValid()) {
@@ -617,7 +862,7 @@ void LibraryScannerPrivate::readCue(const QString& cue, bool onlyModified)
         }
         else {
             for(const Track& track : tracks) {
-                m_cueFilesScanned.emplace(track.filepath());
+                m_cueIndex.addReference(cue, track.filepath());
             }
         }
     }
@@ -626,6 +871,30 @@ void LibraryScannerPrivate::readCue(const QString& cue, bool onlyModified)
     }
 }
 
+TrackList LibraryScannerPrivate::readAudioProperties(const TrackList& tracks)
+{
+    TrackList updatedTracks;
+
+    for(const Track& track : tracks) {
+        if(!m_self->mayRun()) {
+            break;
+        }
+
+        Track readTrack{track.filepath(), track.subsong()};
+        if(!m_audioLoader->readTrackMetadata(readTrack) || !hasAudioProperties(readTrack)) {
+            qCDebug(LIB_SCANNER) << "Unable to read audio properties:" << track.filepath();
+            m_propertiesFailed.emplace(track.id());
+            continue;
+        }
+
+        Track updatedTrack{track};
+        copyAudioProperties(readTrack, updatedTrack);
+        updatedTracks.push_back(updatedTrack);
+    }
+
+    return updatedTracks;
+}
+
 void LibraryScannerPrivate::setTrackProps(Track& track)
 {
     setTrackProps(track, track.filepath());
@@ -633,13 +902,13 @@ void LibraryScannerPrivate::setTrackProps(Track& track)
 
 void LibraryScannerPrivate::setTrackProps(Track& track, const QString& file)
 {
-    readFileProperties(track);
+    timeStage(m_stats.stat, [&track]() { readFileProperties(track); });
     track.setFilePath(file);
 
     if(m_currentLibrary.id >= 0) {
         track.setLibraryId(m_currentLibrary.id);
     }
-    track.generateHash();
+    timeStage(m_stats.hash, [&track]() { track.generateHash(); });
     track.setIsEnabled(true);
 }
 
@@ -683,15 +952,10 @@ void LibraryScannerPrivate::updateExistingTrack(Track& track, const QString& fil
     }
 }
 
-void LibraryScannerPrivate::readNewTrack(const QString& file)
+void LibraryScannerPrivate::addNewTracks(const QString& file, TrackList& tracks)
 {
     qCDebug(LIB_SCANNER) << "Indexing new file:" << file;
 
-    TrackList tracks = readTracks(file);
-    if(tracks.empty()) {
-        return;
-    }
-
     for(Track& track : tracks) {
         Track refoundTrack = matchMissingTrack(track);
         if(refoundTrack.isInLibrary() || refoundTrack.isInDatabase()) {
@@ -719,18 +983,42 @@ void LibraryScannerPrivate::readNewTrack(const QString& file)
     }
 }
 
-void LibraryScannerPrivate::readFile(const QString& file, bool onlyModified)
+bool LibraryScannerPrivate::needsUpdate(const Track& libraryTrack, uint64_t lastModified, bool onlyModified) const
 {
-    if(!m_self->mayRun()) {
-        return;
+    return !libraryTrack.isEnabled() || libraryTrack.libraryId() != m_currentLibrary.id
+        || libraryTrack.modifiedTime() < lastModified || !onlyModified;
+}
+
+void LibraryScannerPrivate::loadDeferredFields(const QStringList& files, bool onlyModified) const
+{
+    // Reading a changed track copies its deferred fields, so load those known to be read here in one go,
+    // rather than once per track from the read pool.
+    // Tracks only changed on disk aren't known until stat'd, but are few when only reading modified files.
+    TrackList tracks;
+    for(const QString& file : files) {
+        if(const auto pathIt = m_trackPaths.find(file); pathIt != m_trackPaths.cend()) {
+            const Track& libraryTrack = pathIt->second.front();
+            if(libraryTrack.hasDeferredFields() && needsUpdate(libraryTrack, 0, onlyModified)) {
+                tracks.push_back(libraryTrack);
+            }
+        }
     }
 
-    if(m_cueFilesScanned.contains(file)) {
-        return;
+    Track::loadDeferredFields(tracks);
+}
+
+ScannedFile LibraryScannerPrivate::readFileMetadata(const QString& file, bool onlyModified)
+{
+    // May be called from the read pool, so only existing track state can be accessed here
+
+    ScannedFile scannedFile{.filepath = file};
+
+    if(!m_self->mayRun()) {
+        return scannedFile;
     }
 
-    const QFileInfo info{file};
-    const QDateTime lastModifiedTime{info.lastModified()};
+    const QDateTime lastModifiedTime
+        = timeStage(scannedFile.stats.stat, [&file]() { return QFileInfo{file}.lastModified(); });
     uint64_t lastModified{0};
 
     if(lastModifiedTime.isValid()) {
@@ -740,34 +1028,199 @@ void LibraryScannerPrivate::readFile(const QString& file, bool onlyModified)
     if(m_trackPaths.contains(file)) {
         const Track& libraryTrack = m_trackPaths.at(file).front();
 
-        if(!libraryTrack.isEnabled() || libraryTrack.libraryId() != m_currentLibrary.id
-           || libraryTrack.modifiedTime() < lastModified || !onlyModified) {
+        if(needsUpdate(libraryTrack, lastModified, onlyModified)) {
+            scannedFile.stats.reader = m_audioLoader->readerNameForFile(file);
+            scannedFile.stats.bytes  = libraryTrack.fileSize();
+
             Track changedTrack{libraryTrack};
-            if(!m_audioLoader->readTrackMetadata(changedTrack)) {
-                return;
+            if(!timeStage(scannedFile.stats.tagParse,
+                          [this, &changedTrack]() { return m_audioLoader->readTrackMetadata(changedTrack); })) {
+                return scannedFile;
             }
 
             if(lastModifiedTime.isValid()) {
                 changedTrack.setModifiedTime(lastModified);
             }
 
-            updateExistingTrack(changedTrack, file);
+            scannedFile.type = ScannedFile::Type::Existing;
+            scannedFile.tracks.push_back(changedTrack);
         }
     }
     else if(m_existingArchives.contains(file)) {
         const Track& libraryTrack = m_existingArchives.at(file).front();
 
-        if(!libraryTrack.isEnabled() || libraryTrack.libraryId() != m_currentLibrary.id
-           || libraryTrack.modifiedTime() < lastModified || !onlyModified) {
-            TrackList tracks = readArchiveTracks(file);
+        if(needsUpdate(libraryTrack, lastModified, onlyModified)) {
+            // Archives report progress per entry, so are read when processed
+            scannedFile.type = ScannedFile::Type::ExistingArchive;
+        }
+    }
+    else if(m_audioLoader->isArchive(file)) {
+        scannedFile.type = ScannedFile::Type::NewArchive;
+    }
+    else {
+        scannedFile.type   = ScannedFile::Type::New;
+        scannedFile.tracks = readTracks(file, scannedFile.stats, m_readOptions);
+    }
+
+    return scannedFile;
+}
+
+void LibraryScannerPrivate::processScannedFile(ScannedFile& scannedFile)
+{
+    recordRead(scannedFile.stats);
+
+    switch(scannedFile.type) {
+        case(ScannedFile::Type::Skipped):
+            break;
+        case(ScannedFile::Type::Existing):
+            updateExistingTrack(scannedFile.tracks.front(), scannedFile.filepath);
+            break;
+        case(ScannedFile::Type::ExistingArchive): {
+            TrackList tracks = readArchiveTracks(scannedFile.filepath);
             for(Track& track : tracks) {
                 updateExistingTrack(track, track.filepath());
             }
+            break;
+        }
+        case(ScannedFile::Type::New):
+            addNewTracks(scannedFile.filepath, scannedFile.tracks);
+            break;
+        case(ScannedFile::Type::NewArchive): {
+            TrackList tracks = readArchiveTracks(scannedFile.filepath);
+            addNewTracks(scannedFile.filepath, tracks);
+            break;
         }
     }
-    else {
-        readNewTrack(file);
+}
+
+void LibraryScannerPrivate::readFile(const QString& file, bool onlyModified)
+{
+    if(!m_self->mayRun()) {
+        return;
+    }
+
+    ScannedFile scannedFile = readFileMetadata(file, onlyModified);
+    processScannedFile(scannedFile);
+}
+
+bool LibraryScannerPrivate::queueFiles(const QStringList& files, bool onlyModified)
+{
+    // Cue sheets come first, so the files they reference are known before the rest are read
+    const auto cuesEnd = std::ranges::find_if_not(files, DirectoryEnumerator::isCueFile);
+    for(auto it = files.cbegin(); it != cuesEnd; ++it) {
+        if(!m_self->mayRun()) {
+            return false;
+        }
+
+        addCueSheet(*it, onlyModified);
+        fileScanned(*it);
+        checkBatchFinished();
+    }
+
+    QStringList audioFiles;
+    for(auto it = cuesEnd; it != files.cend(); ++it) {
+        if(m_cueIndex.isReferenced(*it)) {
+            fileScanned(*it);
+        }
+        else {
+            audioFiles.push_back(*it);
+        }
+    }
+
+    if(m_readThreads <= 1) {
+        loadDeferredFields(audioFiles, onlyModified);
+
+        for(const QString& filepath : audioFiles) {
+            if(!m_self->mayRun()) {
+                return false;
+            }
+
+            readFile(filepath, onlyModified);
+            fileScanned(filepath);
+            checkBatchFinished();
+        }
+
+        return true;
+    }
+
+    m_queuedFiles.append(audioFiles);
+
+    if(m_queuedFiles.size() >= ReadChunkSize) {
+        startReadChunk(onlyModified);
+        // Keep one chunk reading in the background while the previous one is processed
+        while(m_readChunks.size() > 1) {
+            if(!processReadChunk()) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+void LibraryScannerPrivate::startReadChunk(bool onlyModified)
+{
+    ReadChunk chunk;
+    chunk.files = std::exchange(m_queuedFiles, {});
+
+    loadDeferredFields(chunk.files, onlyModified);
+
+    chunk.results = QtConcurrent::mapped(&m_readPool, chunk.files, [this, onlyModified](const QString& filepath) {
+        return readFileMetadata(filepath, onlyModified);
+    });
+
+    m_readChunks.push_back(std::move(chunk));
+}
+
+bool LibraryScannerPrivate::processReadChunk()
+{
+    // Tags are read by the pool, while results are applied here in enumeration order
+    ReadChunk chunk = std::move(m_readChunks.front());
+    m_readChunks.pop_front();
+
+    for(qsizetype i{0}; i < chunk.files.size(); ++i) {
+        if(!m_self->mayRun()) {
+            chunk.results.cancel();
+            chunk.results.waitForFinished();
+            return false;
+        }
+
+        ScannedFile scannedFile = chunk.results.resultAt(static_cast<int>(i));
+        processScannedFile(scannedFile);
+
+        fileScanned(chunk.files.at(i));
+        checkBatchFinished();
+    }
+
+    return true;
+}
+
+bool LibraryScannerPrivate::finishReadChunks(bool onlyModified)
+{
+    if(!m_queuedFiles.empty()) {
+        startReadChunk(onlyModified);
+    }
+
+    while(!m_readChunks.empty()) {
+        if(!processReadChunk()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void LibraryScannerPrivate::cancelReadChunks()
+{
+    for(ReadChunk& chunk : m_readChunks) {
+        chunk.results.cancel();
+    }
+    for(ReadChunk& chunk : m_readChunks) {
+        chunk.results.waitForFinished();
     }
+
+    m_readChunks.clear();
+    m_queuedFiles.clear();
 }
 
 void LibraryScannerPrivate::populateExistingTracks(const TrackList& tracks, bool includeMissing)
@@ -778,89 +1231,337 @@ void LibraryScannerPrivate::populateExistingTracks(const TrackList& tracks, bool
             m_existingArchives[track.archivePath()].push_back(track);
         }
 
+        const QString cuePath = track.hasEmbeddedCue() ? track.filepath() : track.cuePath();
+        if(track.hasCue()) {
+            m_existingCueTracks[cuePath].emplace_back(track);
+        }
+
         if(includeMissing) {
+            // Every track is assumed missing until its file is found by the directory walk
             if(track.hasCue()) {
-                const auto cuePath = track.hasEmbeddedCue() ? track.filepath() : track.cuePath();
-                m_existingCueTracks[cuePath].emplace_back(track);
-                if(!QFileInfo::exists(cuePath)) {
-                    m_missingCueTracks[cuePath].emplace_back(track);
-                }
-            }
-
-            if(!track.isInArchive()) {
-                if(!QFileInfo::exists(track.filepath())) {
-                    m_missingFiles[track.filename()].push_back(track);
-                    m_missingHashes.emplace(track.hash(), track);
-                }
-            }
-            else {
-                if(!QFileInfo::exists(track.archivePath())) {
-                    m_missingFiles[track.filename()].push_back(track);
-                    m_missingHashes.emplace(track.hash(), track);
-                }
+                m_missingCueTracks[cuePath].emplace_back(track);
             }
+            addMissingTrack(track);
         }
     }
 }
 
-bool LibraryScannerPrivate::getAndSaveAllTracks(const QStringList& paths, const TrackList& tracks, bool onlyModified)
+void LibraryScannerPrivate::addMissingTrack(const Track& track)
 {
-    populateExistingTracks(tracks);
+    m_missingFiles[track.filename()].push_back(track);
+    m_missingHashes.emplace(track.hash(), track);
+}
+
+void LibraryScannerPrivate::disableMissingTrack(const Track& track)
+{
+    if(track.isInLibrary() || track.isEnabled()) {
+        qCDebug(LIB_SCANNER) << "Track not found:" << track.prettyFilepath();
 
+        Track disabledTrack{track};
+        disabledTrack.setLibraryId(-1);
+        disabledTrack.setIsEnabled(false);
+        m_tracksToUpdate.push_back(disabledTrack);
+    }
+}
+
+void LibraryScannerPrivate::saveScanResults()
+{
+    timeStage(m_stats.store, [this]() { m_trackDatabase.storeTracks(m_tracksToStore); });
+    timeStage(m_stats.update, [this]() { m_trackDatabase.updateTracks(m_tracksToUpdate); });
+
+    if(!m_tracksToStore.empty() || !m_tracksToUpdate.empty()) {
+        emitScanUpdate();
+    }
+}
+
+QStringList LibraryScannerPrivate::libraryExtensions() const
+{
     using namespace Settings::Core::Internal;
 
-    QStringList restrictExtensions = m_settings->fileValue(LibraryRestrictTypes).toStringList();
+    QStringList extensions = m_settings->fileValue(LibraryRestrictTypes).toStringList();
     const QStringList excludeExtensions
         = m_settings->fileValue(LibraryExcludeTypes, QStringList{u"cue"_s}).toStringList();
 
-    if(restrictExtensions.empty()) {
-        restrictExtensions = m_audioLoader->supportedFileExtensions();
-        restrictExtensions.append(u"cue"_s);
+    if(extensions.empty()) {
+        extensions = m_audioLoader->supportedFileExtensions();
+        extensions.append(u"cue"_s);
     }
 
-    const auto files = getFiles(paths, restrictExtensions, excludeExtensions, {});
+    for(const auto& ext : excludeExtensions) {
+        extensions.removeAll(ext);
+    }
+
+    return extensions;
+}
+
+void LibraryScannerPrivate::setupReadPool()
+{
+    m_readThreads = m_settings->fileValue(Settings::Core::Internal::LibraryScanThreads, QThread::idealThreadCount())
+                        .toInt();
+    m_readPool.setMaxThreadCount(std::max(m_readThreads, 1));
+    m_stats.readThreads = std::max(m_readThreads, 1);
+
+    // New files are only read for tags, leaving audio properties to be read later by readAudioProperties
+    const bool deferProperties
+        = m_settings->fileValue(Settings::Core::Internal::LibraryDeferProperties, false).toBool();
+    m_readOptions = deferProperties ? AudioReader::SkipAudioProperties : AudioReader::ReadAll;
+}
+
+bool LibraryScannerPrivate::getAndSaveAllTracks(const QStringList& paths, const TrackList& tracks, bool onlyModified)
+{
+    populateExistingTracks(tracks);
 
-    m_totalFiles = files.size();
+    const QStringList extensions = libraryExtensions();
+
+    // Directories unchanged since the last scan are skipped when only looking for modifications
+    const bool useManifest = m_currentLibrary.id >= 0;
+    const bool isFullScan  = paths.size() == 1 && paths.front() == m_currentLibrary.path;
+    DirectoryManifest previousManifest;
+    DirectoryManifest manifest;
+
+    if(useManifest && onlyModified) {
+        m_libraryDatabase.getDirectoryManifest(m_currentLibrary.id, previousManifest);
+    }
+
+    DirectoryEnumerator enumerator{extensions};
+    enumerator.setManifest(previousManifest.empty() ? nullptr : &previousManifest, useManifest ? &manifest : nullptr);
+    enumerator.setPresenceHandler(presenceExtensions(),
+                                  [this](const QString& filepath) { markFilePresent(filepath); });
+
+    setupReadPool();
+
+    m_totalFiles = 0;
     reportProgress({});
 
-    for(const auto& file : files) {
-        if(!m_self->mayRun()) {
-            return false;
+    const Timer timer;
+
+    ScanStats::Duration enumerateTime{0};
+    ScanStats::Duration handlerTime{0};
+
+    // Files are read as each directory is enumerated, so the total grows as the scan progresses
+    const auto handleFiles = [this, onlyModified, &handlerTime](const QString& /*dir*/, const QStringList& files) {
+        const StageTimer handlerTimer{handlerTime};
+        m_totalFiles += files.size();
+        return queueFiles(files, onlyModified);
+    };
+
+    bool completed = timeStage(enumerateTime, [&paths, &enumerator, &handleFiles]() {
+        return std::ranges::all_of(paths, [&enumerator, &handleFiles](const QString& path) {
+            return enumerator.enumerate(path, handleFiles);
+        });
+    });
+
+    m_stats.enumerate += enumerateTime - handlerTime;
+    m_stats.directories += enumerator.directoryCount();
+    m_stats.skippedDirectories += enumerator.skippedDirectoryCount();
+
+    completed = completed && finishReadChunks(onlyModified);
+
+    if(!completed) {
+        cancelReadChunks();
+        return false;
+    }
+
+    qCInfo(LIB_SCANNER) << "Read" << m_totalFiles << "files from" << enumerator.directoryCount() << "directories in"
+                        << timer.elapsedFormatted();
+    if(enumerator.skippedDirectoryCount() > 0) {
+        qCDebug(LIB_SCANNER) << "Skipped" << enumerator.skippedDirectoryCount() << "unchanged directories";
+    }
+
+    if(useManifest) {
+        m_libraryDatabase.storeDirectoryManifest(m_currentLibrary.id, manifest, isFullScan);
+    }
+
+    QStringList scanRoots;
+    for(const QString& path : paths) {
+        const QFileInfo info{path};
+        scanRoots.append(QDir::cleanPath(info.absoluteFilePath()) + (info.isDir() ? u"/"_s : QString{}));
+    }
+
+    // Only tracks within the scanned paths have been looked for; the rest are checked directly on a full scan
+    const auto isMissing = [this, &scanRoots, isFullScan](const Track& track) {
+        const QString filepath = track.isInArchive() ? track.archivePath() : track.filepath();
+        if(std::ranges::any_of(scanRoots, [&filepath](const QString& root) {
+               return root.endsWith(u'/') ? filepath.startsWith(root) : filepath == root;
+           })) {
+            return true;
         }
+        if(isFullScan && (track.libraryId() == m_currentLibrary.id || !track.isInLibrary())) {
+            return !QFileInfo::exists(filepath);
+        }
+        return false;
+    };
 
-        const QString filepath = file.absoluteFilePath();
+    for(const auto& missingTracks : m_missingFiles | std::views::values) {
+        for(const auto& missingTrack : missingTracks) {
+            if(isMissing(missingTrack)) {
+                disableMissingTrack(missingTrack);
+            }
+        }
+    }
 
-        if(file.suffix() == "cue"_L1) {
-            readCue(filepath, onlyModified);
+    saveScanResults();
+
+    return true;
+}
+
+bool LibraryScannerPrivate::applyLibraryChanges(const LibraryChanges& changes, const TrackList& tracks)
+{
+    populateExistingTracks(tracks, false);
+
+    QStringList filesToRead{changes.modified};
+
+    // Removed tracks are held as missing, so a file re-created elsewhere is matched to them rather than added
+    const auto removeTracks = [this](const auto& trackMap, const QString& path) {
+        if(const auto tracksIt = trackMap.find(path); tracksIt != trackMap.cend()) {
+            std::ranges::for_each(tracksIt->second, [this](const Track& track) { addMissingTrack(track); });
         }
-        else {
-            readFile(filepath, onlyModified);
+    };
+
+    for(const QString& path : changes.removed) {
+        removeTracks(m_trackPaths, path);
+        removeTracks(m_existingArchives, path);
+    }
+
+    const auto isWithin = [](const QString& path, const QString& dir) {
+        return path.startsWith(dir) && path.size() > dir.size() && path.at(dir.size()) == u'/';
+    };
+
+    if(!changes.removedDirs.empty()) {
+        for(const Track& track : tracks) {
+            const QString filepath = track.isInArchive() ? track.archivePath() : track.filepath();
+            if(std::ranges::any_of(changes.removedDirs,
+                                   [&](const QString& dir) { return isWithin(filepath, dir); })) {
+                addMissingTrack(track);
+            }
         }
+    }
 
-        fileScanned(filepath);
-        checkBatchFinished();
+    // Moves only change paths, so are applied without reading any tags
+    std::unordered_map<QString, QString> fileMoves;
+    for(const auto& [from, to] : changes.moved) {
+        fileMoves.emplace(from, to);
+        if(!m_trackPaths.contains(from) && !m_existingArchives.contains(from) && !m_existingCueTracks.contains(from)) {
+            filesToRead.append(to);
+        }
     }
 
-    for(const auto& missingTracks : m_missingFiles | std::views::values) {
-        for(const auto& missingTrack : missingTracks) {
-            if(missingTrack.isInLibrary() || missingTrack.isEnabled()) {
-                qCDebug(LIB_SCANNER) << "Track not found:" << missingTrack.prettyFilepath();
+    const auto resolvePath = [&changes, &fileMoves, &isWithin](const QString& path) {
+        if(const auto moveIt = fileMoves.find(path); moveIt != fileMoves.cend()) {
+            return moveIt->second;
+        }
+        QString resolved{path};
+        for(const auto& [from, to] : changes.movedDirs) {
+            if(resolved == from || isWithin(resolved, from)) {
+                resolved = to + resolved.sliced(from.size());
+            }
+        }
+        if(const auto moveIt = fileMoves.find(resolved); moveIt != fileMoves.cend()) {
+            return moveIt->second;
+        }
+        return resolved;
+    };
+
+    std::set<QString> movedArchives;
+    TrackList movedTracks;
+
+    const auto moveTrack = [&](const Track& track) {
+        if(track.isInArchive()) {
+            // Entry paths are derived from the archive path, so re-read and match them to the originals
+            const QString archivePath = resolvePath(track.archivePath());
+            if(archivePath != track.archivePath()) {
+                addMissingTrack(track);
+                movedArchives.emplace(archivePath);
+            }
+            return;
+        }
+
+        const bool hasCueSheet = track.hasCue() && !track.hasEmbeddedCue();
+        const QString filepath = resolvePath(track.filepath());
+        const QString cuePath  = hasCueSheet ? resolvePath(track.cuePath()) : track.cuePath();
+
+        if(filepath == track.filepath() && cuePath == track.cuePath()) {
+            return;
+        }
+
+        if(filepath != track.filepath() && m_trackPaths.contains(filepath)) {
+            // Replaced an existing file, which is updated instead
+            addMissingTrack(track);
+            filesToRead.append(filepath);
+            return;
+        }
+
+        Track movedTrack{track};
+        if(hasCueSheet) {
+            movedTrack.setCuePath(cuePath);
+        }
+        setTrackProps(movedTrack, filepath);
+        movedTracks.push_back(movedTrack);
 
-                Track disabledTrack{missingTrack};
-                disabledTrack.setLibraryId(-1);
-                disabledTrack.setIsEnabled(false);
-                m_tracksToUpdate.push_back(disabledTrack);
+        qCDebug(LIB_SCANNER) << "Track moved:" << track.filepath() << "->" << filepath;
+    };
+
+    if(!changes.movedDirs.empty()) {
+        std::ranges::for_each(tracks, moveTrack);
+    }
+    else {
+        for(const auto& [from, to] : changes.moved) {
+            for(const auto* trackMap : {&m_trackPaths, &m_existingArchives, &m_existingCueTracks}) {
+                if(const auto tracksIt = trackMap->find(from); tracksIt != trackMap->cend()) {
+                    std::ranges::for_each(tracksIt->second, moveTrack);
+                }
             }
         }
     }
 
-    m_trackDatabase.storeTracks(m_tracksToStore);
-    m_trackDatabase.updateTracks(m_tracksToUpdate);
+    for(const Track& track : movedTracks) {
+        // Modified files at the new path are treated as existing tracks
+        m_trackPaths[track.filepath()].push_back(track);
+        m_tracksToUpdate.push_back(track);
+    }
+
+    filesToRead.append(QStringList{movedArchives.cbegin(), movedArchives.cend()});
+    filesToRead.removeDuplicates();
+    std::ranges::sort(filesToRead);
+    std::ranges::stable_partition(filesToRead, DirectoryEnumerator::isCueFile);
 
-    if(!m_tracksToStore.empty() || !m_tracksToUpdate.empty()) {
-        emit m_self->scanUpdate({m_tracksToStore, m_tracksToUpdate});
+    setupReadPool();
+
+    DirectoryEnumerator enumerator{libraryExtensions()};
+
+    m_totalFiles = 0;
+    reportProgress({});
+
+    ScanStats::Duration enumerateTime{0};
+    ScanStats::Duration handlerTime{0};
+
+    const auto handleFiles = [this, &handlerTime](const QString& /*dir*/, const QStringList& files) {
+        const StageTimer handlerTimer{handlerTime};
+        m_totalFiles += files.size();
+        return queueFiles(files, true);
+    };
+
+    bool completed = timeStage(enumerateTime, [&filesToRead, &enumerator, &handleFiles]() {
+        return std::ranges::all_of(filesToRead, [&enumerator, &handleFiles](const QString& file) {
+            return enumerator.enumerate(file, handleFiles);
+        });
+    });
+
+    m_stats.enumerate += enumerateTime - handlerTime;
+
+    completed = completed && finishReadChunks(true);
+
+    if(!completed) {
+        cancelReadChunks();
+        return false;
     }
 
+    for(const auto& missingTracks : m_missingFiles | std::views::values) {
+        std::ranges::for_each(missingTracks, [this](const Track& track) { disableMissingTrack(track); });
+    }
+
+    saveScanResults();
+
     return true;
 }
 
@@ -885,6 +1586,12 @@ void LibraryScanner::initialiseThread()
 
     p->m_dbHandler = std::make_unique<DbConnectionHandler>(p->m_dbPool);
     p->m_trackDatabase.initialise(DbConnectionProvider{p->m_dbPool});
+    p->m_libraryDatabase.initialise(DbConnectionProvider{p->m_dbPool});
+}
+
+ScanStats LibraryScanner::stats() const
+{
+    return p->m_stats;
 }
 
 void LibraryScanner::stopThread()
@@ -942,7 +1649,23 @@ void LibraryScanner::scanLibrary(const LibraryInfo& library, const TrackList& tr
         if(p->m_monitor && !p->m_watchers.contains(library.id)) {
             p->addWatcher(library);
         }
+        p->startStats();
+
+        // First scans and full rescans write most of the library, so are much quicker in bulk
+        const bool bulkImport = !onlyModified || std::ranges::none_of(tracks, [&library](const Track& track) {
+                                    return track.libraryId() == library.id;
+                                });
+        if(bulkImport) {
+            p->m_trackDatabase.beginBulkImport();
+        }
+
         p->getAndSaveAllTracks({library.path}, tracks, onlyModified);
+
+        if(bulkImport) {
+            timeStage(p->m_stats.store, [this]() { p->m_trackDatabase.endBulkImport(); });
+        }
+
+        p->finishStats();
         p->cleanupScan();
     }
 
@@ -965,7 +1688,9 @@ void LibraryScanner::scanLibraryDirectoies(const LibraryInfo& library, const QSt
     p->m_currentLibrary = library;
     p->changeLibraryStatus(LibraryInfo::Status::Scanning);
 
+    p->startStats();
     p->getAndSaveAllTracks(dirs, tracks, true);
+    p->finishStats();
     p->cleanupScan();
 
     if(state() == Paused) {
@@ -978,6 +1703,68 @@ void LibraryScanner::scanLibraryDirectoies(const LibraryInfo& library, const QSt
     }
 }
 
+void LibraryScanner::scanLibraryChanges(const LibraryInfo& library, const LibraryChanges& changes,
+                                        const TrackList& tracks)
+{
+    setState(Running);
+
+    p->m_currentLibrary = library;
+    p->changeLibraryStatus(LibraryInfo::Status::Scanning);
+
+    const Timer timer;
+
+    p->startStats();
+    p->applyLibraryChanges(changes, tracks);
+    p->finishStats();
+    p->cleanupScan();
+
+    qCDebug(LIB_SCANNER) << "Applied changes to" << library.name << "in" << timer.elapsedFormatted();
+
+    if(state() == Paused) {
+        p->changeLibraryStatus(LibraryInfo::Status::Pending);
+    }
+    else {
+        p->changeLibraryStatus(p->m_monitor ? LibraryInfo::Status::Monitoring : LibraryInfo::Status::Idle);
+        setState(Idle);
+        emit finished();
+    }
+}
+
+bool LibraryScanner::needsAudioProperties(const Track& track)
+{
+    return track.isInDatabase() && track.isInLibrary() && track.isEnabled() && !track.isInArchive() && !track.hasCue()
+        && !hasAudioProperties(track);
+}
+
+void LibraryScanner::readAudioProperties(const TrackList& libraryTracks)
+{
+    setState(Running);
+
+    TrackList pendingTracks;
+    for(const Track& track : libraryTracks) {
+        if(std::cmp_greater_equal(pendingTracks.size(), PropertiesBatchSize)) {
+            break;
+        }
+        if(needsAudioProperties(track) && !p->m_propertiesFailed.contains(track.id())) {
+            pendingTracks.push_back(track);
+        }
+    }
+
+    const TrackList updatedTracks = p->readAudioProperties(pendingTracks);
+    if(!updatedTracks.empty()) {
+        p->m_trackDatabase.updateTracks(updatedTracks);
+        qCDebug(LIB_SCANNER) << "Read audio properties of" << updatedTracks.size() << "tracks";
+    }
+
+    const bool morePending = !mayRun() || std::cmp_equal(pendingTracks.size(), PropertiesBatchSize);
+
+    if(state() != Paused) {
+        setState(Idle);
+    }
+
+    emit audioPropertiesRead(updatedTracks, morePending);
+}
+
 void LibraryScanner::scanTracks(const TrackList& /*libraryTracks*/, const TrackList& tracks, bool onlyModified)
 {
     setState(Running);
@@ -1014,7 +1801,7 @@ void LibraryScanner::scanTracks(const TrackList& /*libraryTracks*/, const TrackL
 
         Track updatedTrack{track.filepath()};
 
-        if(p->m_audioLoader->readTrackMetadata(updatedTrack)) {
+        if(p->readTrackMetadata(updatedTrack)) {
             updatedTrack.setId(track.id());
             updatedTrack.setLibraryId(track.libraryId());
             updatedTrack.setAddedTime(track.addedTime());
@@ -1098,7 +1885,9 @@ void LibraryScanner::scanFiles(const TrackList& libraryTracks, const QList<QUrl>
                     }
                 }
                 else {
-                    TrackList tracks = p->readTracks(filepath);
+                    FileReadStats readStats;
+                    TrackList tracks = p->readTracks(filepath, readStats);
+                    p->recordRead(readStats);
                     if(tracks.empty()) {
                         continue;
                     }
@@ -19,6 +19,9 @@
 
 #pragma once
 
+#include "librarywatcher.h"
+#include "scanstats.h"
+
 #include <core/library/libraryinfo.h>
 #include <core/track.h>
 #include <utils/database/dbconnectionpool.h>
@@ -51,13 +54,25 @@ public:
     void initialiseThread() override;
     void stopThread() override;
 
+    /*!
+     * Returns the stats of the last library scan.
+     * @note only safe to call from the scanner's thread, or once it has finished.
+     */
+    [[nodiscard]] ScanStats stats() const;
+
+    /** Returns @c true if @p track was indexed by a tag-only scan and is left for @fn readAudioProperties. */
+    [[nodiscard]] static bool needsAudioProperties(const Track& track);
+
 signals:
     void progressChanged(int current, const QString& file, int total);
     void statusChanged(const Fooyin::LibraryInfo& library);
     void scanUpdate(const Fooyin::ScanResult& result);
+    void statsChanged(const Fooyin::ScanStats& stats);
     void scannedTracks(const Fooyin::TrackList& tracks);
     void playlistLoaded(const Fooyin::TrackList& tracks);
     void directoriesChanged(const Fooyin::LibraryInfo& library, const QStringList& dirs);
+    void libraryChanged(const Fooyin::LibraryInfo& library, const Fooyin::LibraryChanges& changes);
+    void audioPropertiesRead(const Fooyin::TrackList& tracks, bool morePending);
 
 public slots:
     void setMonitorLibraries(bool enabled);
@@ -65,9 +80,17 @@ public slots:
     void scanLibrary(const Fooyin::LibraryInfo& library, const Fooyin::TrackList& tracks, bool onlyModified);
     void scanLibraryDirectoies(const Fooyin::LibraryInfo& library, const QStringList& dirs,
                                const Fooyin::TrackList& tracks);
+    void scanLibraryChanges(const Fooyin::LibraryInfo& library, const Fooyin::LibraryChanges& changes,
+                            const Fooyin::TrackList& tracks);
     void scanTracks(const Fooyin::TrackList& libraryTracks, const Fooyin::TrackList& tracks, bool onlyModified);
     void scanFiles(const Fooyin::TrackList& libraryTracks, const QList<QUrl>& urls);
     void scanPlaylist(const Fooyin::TrackList& libraryTracks, const QList<QUrl>& urls);
+    /*!
+     * Reads the audio properties of the next batch of tracks in @p libraryTracks
+     * which were indexed by a tag-only scan, and saves them to the database.
+     * Stops early if the scanner is paused.
+     */
+    void readAudioProperties(const Fooyin::TrackList& libraryTracks);
 
 private:
     std::unique_ptr<LibraryScannerPrivate> p;
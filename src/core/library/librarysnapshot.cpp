@@ -0,0 +1,434 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "librarysnapshot.h"
+
+#include <core/constants.h>
+
+#include <QFile>
+#include <QLoggingCategory>
+#include <QSaveFile>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <unordered_map>
+
+Q_LOGGING_CATEGORY(LIB_SNAPSHOT, "fy.librarysnapshot")
+
+// "FYLS", also used to reject snapshots written with a different byte order
+constexpr uint32_t SnapshotMagic = 0x534C5946;
+// Increment whenever the layout below or the stored fields change
+constexpr uint32_t SnapshotVersion = 2;
+constexpr uint64_t StringAlignment = 8;
+
+namespace {
+enum StringField : uint8_t
+{
+    FilePath = 0,
+    Title,
+    TrackNumber,
+    TrackTotal,
+    Artists,
+    AlbumArtists,
+    Album,
+    DiscNumber,
+    DiscTotal,
+    Date,
+    Composers,
+    Performers,
+    Genres,
+    CuePath,
+    Codec,
+    CodecProfile,
+    ExtraTags,
+    Sort,
+    StringFieldCount
+};
+
+struct SnapshotHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    int64_t revision;
+    uint32_t trackCount;
+    uint32_t stringCount;
+    // Index of the sort script in the string table
+    uint32_t sort;
+    uint32_t reserved;
+    uint64_t stringsOffset;
+    uint64_t dataOffset;
+    uint64_t tracksOffset;
+    uint64_t fileSize;
+};
+
+// Position of a string within the data section.
+// Text is stored as UTF-16, and extra tags as serialised by Track::serialiseExtraTags.
+struct StringEntry
+{
+    uint64_t offset;
+    uint64_t size;
+};
+
+struct TrackRecord
+{
+    uint64_t hash;
+    uint64_t offset;
+    uint64_t duration;
+    uint64_t fileSize;
+    uint64_t modifiedTime;
+    uint64_t addedTime;
+    uint64_t firstPlayed;
+    uint64_t lastPlayed;
+    int32_t id;
+    int32_t libraryId;
+    int32_t subsong;
+    int32_t bitrate;
+    int32_t sampleRate;
+    int32_t channels;
+    int32_t bitDepth;
+    int32_t playCount;
+    float rating;
+    float rgTrackGain;
+    float rgAlbumGain;
+    float rgTrackPeak;
+    float rgAlbumPeak;
+    std::array<uint32_t, StringFieldCount> strings;
+};
+
+static_assert(std::is_trivially_copyable_v<SnapshotHeader>);
+static_assert(std::is_trivially_copyable_v<StringEntry>);
+static_assert(std::is_trivially_copyable_v<TrackRecord>);
+
+QString joinList(const QStringList& list)
+{
+    return list.join(QLatin1String{Fooyin::Constants::UnitSeparator});
+}
+
+class StringTableWriter
+{
+public:
+    uint32_t addString(const QString& str)
+    {
+        if(const auto it = m_strings.find(str); it != m_strings.cend()) {
+            return it->second;
+        }
+        const uint32_t index = add(str.utf16(), static_cast<uint64_t>(str.size()) * sizeof(char16_t));
+        m_strings.emplace(str, index);
+        return index;
+    }
+
+    uint32_t addBytes(const QByteArray& bytes)
+    {
+        if(const auto it = m_bytes.find(bytes); it != m_bytes.cend()) {
+            return it->second;
+        }
+        const uint32_t index = add(bytes.constData(), static_cast<uint64_t>(bytes.size()));
+        m_bytes.emplace(bytes, index);
+        return index;
+    }
+
+    [[nodiscard]] const std::vector<StringEntry>& entries() const
+    {
+        return m_entries;
+    }
+
+    [[nodiscard]] const QByteArray& data() const
+    {
+        return m_data;
+    }
+
+private:
+    uint32_t add(const void* data, uint64_t size)
+    {
+        const auto offset = static_cast<uint64_t>(m_data.size());
+        m_data.append(static_cast<const char*>(data), static_cast<qsizetype>(size));
+        // Keep every entry aligned so UTF-16 text can be read in place
+        m_data.append(static_cast<qsizetype>((StringAlignment - (size % StringAlignment)) % StringAlignment), '\0');
+
+        m_entries.push_back({.offset = offset, .size = size});
+        return static_cast<uint32_t>(m_entries.size() - 1);
+    }
+
+    std::unordered_map<QString, uint32_t> m_strings;
+    std::unordered_map<QByteArray, uint32_t> m_bytes;
+    std::vector<StringEntry> m_entries;
+    QByteArray m_data;
+};
+
+class StringTableReader
+{
+public:
+    StringTableReader(const uchar* data, std::vector<StringEntry> entries)
+        : m_data{data}
+        , m_entries{std::move(entries)}
+        , m_strings(m_entries.size())
+        , m_hasString(m_entries.size(), false)
+        , m_lists(m_entries.size())
+        , m_hasList(m_entries.size(), false)
+    { }
+
+    [[nodiscard]] bool isValid(uint32_t index) const
+    {
+        return index < m_entries.size();
+    }
+
+    // Strings are only decoded once, so equal fields share the same data
+    const QString& string(uint32_t index)
+    {
+        if(!m_hasString.at(index)) {
+            const StringEntry& entry = m_entries.at(index);
+            m_strings.at(index)   = QString::fromUtf16(reinterpret_cast<const char16_t*>(m_data + entry.offset),
+                                                       static_cast<qsizetype>(entry.size / sizeof(char16_t)));
+            m_hasString.at(index) = true;
+        }
+        return m_strings.at(index);
+    }
+
+    const QStringList& list(uint32_t index)
+    {
+        if(!m_hasList.at(index)) {
+            m_lists.at(index)   = string(index).split(QLatin1String{Fooyin::Constants::UnitSeparator});
+            m_hasList.at(index) = true;
+        }
+        return m_lists.at(index);
+    }
+
+    [[nodiscard]] QByteArray bytes(uint32_t index) const
+    {
+        const StringEntry& entry = m_entries.at(index);
+        return {reinterpret_cast<const char*>(m_data + entry.offset), static_cast<qsizetype>(entry.size)};
+    }
+
+private:
+    const uchar* m_data;
+    std::vector<StringEntry> m_entries;
+    std::vector<QString> m_strings;
+    std::vector<bool> m_hasString;
+    std::vector<QStringList> m_lists;
+    std::vector<bool> m_hasList;
+};
+
+bool isValidRange(uint64_t offset, uint64_t size, uint64_t fileSize)
+{
+    return offset <= fileSize && size <= fileSize - offset;
+}
+} // namespace
+
+namespace Fooyin {
+std::optional<LibrarySnapshot::Contents> LibrarySnapshot::read(const QString& filepath, int64_t revision)
+{
+    QFile file{filepath};
+    if(!file.exists() || !file.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+
+    const auto fileSize = static_cast<uint64_t>(file.size());
+    if(fileSize < sizeof(SnapshotHeader)) {
+        return {};
+    }
+
+    const uchar* data = file.map(0, file.size());
+    if(!data) {
+        qCInfo(LIB_SNAPSHOT) << "Unable to map library snapshot" << filepath;
+        return {};
+    }
+
+    SnapshotHeader header;
+    std::memcpy(&header, data, sizeof(header));
+
+    if(header.magic != SnapshotMagic || header.version != SnapshotVersion || header.fileSize != fileSize) {
+        return {};
+    }
+    if(header.revision != revision) {
+        qCDebug(LIB_SNAPSHOT) << "Library snapshot is out of date";
+        return {};
+    }
+    if(!isValidRange(header.stringsOffset, uint64_t{header.stringCount} * sizeof(StringEntry), fileSize)
+       || !isValidRange(header.tracksOffset, uint64_t{header.trackCount} * sizeof(TrackRecord), fileSize)
+       || header.dataOffset > fileSize) {
+        qCWarning(LIB_SNAPSHOT) << "Library snapshot is corrupt";
+        return {};
+    }
+
+    std::vector<StringEntry> entries(header.stringCount);
+    std::memcpy(entries.data(), data + header.stringsOffset, entries.size() * sizeof(StringEntry));
+
+    for(const StringEntry& entry : entries) {
+        if(!isValidRange(entry.offset, entry.size, fileSize - header.dataOffset)) {
+            qCWarning(LIB_SNAPSHOT) << "Library snapshot is corrupt";
+            return {};
+        }
+    }
+
+    StringTableReader strings{data + header.dataOffset, std::move(entries)};
+    if(!strings.isValid(header.sort)) {
+        return {};
+    }
+
+    Contents contents;
+    contents.sort = strings.string(header.sort);
+    contents.tracks.reserve(header.trackCount);
+    contents.sortKeys.reserve(header.trackCount);
+
+    for(uint32_t i{0}; i < header.trackCount; ++i) {
+        TrackRecord record;
+        std::memcpy(&record, data + header.tracksOffset + (i * sizeof(TrackRecord)), sizeof(TrackRecord));
+
+        if(!std::ranges::all_of(record.strings, [&strings](uint32_t index) { return strings.isValid(index); })) {
+            qCWarning(LIB_SNAPSHOT) << "Library snapshot is corrupt";
+            return {};
+        }
+
+        Track& track = contents.tracks.emplace_back();
+
+        track.setId(record.id);
+        track.setFilePath(strings.string(record.strings.at(FilePath)));
+        track.setSubsong(record.subsong);
+        track.setTitle(strings.string(record.strings.at(Title)));
+        track.setTrackNumber(strings.string(record.strings.at(TrackNumber)));
+        track.setTrackTotal(strings.string(record.strings.at(TrackTotal)));
+        track.setArtists(strings.list(record.strings.at(Artists)));
+        track.setAlbumArtists(strings.list(record.strings.at(AlbumArtists)));
+        track.setAlbum(strings.string(record.strings.at(Album)));
+        track.setDiscNumber(strings.string(record.strings.at(DiscNumber)));
+        track.setDiscTotal(strings.string(record.strings.at(DiscTotal)));
+        track.setDate(strings.string(record.strings.at(Date)));
+        track.setComposers(strings.list(record.strings.at(Composers)));
+        track.setPerformers(strings.list(record.strings.at(Performers)));
+        track.setGenres(strings.list(record.strings.at(Genres)));
+        track.setCuePath(strings.string(record.strings.at(CuePath)));
+        track.setOffset(record.offset);
+        track.setDuration(record.duration);
+        track.setFileSize(record.fileSize);
+        track.setBitrate(record.bitrate);
+        track.setSampleRate(record.sampleRate);
+        track.setChannels(record.channels);
+        track.setBitDepth(record.bitDepth);
+        track.setCodec(strings.string(record.strings.at(Codec)));
+        track.setCodecProfile(strings.string(record.strings.at(CodecProfile)));
+        track.storeExtraTags(strings.bytes(record.strings.at(ExtraTags)));
+        track.setModifiedTime(record.modifiedTime);
+        track.setLibraryId(record.libraryId);
+        track.setHash(record.hash);
+        track.setRGTrackGain(record.rgTrackGain);
+        track.setRGAlbumGain(record.rgAlbumGain);
+        track.setRGTrackPeak(record.rgTrackPeak);
+        track.setRGAlbumPeak(record.rgAlbumPeak);
+        track.setAddedTime(record.addedTime);
+        track.setFirstPlayed(record.firstPlayed);
+        track.setLastPlayed(record.lastPlayed);
+        track.setPlayCount(record.playCount);
+        track.setRating(record.rating);
+        track.setFieldsDeferred();
+
+        contents.sortKeys.push_back(strings.string(record.strings.at(Sort)));
+    }
+
+    return contents;
+}
+
+bool LibrarySnapshot::write(const QString& filepath, const TrackList& tracks, const std::vector<QString>& sortKeys,
+                            int64_t revision, const QString& sort)
+{
+    StringTableWriter strings;
+    std::vector<TrackRecord> records;
+    records.reserve(tracks.size());
+
+    for(size_t i{0}; i < tracks.size(); ++i) {
+        const Track& track  = tracks.at(i);
+        TrackRecord& record = records.emplace_back();
+
+        record.hash         = track.hash();
+        record.offset       = track.offset();
+        record.duration     = track.duration();
+        record.fileSize     = track.fileSize();
+        record.modifiedTime = track.modifiedTime();
+        record.addedTime    = track.addedTime();
+        record.firstPlayed  = track.firstPlayed();
+        record.lastPlayed   = track.lastPlayed();
+        record.id           = track.id();
+        record.libraryId    = track.libraryId();
+        record.subsong      = track.subsong();
+        record.bitrate      = track.bitrate();
+        record.sampleRate   = track.sampleRate();
+        record.channels     = track.channels();
+        record.bitDepth     = track.bitDepth();
+        record.playCount    = track.playCount();
+        record.rating       = track.rating();
+        record.rgTrackGain  = track.rgTrackGain();
+        record.rgAlbumGain  = track.rgAlbumGain();
+        record.rgTrackPeak  = track.rgTrackPeak();
+        record.rgAlbumPeak  = track.rgAlbumPeak();
+
+        record.strings.at(FilePath)     = strings.addString(track.filepath());
+        record.strings.at(Title)        = strings.addString(track.title());
+        record.strings.at(TrackNumber)  = strings.addString(track.trackNumber());
+        record.strings.at(TrackTotal)   = strings.addString(track.trackTotal());
+        record.strings.at(Artists)      = strings.addString(joinList(track.artists()));
+        record.strings.at(AlbumArtists) = strings.addString(joinList(track.albumArtists()));
+        record.strings.at(Album)        = strings.addString(track.album());
+        record.strings.at(DiscNumber)   = strings.addString(track.discNumber());
+        record.strings.at(DiscTotal)    = strings.addString(track.discTotal());
+        record.strings.at(Date)         = strings.addString(track.date());
+        record.strings.at(Composers)    = strings.addString(joinList(track.composers()));
+        record.strings.at(Performers)   = strings.addString(joinList(track.performers()));
+        record.strings.at(Genres)       = strings.addString(joinList(track.genres()));
+        record.strings.at(CuePath)      = strings.addString(track.cuePath());
+        record.strings.at(Codec)        = strings.addString(track.codec());
+        record.strings.at(CodecProfile) = strings.addString(track.codecProfile());
+        record.strings.at(ExtraTags)    = strings.addBytes(track.serialiseExtraTags());
+        record.strings.at(Sort)         = strings.addString(sortKeys.at(i));
+    }
+
+    SnapshotHeader header{};
+    header.magic       = SnapshotMagic;
+    header.version     = SnapshotVersion;
+    header.revision    = revision;
+    header.trackCount  = static_cast<uint32_t>(records.size());
+    header.sort        = strings.addString(sort);
+    header.stringCount = static_cast<uint32_t>(strings.entries().size());
+
+    header.stringsOffset = sizeof(SnapshotHeader);
+    header.tracksOffset  = header.stringsOffset + (strings.entries().size() * sizeof(StringEntry));
+    header.dataOffset    = header.tracksOffset + (records.size() * sizeof(TrackRecord));
+    header.fileSize      = header.dataOffset + static_cast<uint64_t>(strings.data().size());
+
+    QSaveFile file{filepath};
+    if(!file.open(QIODevice::WriteOnly)) {
+        qCWarning(LIB_SNAPSHOT) << "Unable to write library snapshot to" << filepath << file.errorString();
+        return false;
+    }
+
+    const auto writeData = [&file](const void* data, size_t size) {
+        return file.write(static_cast<const char*>(data), static_cast<qint64>(size)) == static_cast<qint64>(size);
+    };
+
+    if(!writeData(&header, sizeof(header))
+       || !writeData(strings.entries().data(), strings.entries().size() * sizeof(StringEntry))
+       || !writeData(records.data(), records.size() * sizeof(TrackRecord))
+       || !writeData(strings.data().constData(), static_cast<size_t>(strings.data().size()))) {
+        qCWarning(LIB_SNAPSHOT) << "Unable to write library snapshot to" << filepath << file.errorString();
+        file.cancelWriting();
+        return false;
+    }
+
+    return file.commit();
+}
+} // namespace Fooyin
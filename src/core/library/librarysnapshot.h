@@ -0,0 +1,63 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <core/track.h>
+
+#include <QString>
+
+#include <optional>
+#include <vector>
+
+namespace Fooyin {
+/*!
+ * A binary copy of the sorted library, read using a memory mapping to load it at startup without
+ * decoding every row from the database and sorting it again.
+ * Each unique string is stored once, and tracks are stored as fixed size records referencing them.
+ *
+ * A snapshot is only valid for the library revision it was written at. The revision is stored in the
+ * Settings table and bumped by TrackDatabase on any write to the Tracks table.
+ * Track stats change too often to invalidate it, so are reloaded from the database along with it.
+ * Fields deferred by TrackDatabase::getAllTracks aren't stored, and are loaded on demand as usual.
+ */
+class LibrarySnapshot
+{
+public:
+    struct Contents
+    {
+        // Sorted using @c sort
+        TrackList tracks;
+        // Sort key of each track
+        std::vector<QString> sortKeys;
+        QString sort;
+    };
+
+    /*!
+     * Reads the snapshot at @p filepath.
+     * @returns the tracks, or nothing if the snapshot is missing, invalid or not at @p revision.
+     */
+    static std::optional<Contents> read(const QString& filepath, int64_t revision);
+    /*!
+     * Writes @p tracks, which must be sorted using @p sort into @p sortKeys, as the snapshot of @p revision.
+     */
+    static bool write(const QString& filepath, const TrackList& tracks, const std::vector<QString>& sortKeys,
+                      int64_t revision, const QString& sort);
+};
+} // namespace Fooyin
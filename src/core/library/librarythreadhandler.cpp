@@ -19,6 +19,7 @@
 
 #include "librarythreadhandler.h"
 
+#include "databasemaintenance.h"
 #include "internalcoresettings.h"
 #include "libraryscanner.h"
 #include "trackdatabasemanager.h"
@@ -31,16 +32,25 @@
 #include <QTimerEvent>
 #include <QUrl>
 
+#include <algorithm>
 #include <deque>
 
 using namespace std::chrono_literals;
 
 #if QT_VERSION >= QT_VERSION_CHECK(6, 5, 0)
-constexpr auto WriteInterval  = 1s;
-constexpr auto UpdateInterval = 1s;
+constexpr auto WriteInterval           = 1s;
+constexpr auto UpdateInterval          = 1s;
+constexpr auto PropertiesInterval      = 2s;
+constexpr auto PropertiesBatchInterval = 100ms;
+constexpr auto MaintenanceInterval     = 5min;
+constexpr auto MaintenanceStepInterval = 1s;
 #else
-constexpr auto WriteInterval  = 1000;
-constexpr auto UpdateInterval = 1000;
+constexpr auto WriteInterval           = 1000;
+constexpr auto UpdateInterval          = 1000;
+constexpr auto PropertiesInterval      = 2000;
+constexpr auto PropertiesBatchInterval = 100;
+constexpr auto MaintenanceInterval     = 300000;
+constexpr auto MaintenanceStepInterval = 1000;
 #endif
 
 namespace {
@@ -58,6 +68,7 @@ struct LibraryScanRequest
     ScanRequest::Type type;
     LibraryInfo library;
     QStringList dirs;
+    LibraryChanges changes;
     QList<QUrl> files;
     TrackList tracks;
     bool onlyModified{true};
@@ -74,12 +85,14 @@ public:
     void scanTracks(const LibraryScanRequest& request);
     void scanFiles(const LibraryScanRequest& request);
     void scanDirectory(const LibraryScanRequest& request);
+    void scanChanges(const LibraryScanRequest& request);
     void scanPlaylist(const LibraryScanRequest& request);
 
     ScanRequest addLibraryScanRequest(const LibraryInfo& libraryInfo, bool onlyModified);
     ScanRequest addTracksScanRequest(const TrackList& tracks, bool onlyModified);
     ScanRequest addFilesScanRequest(const QList<QUrl>& files);
     ScanRequest addDirectoryScanRequest(const LibraryInfo& libraryInfo, const QStringList& dirs);
+    ScanRequest addChangesScanRequest(const LibraryInfo& libraryInfo, const LibraryChanges& changes);
     ScanRequest addPlaylistRequest(const QList<QUrl>& files);
 
     [[nodiscard]] std::optional<LibraryScanRequest> currentRequest() const;
@@ -89,6 +102,15 @@ public:
     void finishScanRequest();
     void cancelScanRequest(int id);
 
+    [[nodiscard]] bool deferAudioProperties() const;
+    void startPropertiesTimer();
+    void readAudioProperties();
+    void audioPropertiesRead(const TrackList& tracks, bool morePending);
+
+    [[nodiscard]] bool isIdle() const;
+    void runMaintenance();
+    void maintenanceRan(bool morePending);
+
     LibraryThreadHandler* m_self;
 
     DbConnectionPoolPtr m_dbPool;
@@ -98,6 +120,7 @@ public:
     QThread m_thread;
     LibraryScanner m_scanner;
     TrackDatabaseManager m_trackDatabaseManager;
+    DatabaseMaintenance m_maintenance;
 
     QBasicTimer m_writeTimer;
     TrackList m_tracksPendingWrite;
@@ -105,6 +128,9 @@ public:
     TrackList m_tracksPendingUpdate;
     QBasicTimer m_playcountTimer;
     TrackList m_tracksPendingPlaycountUpdate;
+    QBasicTimer m_propertiesTimer;
+    bool m_readingProperties{false};
+    QBasicTimer m_maintenanceTimer;
 
     std::deque<LibraryScanRequest> m_scanRequests;
     int m_currentRequestId{-1};
@@ -123,11 +149,13 @@ LibraryThreadHandlerPrivate::LibraryThreadHandlerPrivate(LibraryThreadHandler* s
     , m_settings{settings}
     , m_scanner{m_dbPool, std::move(playlistLoader), audioLoader, m_settings}
     , m_trackDatabaseManager{m_dbPool, audioLoader, m_settings}
+    , m_maintenance{m_dbPool}
 {
     m_scanner.setMonitorLibraries(m_settings->value<Settings::Core::Internal::MonitorLibraries>());
 
     m_scanner.moveToThread(&m_thread);
     m_trackDatabaseManager.moveToThread(&m_thread);
+    m_maintenance.moveToThread(&m_thread);
 
     QObject::connect(m_library, &MusicLibrary::tracksScanned, m_self, [this]() {
         m_tracksAddedToLibrary = true;
@@ -168,6 +196,13 @@ void LibraryThreadHandlerPrivate::scanDirectory(const LibraryScanRequest& reques
     });
 }
 
+void LibraryThreadHandlerPrivate::scanChanges(const LibraryScanRequest& request)
+{
+    QMetaObject::invokeMethod(&m_scanner, [this, request]() {
+        m_scanner.scanLibraryChanges(request.library, request.changes, m_library->tracks());
+    });
+}
+
 void LibraryThreadHandlerPrivate::scanPlaylist(const LibraryScanRequest& request)
 {
     QMetaObject::invokeMethod(&m_scanner,
@@ -278,6 +313,30 @@ ScanRequest LibraryThreadHandlerPrivate::addDirectoryScanRequest(const LibraryIn
     return request;
 }
 
+ScanRequest LibraryThreadHandlerPrivate::addChangesScanRequest(const LibraryInfo& libraryInfo,
+                                                               const LibraryChanges& changes)
+{
+    const int id = nextRequestId();
+
+    ScanRequest request{.type = ScanRequest::Library, .id = id, .cancel = [this, id]() {
+                            cancelScanRequest(id);
+                        }};
+
+    LibraryScanRequest libraryRequest;
+    libraryRequest.id      = id;
+    libraryRequest.type    = ScanRequest::Library;
+    libraryRequest.library = libraryInfo;
+    libraryRequest.changes = changes;
+
+    m_scanRequests.emplace_back(libraryRequest);
+
+    if(m_scanRequests.size() == 1) {
+        execNextRequest();
+    }
+
+    return request;
+}
+
 ScanRequest LibraryThreadHandlerPrivate::addPlaylistRequest(const QList<QUrl>& files)
 {
     const int id = nextRequestId();
@@ -322,6 +381,11 @@ void LibraryThreadHandlerPrivate::execNextRequest()
         return;
     }
 
+    // Audio properties are only read while there are no other requests
+    if(m_readingProperties) {
+        m_scanner.pauseThread();
+    }
+
     const auto& request      = m_scanRequests.front();
     m_currentRequestId       = request.id;
     m_currentRequestFinished = false;
@@ -335,12 +399,15 @@ void LibraryThreadHandlerPrivate::execNextRequest()
             scanTracks(request);
             break;
         case(ScanRequest::Library):
-            if(request.dirs.isEmpty()) {
-                scanLibrary(request);
+            if(!request.changes.isEmpty()) {
+                scanChanges(request);
             }
-            else {
+            else if(!request.dirs.isEmpty()) {
                 scanDirectory(request);
             }
+            else {
+                scanLibrary(request);
+            }
             break;
         case(ScanRequest::Playlist):
             scanPlaylist(request);
@@ -382,6 +449,11 @@ void LibraryThreadHandlerPrivate::finishScanRequest()
 
     m_currentRequestId = -1;
     execNextRequest();
+
+    if(m_scanRequests.empty()) {
+        startPropertiesTimer();
+        m_maintenanceTimer.start(MaintenanceInterval, m_self);
+    }
 }
 
 void LibraryThreadHandlerPrivate::cancelScanRequest(int id)
@@ -395,6 +467,77 @@ void LibraryThreadHandlerPrivate::cancelScanRequest(int id)
     }
 }
 
+bool LibraryThreadHandlerPrivate::deferAudioProperties() const
+{
+    return m_settings->fileValue(Settings::Core::Internal::LibraryDeferProperties, false).toBool();
+}
+
+void LibraryThreadHandlerPrivate::startPropertiesTimer()
+{
+    // Only tag-only scans leave audio properties to be read later
+    if(deferAudioProperties()) {
+        m_propertiesTimer.start(PropertiesInterval, m_self);
+    }
+}
+
+void LibraryThreadHandlerPrivate::readAudioProperties()
+{
+    if(m_readingProperties || !m_scanRequests.empty() || !deferAudioProperties()) {
+        // Restarted once all requests have finished
+        return;
+    }
+
+    TrackList pendingTracks;
+    std::ranges::copy_if(m_library->tracks(), std::back_inserter(pendingTracks), LibraryScanner::needsAudioProperties);
+    if(pendingTracks.empty()) {
+        return;
+    }
+
+    m_readingProperties = true;
+    QMetaObject::invokeMethod(&m_scanner, [this, pendingTracks]() { m_scanner.readAudioProperties(pendingTracks); });
+}
+
+void LibraryThreadHandlerPrivate::audioPropertiesRead(const TrackList& tracks, bool morePending)
+{
+    m_readingProperties = false;
+
+    if(!tracks.empty()) {
+        emit m_self->tracksUpdated(tracks);
+    }
+
+    if(morePending && m_scanRequests.empty()) {
+        m_propertiesTimer.start(PropertiesBatchInterval, m_self);
+    }
+    else if(m_scanRequests.empty() && !m_maintenanceTimer.isActive()) {
+        m_maintenanceTimer.start(MaintenanceInterval, m_self);
+    }
+}
+
+bool LibraryThreadHandlerPrivate::isIdle() const
+{
+    return m_scanRequests.empty() && !m_readingProperties;
+}
+
+void LibraryThreadHandlerPrivate::runMaintenance()
+{
+    if(!isIdle()) {
+        // Restarted once all requests have finished
+        return;
+    }
+
+    QMetaObject::invokeMethod(&m_maintenance, &DatabaseMaintenance::runMaintenance);
+}
+
+void LibraryThreadHandlerPrivate::maintenanceRan(bool morePending)
+{
+    if(!isIdle()) {
+        return;
+    }
+
+    // Steps are spaced out so other work on the library thread isn't held up
+    m_maintenanceTimer.start(morePending ? MaintenanceStepInterval : MaintenanceInterval, m_self);
+}
+
 LibraryThreadHandler::LibraryThreadHandler(DbConnectionPoolPtr dbPool, MusicLibrary* library,
                                            std::shared_ptr<PlaylistLoader> playlistLoader,
                                            std::shared_ptr<AudioLoader> audioLoader, SettingsManager* settings,
@@ -426,15 +569,42 @@ LibraryThreadHandler::LibraryThreadHandler(DbConnectionPoolPtr dbPool, MusicLibr
                      [this](const LibraryInfo& libraryInfo, const QStringList& dirs) {
                          p->addDirectoryScanRequest(libraryInfo, dirs);
                      });
+    QObject::connect(&p->m_scanner, &LibraryScanner::libraryChanged, this,
+                     [this](const LibraryInfo& libraryInfo, const LibraryChanges& changes) {
+                         p->addChangesScanRequest(libraryInfo, changes);
+                     });
+    QObject::connect(&p->m_scanner, &LibraryScanner::audioPropertiesRead, this,
+                     [this](const TrackList& tracks, bool morePending) {
+                         p->audioPropertiesRead(tracks, morePending);
+                     });
+    QObject::connect(&p->m_maintenance, &DatabaseMaintenance::maintenanceRan, this,
+                     [this](bool morePending) { p->maintenanceRan(morePending); });
 
     QMetaObject::invokeMethod(&p->m_scanner, &Worker::initialiseThread);
     QMetaObject::invokeMethod(&p->m_trackDatabaseManager, &Worker::initialiseThread);
+    QMetaObject::invokeMethod(&p->m_maintenance, &Worker::initialiseThread);
 }
 
 LibraryThreadHandler::~LibraryThreadHandler()
 {
     p->m_scanner.stopThread();
     p->m_trackDatabaseManager.stopThread();
+    p->m_maintenance.stopThread();
+
+    if(p->m_thread.isRunning()) {
+        // Stats still waiting on a timer are saved to the database, but not written to file
+        TrackList pendingStats{p->m_tracksPendingUpdate};
+        pendingStats.insert(pendingStats.end(), p->m_tracksPendingPlaycountUpdate.cbegin(),
+                            p->m_tracksPendingPlaycountUpdate.cend());
+
+        QMetaObject::invokeMethod(
+            &p->m_trackDatabaseManager,
+            [this, pendingStats]() {
+                p->m_trackDatabaseManager.queueTrackStats(pendingStats);
+                p->m_trackDatabaseManager.flushTrackStats();
+            },
+            Qt::BlockingQueuedConnection);
+    }
 
     p->m_thread.quit();
     p->m_thread.wait();
@@ -445,6 +615,13 @@ void LibraryThreadHandler::getAllTracks()
     QMetaObject::invokeMethod(&p->m_trackDatabaseManager, &TrackDatabaseManager::getAllTracks);
 }
 
+void LibraryThreadHandler::libraryLoaded()
+{
+    // Loaded either from the database or the library snapshot
+    p->startPropertiesTimer();
+    p->m_maintenanceTimer.start(MaintenanceInterval, this);
+}
+
 void LibraryThreadHandler::setupWatchers(const LibraryInfoMap& libraries, bool enabled)
 {
     QMetaObject::invokeMethod(&p->m_scanner,
@@ -576,6 +753,14 @@ void LibraryThreadHandler::timerEvent(QTimerEvent* event)
         });
         p->m_tracksPendingPlaycountUpdate.clear();
     }
+    else if(event->timerId() == p->m_propertiesTimer.timerId()) {
+        p->m_propertiesTimer.stop();
+        p->readAudioProperties();
+    }
+    else if(event->timerId() == p->m_maintenanceTimer.timerId()) {
+        p->m_maintenanceTimer.stop();
+        p->runMaintenance();
+    }
 
     QObject::timerEvent(event);
 }
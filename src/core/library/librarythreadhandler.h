@@ -50,6 +50,8 @@ public:
     ~LibraryThreadHandler() override;
 
     void getAllTracks();
+    /** Starts reading deferred audio properties and database maintenance once the library has loaded. */
+    void libraryLoaded();
 
     void setupWatchers(const LibraryInfoMap& libraries, bool enabled);
 
@@ -19,30 +19,46 @@
 
 #include "libraryutils.h"
 
+#include <unordered_map>
+
 namespace Fooyin::Utils {
 std::vector<int> updateCommonTracks(TrackList& tracks, const TrackList& updatedTracks, CommonOperation operation)
 {
     std::vector<int> indexes;
 
-    Fooyin::TrackList result;
+    // Hashed by id so each track is matched in constant time, rather than searching updatedTracks for every track
+    std::unordered_map<int, const Track*> updatedIds;
+    updatedIds.reserve(updatedTracks.size());
+    for(const Track& updatedTrack : updatedTracks) {
+        if(updatedTrack.isInDatabase()) {
+            // The first occurrence takes precedence
+            updatedIds.emplace(updatedTrack.id(), &updatedTrack);
+        }
+    }
+
+    if(updatedIds.empty()) {
+        return indexes;
+    }
+
+    TrackList result;
     result.reserve(tracks.size());
 
-    for(auto trackIt{tracks.begin()}; trackIt != tracks.end(); ++trackIt) {
-        auto updatedIt = std::ranges::find_if(updatedTracks, [&trackIt](const Fooyin::Track& updatedTrack) {
-            return updatedTrack.isInDatabase() && trackIt->id() == updatedTrack.id();
-        });
-        if(updatedIt != updatedTracks.end()) {
-            indexes.push_back(static_cast<int>(std::distance(tracks.begin(), trackIt)));
+    for(size_t i{0}; i < tracks.size(); ++i) {
+        const Track& track = tracks.at(i);
+
+        const auto updatedIt = updatedIds.find(track.id());
+        if(updatedIt != updatedIds.cend()) {
+            indexes.push_back(static_cast<int>(i));
             if(operation == CommonOperation::Update) {
-                result.push_back(*updatedIt);
+                result.push_back(*updatedIt->second);
             }
         }
         else {
-            result.push_back(*trackIt);
+            result.push_back(track);
         }
     }
 
-    tracks = result;
+    tracks = std::move(result);
     return indexes;
 }
 } // namespace Fooyin::Utils
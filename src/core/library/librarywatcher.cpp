@@ -19,9 +19,33 @@
 
 #include "librarywatcher.h"
 
-#include <QTimer>
+#include <utils/fileutils.h>
+
+#include <QDir>
+#include <QDirIterator>
+#include <QFileSystemWatcher>
+#include <QLoggingCategory>
 #include <QTimerEvent>
 
+#ifdef Q_OS_LINUX
+#include <QSocketNotifier>
+
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#endif
+
+#include <algorithm>
+#include <map>
+#include <optional>
+#include <ranges>
+#include <set>
+#include <unordered_map>
+
+Q_LOGGING_CATEGORY(LIB_WATCHER, "fy.watcher")
+
 using namespace std::chrono_literals;
 
 #if QT_VERSION >= QT_VERSION_CHECK(6, 5, 0)
@@ -30,26 +54,525 @@ constexpr auto Interval = 1000ms;
 constexpr auto Interval = 1000;
 #endif
 
+#ifdef Q_OS_LINUX
+constexpr uint32_t WatchMask
+    = IN_CREATE | IN_CLOSE_WRITE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_ONLYDIR;
+#endif
+
+namespace {
+bool isWithin(const QString& path, const QString& dir)
+{
+    return path.size() > dir.size() && path.at(dir.size()) == u'/' && path.startsWith(dir);
+}
+
+bool isSameOrWithin(const QString& path, const QString& dir)
+{
+    return path == dir || isWithin(path, dir);
+}
+
+QString replacePrefix(const QString& path, const QString& from, const QString& to)
+{
+    return to + path.sliced(from.size());
+}
+
+template <typename T>
+void renameKeys(std::map<QString, T>& map, const QString& from, const QString& to)
+{
+    std::vector<std::pair<QString, T>> renamed;
+
+    for(auto it = map.begin(); it != map.end();) {
+        if(isSameOrWithin(it->first, from)) {
+            renamed.emplace_back(replacePrefix(it->first, from, to), std::move(it->second));
+            it = map.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+
+    for(auto& [key, value] : renamed) {
+        map.insert_or_assign(key, std::move(value));
+    }
+}
+} // namespace
+
 namespace Fooyin {
-LibraryWatcher::LibraryWatcher(QObject* parent)
-    : QFileSystemWatcher{parent}
+// Coalesces the file events received within the debounce interval
+class ChangeSet
+{
+public:
+    void fileCreated(const QString& path);
+    void fileModified(const QString& path);
+    void fileRemoved(const QString& path);
+    void fileMoved(const QString& from, const QString& to);
+    void dirRemoved(const QString& path);
+    void dirMoved(const QString& from, const QString& to);
+
+    [[nodiscard]] bool isEmpty() const;
+    LibraryChanges take();
+
+private:
+    enum class State : uint8_t
+    {
+        Created = 0,
+        Modified,
+        Removed,
+    };
+
+    std::map<QString, State> m_files;
+    // Destination -> original path
+    std::map<QString, QString> m_moves;
+    QStringList m_removedDirs;
+    std::vector<std::pair<QString, QString>> m_movedDirs;
+};
+
+void ChangeSet::fileCreated(const QString& path)
+{
+    const auto fileIt = m_files.find(path);
+    if(fileIt == m_files.end()) {
+        m_files.emplace(path, State::Created);
+    }
+    else if(fileIt->second == State::Removed) {
+        // Replaced
+        fileIt->second = State::Modified;
+    }
+}
+
+void ChangeSet::fileModified(const QString& path)
+{
+    const auto fileIt = m_files.find(path);
+    if(fileIt == m_files.end()) {
+        m_files.emplace(path, State::Modified);
+    }
+    else if(fileIt->second == State::Removed) {
+        fileIt->second = State::Modified;
+    }
+}
+
+void ChangeSet::fileRemoved(const QString& path)
+{
+    if(const auto moveIt = m_moves.find(path); moveIt != m_moves.end()) {
+        // Moved then removed, so it's the original file which has gone
+        m_files.insert_or_assign(moveIt->second, State::Removed);
+        m_files.erase(path);
+        m_moves.erase(moveIt);
+        return;
+    }
+
+    const auto fileIt = m_files.find(path);
+    if(fileIt != m_files.end() && fileIt->second == State::Created) {
+        m_files.erase(fileIt);
+        return;
+    }
+
+    m_files.insert_or_assign(path, State::Removed);
+}
+
+void ChangeSet::fileMoved(const QString& from, const QString& to)
+{
+    QString origin{from};
+    if(const auto moveIt = m_moves.find(from); moveIt != m_moves.end()) {
+        origin = moveIt->second;
+        m_moves.erase(moveIt);
+    }
+
+    std::optional<State> state;
+    if(const auto fileIt = m_files.find(from); fileIt != m_files.end() && fileIt->second != State::Removed) {
+        state = fileIt->second;
+        m_files.erase(fileIt);
+    }
+
+    // Anything but a new file may already be in the library under its original path
+    if(state != State::Created && origin != to) {
+        m_moves.insert_or_assign(to, origin);
+    }
+
+    const auto toIt = m_files.find(to);
+    if(toIt != m_files.end() && toIt->second == State::Removed) {
+        // Replaced an existing file
+        toIt->second = State::Modified;
+    }
+    else if(state) {
+        m_files.insert_or_assign(to, state == State::Created ? State::Created : State::Modified);
+    }
+}
+
+void ChangeSet::dirRemoved(const QString& path)
+{
+    for(auto it = m_moves.begin(); it != m_moves.end();) {
+        if(isWithin(it->first, path)) {
+            if(!isWithin(it->second, path)) {
+                m_files.insert_or_assign(it->second, State::Removed);
+            }
+            it = m_moves.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+
+    std::erase_if(m_files, [&path](const auto& file) { return isWithin(file.first, path); });
+
+    m_removedDirs.append(path);
+}
+
+void ChangeSet::dirMoved(const QString& from, const QString& to)
+{
+    renameKeys(m_files, from, to);
+    renameKeys(m_moves, from, to);
+
+    for(auto& movedDir : m_movedDirs) {
+        if(isSameOrWithin(movedDir.second, from)) {
+            movedDir.second = replacePrefix(movedDir.second, from, to);
+        }
+    }
+
+    m_movedDirs.emplace_back(from, to);
+}
+
+bool ChangeSet::isEmpty() const
+{
+    return m_files.empty() && m_moves.empty() && m_removedDirs.empty() && m_movedDirs.empty();
+}
+
+LibraryChanges ChangeSet::take()
 {
-    QObject::connect(this, &QFileSystemWatcher::directoryChanged, this, [this](const QString& path) {
-        m_dirs.emplace(path);
-        m_timer.start(Interval, this);
+    LibraryChanges changes;
+
+    for(const auto& [path, state] : m_files) {
+        if(state == State::Removed) {
+            changes.removed.append(path);
+        }
+        else {
+            changes.modified.append(path);
+        }
+    }
+
+    for(const auto& [to, from] : m_moves) {
+        changes.moved.emplace_back(from, to);
+    }
+
+    changes.removedDirs = std::exchange(m_removedDirs, {});
+    changes.movedDirs   = std::exchange(m_movedDirs, {});
+
+    m_files.clear();
+    m_moves.clear();
+
+    return changes;
+}
+
+class LibraryWatcherPrivate
+{
+public:
+    explicit LibraryWatcherPrivate(LibraryWatcher* self);
+    ~LibraryWatcherPrivate();
+
+    [[nodiscard]] bool usesInotify() const;
+
+    void addDirectory(const QString& path);
+    void changed();
+    void flush();
+
+#ifdef Q_OS_LINUX
+    void addWatch(const QString& dir);
+    void removeWatches(const QString& dir);
+    void renameWatches(const QString& from, const QString& to);
+
+    void readEvents();
+    void handleEvent(const inotify_event& event);
+#endif
+
+    LibraryWatcher* m_self;
+
+    QStringList m_roots;
+    ChangeSet m_changes;
+    std::set<QString> m_changedDirs;
+
+    QFileSystemWatcher m_watcher;
+
+#ifdef Q_OS_LINUX
+    int m_fd{-1};
+    std::unique_ptr<QSocketNotifier> m_notifier;
+    std::unordered_map<int, QString> m_watches;
+    // Unpaired IN_MOVED_FROM events by cookie (path, is directory)
+    std::unordered_map<uint32_t, std::pair<QString, bool>> m_pendingMoves;
+    bool m_overflowed{false};
+    bool m_watchLimitReached{false};
+#endif
+};
+
+LibraryWatcherPrivate::LibraryWatcherPrivate(LibraryWatcher* self)
+    : m_self{self}
+{
+#ifdef Q_OS_LINUX
+    m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if(m_fd >= 0) {
+        m_notifier = std::make_unique<QSocketNotifier>(m_fd, QSocketNotifier::Read);
+        QObject::connect(m_notifier.get(), &QSocketNotifier::activated, m_self, [this]() { readEvents(); });
+        return;
+    }
+    qCWarning(LIB_WATCHER) << "Failed to initialise inotify:" << std::strerror(errno);
+#endif
+
+    QObject::connect(&m_watcher, &QFileSystemWatcher::directoryChanged, m_self, [this](const QString& path) {
+        m_changedDirs.emplace(path);
+        changed();
     });
 }
 
+LibraryWatcherPrivate::~LibraryWatcherPrivate()
+{
+#ifdef Q_OS_LINUX
+    m_notifier.reset();
+    if(m_fd >= 0) {
+        close(m_fd);
+    }
+#endif
+}
+
+bool LibraryWatcherPrivate::usesInotify() const
+{
+#ifdef Q_OS_LINUX
+    return m_fd >= 0;
+#else
+    return false;
+#endif
+}
+
+void LibraryWatcherPrivate::addDirectory(const QString& path)
+{
+#ifdef Q_OS_LINUX
+    if(usesInotify()) {
+        addWatch(path);
+        QDirIterator dirIt{path, QDir::Dirs | QDir::NoDotAndDotDot,
+                           QDirIterator::Subdirectories | QDirIterator::FollowSymlinks};
+        while(dirIt.hasNext()) {
+            addWatch(dirIt.next());
+        }
+        return;
+    }
+#endif
+
+    QStringList dirs = Utils::File::getAllSubdirectories(path);
+    dirs.append(path);
+    m_watcher.addPaths(dirs);
+}
+
+void LibraryWatcherPrivate::changed()
+{
+    m_self->m_timer.start(Interval, m_self);
+}
+
+void LibraryWatcherPrivate::flush()
+{
+#ifdef Q_OS_LINUX
+    // Anything moved out of the library won't be paired now
+    for(const auto& [path, isDir] : m_pendingMoves | std::views::values) {
+        if(isDir) {
+            removeWatches(path);
+            m_changes.dirRemoved(path);
+        }
+        else {
+            m_changes.fileRemoved(path);
+        }
+    }
+    m_pendingMoves.clear();
+
+    if(std::exchange(m_overflowed, false)) {
+        qCInfo(LIB_WATCHER) << "Events were lost; rescanning" << m_roots;
+        m_changes.take();
+        m_changedDirs.clear();
+        emit m_self->libraryDirsChanged(m_roots);
+        return;
+    }
+#endif
+
+    if(!m_changes.isEmpty()) {
+        emit m_self->libraryChanged(m_changes.take());
+    }
+
+    if(!m_changedDirs.empty()) {
+        const QStringList dirs{m_changedDirs.cbegin(), m_changedDirs.cend()};
+        m_changedDirs.clear();
+
+        if(!usesInotify()) {
+            // Watch any new subdirectories
+            std::ranges::for_each(dirs, [this](const QString& dir) { addDirectory(dir); });
+        }
+
+        emit m_self->libraryDirsChanged(dirs);
+    }
+}
+
+#ifdef Q_OS_LINUX
+void LibraryWatcherPrivate::addWatch(const QString& dir)
+{
+    const int wd = inotify_add_watch(m_fd, QFile::encodeName(dir).constData(), WatchMask);
+    if(wd < 0) {
+        if(errno == ENOSPC && !std::exchange(m_watchLimitReached, true)) {
+            qCWarning(LIB_WATCHER) << "Unable to watch all library directories: the inotify watch limit has been "
+                                      "reached (fs.inotify.max_user_watches)";
+        }
+        return;
+    }
+
+    m_watches.insert_or_assign(wd, dir);
+}
+
+void LibraryWatcherPrivate::removeWatches(const QString& dir)
+{
+    for(auto it = m_watches.begin(); it != m_watches.end();) {
+        if(isSameOrWithin(it->second, dir)) {
+            inotify_rm_watch(m_fd, it->first);
+            it = m_watches.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+void LibraryWatcherPrivate::renameWatches(const QString& from, const QString& to)
+{
+    // Watches follow the directory, so only their paths need updating
+    for(auto& path : m_watches | std::views::values) {
+        if(isSameOrWithin(path, from)) {
+            path = replacePrefix(path, from, to);
+        }
+    }
+
+    std::set<QString> changedDirs;
+    for(const QString& dir : m_changedDirs) {
+        changedDirs.emplace(isSameOrWithin(dir, from) ? replacePrefix(dir, from, to) : dir);
+    }
+    m_changedDirs = std::move(changedDirs);
+}
+
+void LibraryWatcherPrivate::readEvents()
+{
+    alignas(inotify_event) char buffer[16384];
+
+    while(true) {
+        const ssize_t length = read(m_fd, buffer, sizeof(buffer));
+        if(length <= 0) {
+            break;
+        }
+
+        for(const char* ptr = buffer; ptr < buffer + length;) {
+            const auto* event = reinterpret_cast<const inotify_event*>(ptr);
+            handleEvent(*event);
+            ptr += sizeof(inotify_event) + event->len;
+        }
+    }
+
+    changed();
+}
+
+void LibraryWatcherPrivate::handleEvent(const inotify_event& event)
+{
+    if(event.mask & IN_Q_OVERFLOW) {
+        m_overflowed = true;
+        return;
+    }
+
+    const auto watchIt = m_watches.find(event.wd);
+    if(watchIt == m_watches.end()) {
+        return;
+    }
+
+    if(event.mask & IN_IGNORED) {
+        m_watches.erase(watchIt);
+        return;
+    }
+
+    // Deletions are reported by the parent directory
+    if(event.len == 0 || (event.mask & IN_DELETE_SELF)) {
+        return;
+    }
+
+    const QString name = QFile::decodeName(event.name);
+    // Hidden files, including the temporary files of most tag editors
+    if(name.startsWith(u'.')) {
+        return;
+    }
+
+    const QString path = watchIt->second + u'/' + name;
+    const bool isDir   = event.mask & IN_ISDIR;
+
+    if(event.mask & IN_CREATE) {
+        if(isDir) {
+            // Files may have been added before the watch was, so scan the whole directory
+            addDirectory(path);
+            m_changedDirs.emplace(path);
+        }
+        else {
+            m_changes.fileCreated(path);
+        }
+    }
+    else if(event.mask & IN_CLOSE_WRITE) {
+        m_changes.fileModified(path);
+    }
+    else if(event.mask & IN_DELETE) {
+        if(isDir) {
+            m_changes.dirRemoved(path);
+        }
+        else {
+            m_changes.fileRemoved(path);
+        }
+    }
+    else if(event.mask & IN_MOVED_FROM) {
+        m_pendingMoves.insert_or_assign(event.cookie, std::pair{path, isDir});
+    }
+    else if(event.mask & IN_MOVED_TO) {
+        if(const auto moveIt = m_pendingMoves.find(event.cookie); moveIt != m_pendingMoves.end()) {
+            const QString from = moveIt->second.first;
+            m_pendingMoves.erase(moveIt);
+
+            if(isDir) {
+                renameWatches(from, path);
+                m_changes.dirMoved(from, path);
+            }
+            else {
+                m_changes.fileMoved(from, path);
+            }
+        }
+        // Moved in from outside the library
+        else if(isDir) {
+            addDirectory(path);
+            m_changedDirs.emplace(path);
+        }
+        else {
+            m_changes.fileCreated(path);
+        }
+    }
+}
+#endif
+
+LibraryWatcher::LibraryWatcher(QObject* parent)
+    : QObject{parent}
+    , p{std::make_unique<LibraryWatcherPrivate>(this)}
+{ }
+
+LibraryWatcher::~LibraryWatcher() = default;
+
+void LibraryWatcher::addRoot(const QString& path)
+{
+    const QString root = QDir::cleanPath(path);
+    if(p->m_roots.contains(root)) {
+        return;
+    }
+
+    p->m_roots.append(root);
+    p->addDirectory(root);
+}
+
 void LibraryWatcher::timerEvent(QTimerEvent* event)
 {
     if(event->timerId() == m_timer.timerId()) {
         m_timer.stop();
-
-        const QStringList paths{m_dirs.cbegin(), m_dirs.cend()};
-        m_dirs.clear();
-        emit libraryDirsChanged(paths);
+        p->flush();
     }
-    QFileSystemWatcher::timerEvent(event);
+    QObject::timerEvent(event);
 }
 } // namespace Fooyin
 
@@ -20,26 +20,66 @@
 #pragma once
 
 #include <QBasicTimer>
-#include <QFileSystemWatcher>
+#include <QObject>
+#include <QStringList>
 
-#include <set>
+#include <memory>
+#include <vector>
 
 namespace Fooyin {
-class LibraryWatcher : public QFileSystemWatcher
+class LibraryWatcherPrivate;
+
+/*!
+ * File level changes to a library, coalesced over the watcher's debounce interval.
+ */
+struct LibraryChanges
+{
+    // Files created or modified
+    QStringList modified;
+    QStringList removed;
+    // Files moved within the library (from, to)
+    std::vector<std::pair<QString, QString>> moved;
+
+    QStringList removedDirs;
+    // Directories moved within the library (from, to)
+    std::vector<std::pair<QString, QString>> movedDirs;
+
+    [[nodiscard]] bool isEmpty() const
+    {
+        return modified.empty() && removed.empty() && moved.empty() && removedDirs.empty() && movedDirs.empty();
+    }
+};
+
+/*!
+ * Recursively watches library directories.
+ * On Linux, changes are reported per file using inotify. Elsewhere, and whenever
+ * events have been lost, changed directories are reported to be rescanned instead.
+ */
+class LibraryWatcher : public QObject
 {
     Q_OBJECT
 
 public:
     explicit LibraryWatcher(QObject* parent = nullptr);
+    ~LibraryWatcher() override;
+
+    /*!
+     * Watches @p path and all of its subdirectories.
+     * New subdirectories are watched automatically.
+     */
+    void addRoot(const QString& path);
 
 signals:
     void libraryDirsChanged(const QStringList& paths);
+    void libraryChanged(const Fooyin::LibraryChanges& changes);
 
 protected:
     void timerEvent(QTimerEvent* event) override;
 
 private:
+    friend class LibraryWatcherPrivate;
+
+    std::unique_ptr<LibraryWatcherPrivate> p;
     QBasicTimer m_timer;
-    std::set<QString> m_dirs;
 };
 } // namespace Fooyin
@@ -0,0 +1,157 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "scanbenchmark.h"
+
+#include "corepaths.h"
+#include "database/database.h"
+#include "database/librarydatabase.h"
+#include "engine/archiveinput.h"
+#include "engine/ffmpeg/ffmpeginput.h"
+#include "engine/taglibparser.h"
+#include "internalcoresettings.h"
+#include "libraryscanner.h"
+#include "playlist/parsers/cueparser.h"
+#include "playlist/playlistloader.h"
+#include "plugins/pluginmanager.h"
+
+#include <core/engine/audioloader.h>
+#include <core/engine/inputplugin.h>
+#include <utils/database/dbconnectionprovider.h>
+#include <utils/settings/settingsmanager.h>
+
+#include <QFileInfo>
+#include <QLoggingCategory>
+#include <QTemporaryDir>
+
+Q_LOGGING_CATEGORY(SCAN_BENCH, "fy.scanbenchmark")
+
+using namespace Qt::StringLiterals;
+
+namespace Fooyin {
+class ScanBenchmarkPrivate
+{
+public:
+    ScanBenchmarkPrivate();
+
+    void registerInputs();
+    void loadPlugins();
+
+    SettingsManager m_settings;
+    CoreSettings m_coreSettings;
+    PluginManager m_pluginManager;
+    std::shared_ptr<AudioLoader> m_audioLoader;
+    std::shared_ptr<PlaylistLoader> m_playlistLoader;
+};
+
+ScanBenchmarkPrivate::ScanBenchmarkPrivate()
+    : m_settings{Core::settingsPath()}
+    , m_coreSettings{&m_settings}
+    , m_pluginManager{&m_settings}
+    , m_audioLoader{std::make_shared<AudioLoader>()}
+    , m_playlistLoader{std::make_shared<PlaylistLoader>()}
+{
+    registerInputs();
+    loadPlugins();
+
+    // Use the same reader order as the application
+    m_audioLoader->restoreState();
+
+    m_playlistLoader->addParser(std::make_unique<CueParser>(m_audioLoader));
+}
+
+void ScanBenchmarkPrivate::registerInputs()
+{
+    m_audioLoader->addDecoder(u"Archive"_s, [this]() { return std::make_unique<ArchiveDecoder>(m_audioLoader); });
+    m_audioLoader->addReader(u"Archive"_s, [this]() { return std::make_unique<GeneralArchiveReader>(m_audioLoader); });
+    m_audioLoader->addReader(u"TagLib"_s, {[]() {
+                                 return std::make_unique<TagLibReader>();
+                             }});
+    m_audioLoader->addReader(u"FFmpeg"_s, {[]() {
+                                 return std::make_unique<FFmpegReader>();
+                             }},
+                             99);
+}
+
+void ScanBenchmarkPrivate::loadPlugins()
+{
+    m_pluginManager.findPlugins(Core::pluginPaths());
+    m_pluginManager.loadPlugins();
+
+    // Only readers are needed to scan
+    m_pluginManager.initialisePlugins<InputPlugin>([this](InputPlugin* plugin) {
+        const auto creator = plugin->inputCreator();
+        if(creator.reader) {
+            m_audioLoader->addReader(plugin->inputName(), creator.reader);
+        }
+        if(creator.archiveReader) {
+            m_audioLoader->addArchiveReader(plugin->inputName(), creator.archiveReader);
+        }
+    });
+}
+
+ScanBenchmark::ScanBenchmark()
+    : p{std::make_unique<ScanBenchmarkPrivate>()}
+{ }
+
+ScanBenchmark::~ScanBenchmark() = default;
+
+std::optional<ScanStats> ScanBenchmark::run(const QString& path)
+{
+    const QFileInfo info{path};
+    if(!info.isDir()) {
+        qCWarning(SCAN_BENCH) << "Not a directory:" << path;
+        return {};
+    }
+
+    const QTemporaryDir tempDir;
+    if(!tempDir.isValid()) {
+        qCWarning(SCAN_BENCH) << "Failed to create temporary directory:" << tempDir.errorString();
+        return {};
+    }
+
+    const Database database{tempDir.filePath(u"fooyin.db"_s), u"fooyin_benchmark"_s};
+    if(database.status() != Database::Status::Ok) {
+        qCWarning(SCAN_BENCH) << "Failed to create database in" << tempDir.path();
+        return {};
+    }
+
+    LibraryDatabase libraryDatabase;
+    libraryDatabase.initialise(DbConnectionProvider{database.connectionPool()});
+
+    LibraryInfo library;
+    library.name = u"Benchmark"_s;
+    library.path = info.canonicalFilePath();
+    library.id   = libraryDatabase.insertLibrary(library.path, library.name);
+
+    if(library.id < 0) {
+        qCWarning(SCAN_BENCH) << "Failed to add library" << library.path;
+        return {};
+    }
+
+    qCInfo(SCAN_BENCH) << "Scanning" << library.path << "into" << tempDir.path();
+
+    // Run on this thread, so the stats can be read back directly
+    LibraryScanner scanner{database.connectionPool(), p->m_playlistLoader, p->m_audioLoader, &p->m_settings};
+    scanner.initialiseThread();
+    scanner.scanLibrary(library, {}, false);
+
+    return scanner.stats();
+}
+} // namespace Fooyin
@@ -0,0 +1,51 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "fycore_export.h"
+
+#include "scanstats.h"
+
+#include <memory>
+#include <optional>
+
+namespace Fooyin {
+class ScanBenchmarkPrivate;
+
+/*!
+ * Runs the library scanner on its own, without starting the rest of the application.
+ * Tracks are stored in a temporary database which is removed once the scan is complete.
+ */
+class FYCORE_EXPORT ScanBenchmark
+{
+public:
+    ScanBenchmark();
+    ~ScanBenchmark();
+
+    /*!
+     * Scans @p path as a new library, using the same readers and settings as the application.
+     * @returns the stats of the scan, or std::nullopt if the scan could not be started.
+     */
+    [[nodiscard]] std::optional<ScanStats> run(const QString& path);
+
+private:
+    std::unique_ptr<ScanBenchmarkPrivate> p;
+};
+} // namespace Fooyin
@@ -0,0 +1,102 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "scanstats.h"
+
+#include <QStringList>
+
+#include <ranges>
+
+using namespace Qt::StringLiterals;
+
+constexpr auto BytesPerMegabyte = 1024.0 * 1024.0;
+
+namespace {
+double toSeconds(Fooyin::ScanStats::Duration duration)
+{
+    return std::chrono::duration<double>(duration).count();
+}
+
+QString formatStage(const QString& name, Fooyin::ScanStats::Duration duration, Fooyin::ScanStats::Duration total)
+{
+    const double percent = total.count() > 0 ? 100.0 * toSeconds(duration) / toSeconds(total) : 0.0;
+    return u"  %1 %2 s (%3%)"_s.arg(name, -12).arg(toSeconds(duration), 9, 'f', 3).arg(percent, 5, 'f', 1);
+}
+} // namespace
+
+namespace Fooyin {
+ScanStats::Duration ScanStats::tagParse() const
+{
+    Duration time{0};
+    for(const auto& reader : readers | std::views::values) {
+        time += reader.time;
+    }
+    return time;
+}
+
+uint64_t ScanStats::bytesRead() const
+{
+    uint64_t bytes{0};
+    for(const auto& reader : readers | std::views::values) {
+        bytes += reader.bytes;
+    }
+    return bytes;
+}
+
+double ScanStats::filesPerSecond() const
+{
+    const double seconds = toSeconds(total);
+    return seconds > 0 ? static_cast<double>(files) / seconds : 0.0;
+}
+
+double ScanStats::megabytesPerSecond() const
+{
+    const double seconds = toSeconds(total);
+    return seconds > 0 ? static_cast<double>(bytesRead()) / BytesPerMegabyte / seconds : 0.0;
+}
+
+QString ScanStats::report() const
+{
+    QStringList lines;
+
+    lines.append(u"Scanned %1 files in %2 s using %3 read threads"_s.arg(files)
+                     .arg(toSeconds(total), 0, 'f', 3)
+                     .arg(readThreads));
+    lines.append(u"  Directories:  %1 (%2 unchanged)"_s.arg(directories).arg(skippedDirectories));
+    lines.append(u"  Tracks:       %1 added, %2 updated"_s.arg(tracksAdded).arg(tracksUpdated));
+    lines.append(u"  Throughput:   %1 files/s, %2 MB/s"_s.arg(filesPerSecond(), 0, 'f', 1)
+                     .arg(megabytesPerSecond(), 0, 'f', 2));
+
+    lines.append(formatStage(u"Enumerate"_s, enumerate, total));
+    lines.append(formatStage(u"Stat"_s, stat, total));
+    lines.append(formatStage(u"Tag parse"_s, tagParse(), total));
+    for(const auto& [name, reader] : readers) {
+        lines.append(u"    %1 %2 files, %3 MB, %4 s"_s.arg(name, -10)
+                         .arg(reader.files)
+                         .arg(static_cast<double>(reader.bytes) / BytesPerMegabyte, 0, 'f', 1)
+                         .arg(toSeconds(reader.time), 0, 'f', 3));
+    }
+    lines.append(formatStage(u"Hash"_s, hash, total));
+    lines.append(formatStage(u"DB store"_s, store, total));
+    lines.append(formatStage(u"DB update"_s, update, total));
+    lines.append(formatStage(u"scanUpdate"_s, emitUpdate, total));
+
+    return lines.join(u'\n');
+}
+} // namespace Fooyin
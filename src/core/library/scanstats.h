@@ -0,0 +1,73 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "fycore_export.h"
+
+#include <QString>
+
+#include <chrono>
+#include <map>
+
+namespace Fooyin {
+/*!
+ * Time spent in each stage of a library scan.
+ * Stages run by the read pool are summed across threads, so may exceed the total.
+ */
+struct FYCORE_EXPORT ScanStats
+{
+    using Duration = std::chrono::nanoseconds;
+
+    struct ReaderStats
+    {
+        uint64_t files{0};
+        uint64_t bytes{0};
+        Duration time{0};
+    };
+
+    Duration total{0};
+    // Walking directories, excluding the time spent reading the files found
+    Duration enumerate{0};
+    // Querying file sizes and modification times
+    Duration stat{0};
+    Duration hash{0};
+    Duration store{0};
+    Duration update{0};
+    // Emitting scanUpdate
+    Duration emitUpdate{0};
+    // Tag parsing, keyed by reader name
+    std::map<QString, ReaderStats> readers;
+
+    uint64_t directories{0};
+    uint64_t skippedDirectories{0};
+    uint64_t files{0};
+    uint64_t tracksAdded{0};
+    uint64_t tracksUpdated{0};
+    int readThreads{1};
+
+    [[nodiscard]] Duration tagParse() const;
+    [[nodiscard]] uint64_t bytesRead() const;
+
+    [[nodiscard]] double filesPerSecond() const;
+    [[nodiscard]] double megabytesPerSecond() const;
+
+    [[nodiscard]] QString report() const;
+};
+} // namespace Fooyin
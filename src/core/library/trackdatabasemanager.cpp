@@ -22,6 +22,7 @@
 #include "database/trackdatabase.h"
 #include "internalcoresettings.h"
 
+#include <core/corepaths.h>
 #include <core/coresettings.h>
 #include <core/engine/audioloader.h>
 #include <core/library/musiclibrary.h>
@@ -33,14 +34,27 @@
 
 #include <QFileInfo>
 #include <QLoggingCategory>
+#include <QTimerEvent>
 #include <QString>
 #include <QVector>
 
 #include <atomic>
 #include <numeric>
+#include <optional>
+#include <utility>
 
 Q_LOGGING_CATEGORY(TRK_DBMAN, "fy.trackdbmanager")
 
+using namespace std::chrono_literals;
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 5, 0)
+constexpr auto StatsFlushInterval = 5s;
+#else
+constexpr auto StatsFlushInterval = 5000;
+#endif
+// Queued stats written straight away once reached
+constexpr auto MaxQueuedStats = 500;
+
 namespace Fooyin {
 TrackDatabaseManager::TrackDatabaseManager(DbConnectionPoolPtr dbPool, std::shared_ptr<AudioLoader> audioLoader,
                                            SettingsManager* settings, QObject* parent)
@@ -48,7 +62,32 @@ TrackDatabaseManager::TrackDatabaseManager(DbConnectionPoolPtr dbPool, std::shar
     , m_dbPool{std::move(dbPool)}
     , m_audioLoader{std::move(audioLoader)}
     , m_settings{settings}
-{ }
+    , m_statsQueue{Core::trackStatsJournalPath()}
+{
+    Track::setDeferredLoader([dbPool = std::weak_ptr{m_dbPool}](const TrackIds& ids, TrackList& tracks) {
+        const auto pool = dbPool.lock();
+        if(!pool) {
+            return false;
+        }
+
+        // Called from whichever thread first reads a deferred field, so reuse its connection if it has one.
+        // A read-only provider falls back to the thread's read-write connection.
+        std::optional<DbConnectionHandler> dbHandler;
+        if(!pool->hasThreadConnection(DbConnection::Mode::ReadWrite)
+           && !pool->hasThreadConnection(DbConnection::Mode::ReadOnly)) {
+            dbHandler.emplace(pool, DbConnection::Mode::ReadOnly);
+        }
+
+        TrackDatabase trackDatabase;
+        trackDatabase.initialise(DbConnectionProvider{pool, DbConnection::Mode::ReadOnly});
+        return trackDatabase.loadDeferredFields(ids, tracks);
+    });
+}
+
+TrackDatabaseManager::~TrackDatabaseManager()
+{
+    Track::setDeferredLoader({});
+}
 
 void TrackDatabaseManager::initialiseThread()
 {
@@ -56,6 +95,10 @@ void TrackDatabaseManager::initialiseThread()
 
     m_dbHandler = std::make_unique<DbConnectionHandler>(m_dbPool);
     m_trackDatabase.initialise(DbConnectionProvider{m_dbPool});
+
+    // Left over if the last session exited before writing them
+    m_statsQueue.restore();
+    flushTrackStats();
 }
 
 void TrackDatabaseManager::getAllTracks()
@@ -77,9 +120,15 @@ void TrackDatabaseManager::updateTracks(const TrackList& tracks, bool write)
 {
     setState(Running);
 
+    // Stats are written below, so earlier queued stats mustn't be written after them
+    flushTrackStats();
+
     TrackList tracksToUpdate{tracks};
     TrackList tracksUpdated;
 
+    // Load in one go rather than per track while writing
+    Track::loadDeferredFields(tracksToUpdate);
+
     AudioReader::WriteOptions options;
 
     if(write) {
@@ -155,6 +204,9 @@ void TrackDatabaseManager::updateTrackStats(const TrackList& tracks, bool onlyPl
     TrackList tracksToUpdate{tracks};
     TrackList tracksUpdated;
 
+    // Load in one go rather than per track while writing
+    Track::loadDeferredFields(tracksToUpdate);
+
     AudioReader::WriteOptions options;
     if(m_settings->value<Settings::Core::SaveRatingToMetadata>()) {
         options |= AudioReader::Rating;
@@ -179,7 +231,7 @@ void TrackDatabaseManager::updateTrackStats(const TrackList& tracks, bool onlyPl
         if(!track.isInArchive() && writeToFile) {
             success = m_audioLoader->writeTrackMetadata(updatedTrack, options);
         }
-        if(success && m_trackDatabase.updateTrackStats(updatedTrack)) {
+        if(success) {
             const QDateTime modifiedTime = QFileInfo{updatedTrack.filepath()}.lastModified();
             updatedTrack.setModifiedTime(modifiedTime.isValid() ? modifiedTime.toMSecsSinceEpoch() : 0);
             tracksUpdated.push_back(updatedTrack);
@@ -190,12 +242,44 @@ void TrackDatabaseManager::updateTrackStats(const TrackList& tracks, bool onlyPl
     }
 
     if(!tracksUpdated.empty()) {
+        queueTrackStats(tracksUpdated);
         emit updatedTracksStats(tracksUpdated);
     }
 
     setState(Idle);
 }
 
+void TrackDatabaseManager::queueTrackStats(const TrackList& tracks)
+{
+    m_statsQueue.add(tracks);
+
+    if(std::cmp_greater_equal(m_statsQueue.size(), MaxQueuedStats)) {
+        flushTrackStats();
+    }
+    else if(!m_statsTimer.isActive()) {
+        m_statsTimer.start(StatsFlushInterval, this);
+    }
+}
+
+void TrackDatabaseManager::flushTrackStats()
+{
+    m_statsTimer.stop();
+
+    if(!m_statsQueue.flush(m_trackDatabase)) {
+        // Kept queued and journalled until the next attempt
+        m_statsTimer.start(StatsFlushInterval, this);
+    }
+}
+
+void TrackDatabaseManager::timerEvent(QTimerEvent* event)
+{
+    if(event->timerId() == m_statsTimer.timerId()) {
+        flushTrackStats();
+    }
+
+    Worker::timerEvent(event);
+}
+
 void TrackDatabaseManager::writeCovers(const TrackCoverData& tracks)
 {
     setState(Running);
@@ -20,10 +20,12 @@
 #pragma once
 
 #include "database/trackdatabase.h"
+#include "trackstatsqueue.h"
 
 #include <utils/database/dbconnectionhandler.h>
 #include <utils/worker.h>
 
+#include <QBasicTimer>
 #include <QString>
 
 namespace Fooyin {
@@ -39,6 +41,7 @@ class TrackDatabaseManager : public Worker
 public:
     explicit TrackDatabaseManager(DbConnectionPoolPtr dbPool, std::shared_ptr<AudioLoader> audioLoader,
                                   SettingsManager* settings, QObject* parent = nullptr);
+    ~TrackDatabaseManager() override;
 
     void initialiseThread() override;
 
@@ -53,10 +56,16 @@ public slots:
     void getAllTracks();
     void updateTracks(const Fooyin::TrackList& tracks, bool write);
     void updateTrackStats(const Fooyin::TrackList& track, bool onlyPlaycount);
+    /** Queues the stats of @p tracks to be written to the database, without writing them to file. */
+    void queueTrackStats(const Fooyin::TrackList& tracks);
+    void flushTrackStats();
     void writeCovers(const Fooyin::TrackCoverData& tracks);
     void removeUnavailbleTracks(const TrackList& tracks);
     void cleanupTracks();
 
+protected:
+    void timerEvent(QTimerEvent* event) override;
+
 private:
     DbConnectionPoolPtr m_dbPool;
     std::shared_ptr<AudioLoader> m_audioLoader;
@@ -64,5 +73,8 @@ private:
 
     std::unique_ptr<DbConnectionHandler> m_dbHandler;
     TrackDatabase m_trackDatabase;
+
+    TrackStatsQueue m_statsQueue;
+    QBasicTimer m_statsTimer;
 };
 } // namespace Fooyin
@@ -30,68 +30,58 @@ TrackSorter::TrackSorter(LibraryManager* libraryManager)
 
 TrackSorter::~TrackSorter() = default;
 
-TrackList TrackSorter::calcSortFields(const QString& sort, const TrackList& tracks)
+std::vector<QString> TrackSorter::calcSortKeys(const QString& sort, const TrackList& tracks)
 {
-    return calcSortFields(parseScript(sort), tracks);
-}
+    const ParsedScript sortScript = parseScript(sort);
 
-TrackList TrackSorter::calcSortFields(const ParsedScript& sortScript, const TrackList& tracks)
-{
-    const std::scoped_lock lock{m_parserGuard};
+    std::vector<QString> keys;
+    keys.reserve(tracks.size());
 
-    TrackList calcTracks{tracks};
-    for(Track& track : calcTracks) {
-        track.setSort(m_parser.evaluate(sortScript, track));
+    const std::scoped_lock lock{m_parserGuard};
+    for(const Track& track : tracks) {
+        keys.push_back(m_parser.evaluate(sortScript, track));
     }
-    return calcTracks;
-}
 
-TrackList TrackSorter::sortTracks(const TrackList& tracks, Qt::SortOrder order)
-{
-    TrackList sortedTracks{tracks};
-    sortTracks(sortedTracks, std::identity{}, order);
-    return sortedTracks;
+    return keys;
 }
 
-TrackList TrackSorter::calcSortTracks(const QString& sort, const TrackList& tracks, Qt::SortOrder order)
+std::vector<int> TrackSorter::sortPermutation(const std::vector<QString>& keys, Qt::SortOrder order)
 {
-    return calcSortTracks(parseScript(sort), tracks, order);
-}
-
-TrackList TrackSorter::calcSortTracks(const QString& sort, const TrackList& tracks, const std::vector<int>& indexes,
-                                      Qt::SortOrder order)
-{
-    return calcSortTracks(parseScript(sort), tracks, indexes, order);
-}
+    std::vector<SortKey> indexedKeys;
+    indexedKeys.reserve(keys.size());
 
-TrackList TrackSorter::calcSortTracks(const ParsedScript& sortScript, const TrackList& tracks, Qt::SortOrder order)
-{
-    const TrackList calcTracks = calcSortFields(sortScript, tracks);
-    return sortTracks(calcTracks, order);
-}
+    for(size_t i{0}; i < keys.size(); ++i) {
+        indexedKeys.push_back({.index = static_cast<int>(i), .key = keys.at(i)});
+    }
 
-TrackList TrackSorter::calcSortTracks(const ParsedScript& sortScript, const TrackList& tracks,
-                                      const std::vector<int>& indexes, Qt::SortOrder order)
-{
-    TrackList sortedTracks{tracks};
-    TrackList tracksToSort;
+    sortKeys(indexedKeys, order);
 
-    auto validIndexes = indexes | std::views::filter([&tracks](int index) {
-                            return (index >= 0 && index < static_cast<int>(tracks.size()));
-                        });
+    std::vector<int> permutation;
+    permutation.reserve(indexedKeys.size());
 
-    for(const int index : validIndexes) {
-        tracksToSort.push_back(tracks.at(index));
+    for(const SortKey& key : indexedKeys) {
+        permutation.push_back(key.index);
     }
 
-    const TrackList calcTracks      = calcSortFields(sortScript, tracksToSort);
-    const TrackList sortedSubTracks = sortTracks(calcTracks, order);
+    return permutation;
+}
 
-    for(auto i{0}; const int index : validIndexes) {
-        sortedTracks[index] = sortedSubTracks.at(i++);
-    }
+void TrackSorter::sortKeys(std::vector<SortKey>& keys, Qt::SortOrder order)
+{
+    StringCollator collator;
+
+    std::ranges::stable_sort(keys, [order, &collator](const SortKey& lhs, const SortKey& rhs) {
+        const auto cmp = collator.compare(lhs.key, rhs.key);
+
+        if(cmp == 0) {
+            return false;
+        }
 
-    return sortedTracks;
+        if(order == Qt::AscendingOrder) {
+            return cmp < 0;
+        }
+        return cmp > 0;
+    });
 }
 
 ParsedScript TrackSorter::parseScript(const QString& sort)
@@ -0,0 +1,193 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "trackstatsqueue.h"
+
+#include "database/trackdatabase.h"
+
+#include <QDataStream>
+#include <QLoggingCategory>
+
+#include <optional>
+#include <ranges>
+
+Q_LOGGING_CATEGORY(TRK_STATS, "fy.trackstats")
+
+constexpr quint32 JournalMagic   = 0x4659534A;
+constexpr quint32 JournalVersion = 1;
+
+namespace {
+void writeStats(QDataStream& stream, const Fooyin::Track& track)
+{
+    stream << static_cast<quint64>(track.hash()) << static_cast<quint64>(track.addedTime())
+           << static_cast<quint64>(track.firstPlayed()) << static_cast<quint64>(track.lastPlayed())
+           << static_cast<qint32>(track.playCount()) << track.rating();
+}
+
+std::optional<Fooyin::Track> readStats(QDataStream& stream)
+{
+    quint64 hash{0};
+    quint64 added{0};
+    quint64 firstPlayed{0};
+    quint64 lastPlayed{0};
+    qint32 playCount{0};
+    float rating{0};
+
+    stream >> hash >> added >> firstPlayed >> lastPlayed >> playCount >> rating;
+
+    // A partial record is left if the last write was interrupted
+    if(stream.status() != QDataStream::Ok) {
+        return {};
+    }
+
+    Fooyin::Track track;
+    track.setHash(hash);
+    track.setAddedTime(added);
+    track.setFirstPlayed(firstPlayed);
+    track.setLastPlayed(lastPlayed);
+    track.setPlayCount(playCount);
+    track.setRating(rating);
+
+    return track;
+}
+} // namespace
+
+namespace Fooyin {
+TrackStatsQueue::TrackStatsQueue(QString journalPath)
+    : m_journalPath{std::move(journalPath)}
+    , m_journal{m_journalPath}
+{ }
+
+bool TrackStatsQueue::empty() const
+{
+    return m_pending.empty();
+}
+
+size_t TrackStatsQueue::size() const
+{
+    return m_pending.size();
+}
+
+void TrackStatsQueue::add(const TrackList& tracks)
+{
+    const bool journalOpen = openJournal();
+
+    QDataStream stream{&m_journal};
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+    for(const Track& track : tracks) {
+        if(track.hash() == 0) {
+            continue;
+        }
+
+        m_pending.insert_or_assign(track.hash(), track);
+
+        if(journalOpen) {
+            writeStats(stream, track);
+        }
+    }
+
+    if(journalOpen) {
+        // Written through to the OS, so the stats survive fooyin crashing
+        m_journal.flush();
+    }
+}
+
+void TrackStatsQueue::restore()
+{
+    QFile journal{m_journalPath};
+    if(!journal.exists() || !journal.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    QDataStream stream{&journal};
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+    quint32 magic{0};
+    quint32 version{0};
+    stream >> magic >> version;
+
+    if(magic != JournalMagic || version != JournalVersion) {
+        qCInfo(TRK_STATS) << "Ignoring invalid track stats journal:" << m_journalPath;
+        return;
+    }
+
+    size_t restored{0};
+    while(!stream.atEnd()) {
+        auto track = readStats(stream);
+        if(!track) {
+            break;
+        }
+        if(track->hash() == 0) {
+            continue;
+        }
+        m_pending.insert_or_assign(track->hash(), std::move(track.value()));
+        ++restored;
+    }
+
+    if(restored > 0) {
+        qCInfo(TRK_STATS) << "Restored" << restored << "unsaved track stats";
+    }
+}
+
+bool TrackStatsQueue::flush(TrackDatabase& trackDatabase)
+{
+    if(m_pending.empty()) {
+        return true;
+    }
+
+    TrackList tracks;
+    tracks.reserve(m_pending.size());
+    std::ranges::copy(m_pending | std::views::values, std::back_inserter(tracks));
+
+    if(!trackDatabase.updateTrackStats(tracks)) {
+        qCWarning(TRK_STATS) << "Failed to write" << tracks.size() << "track stats";
+        return false;
+    }
+
+    m_pending.clear();
+
+    m_journal.close();
+    QFile::remove(m_journalPath);
+
+    return true;
+}
+
+bool TrackStatsQueue::openJournal()
+{
+    if(m_journal.isOpen()) {
+        return true;
+    }
+
+    if(!m_journal.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCWarning(TRK_STATS) << "Unable to open track stats journal:" << m_journal.errorString();
+        return false;
+    }
+
+    // Stats restored from a previous journal are written again, as it's replaced
+    QDataStream stream{&m_journal};
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    stream << JournalMagic << JournalVersion;
+    for(const Track& track : m_pending | std::views::values) {
+        writeStats(stream, track);
+    }
+
+    return true;
+}
+} // namespace Fooyin
@@ -0,0 +1,62 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <core/track.h>
+
+#include <QFile>
+
+#include <unordered_map>
+
+namespace Fooyin {
+class TrackDatabase;
+
+/*!
+ * Buffers track statistics before they're written to the database, keeping only the latest
+ * stats for each track hash so repeated plays and ratings are written once.
+ * Queued stats are appended to a journal, so they can be restored if fooyin exits before
+ * they've been written.
+ */
+class TrackStatsQueue
+{
+public:
+    explicit TrackStatsQueue(QString journalPath);
+
+    [[nodiscard]] bool empty() const;
+    [[nodiscard]] size_t size() const;
+
+    /** Queues the stats of @p tracks, replacing any queued for the same hash. */
+    void add(const TrackList& tracks);
+    /** Queues any stats left in the journal by a previous session. */
+    void restore();
+    /*!
+     * Writes the queued stats to @p trackDatabase in one batch.
+     * The queue and journal are only cleared if the write succeeds.
+     */
+    bool flush(TrackDatabase& trackDatabase);
+
+private:
+    bool openJournal();
+
+    QString m_journalPath;
+    QFile m_journal;
+    std::unordered_map<uint64_t, Track> m_pending;
+};
+} // namespace Fooyin
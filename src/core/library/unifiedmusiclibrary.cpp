@@ -19,24 +19,52 @@
 
 #include "unifiedmusiclibrary.h"
 
+#include "corepaths.h"
+#include "database/trackdatabase.h"
 #include "internalcoresettings.h"
 #include "library/librarymanager.h"
+#include "librarysnapshot.h"
 #include "librarythreadhandler.h"
 
 #include <core/coresettings.h>
 #include <core/library/libraryinfo.h>
 #include <core/library/tracksort.h>
 #include <utils/async.h>
+#include <utils/database/dbconnectionhandler.h>
+#include <utils/database/dbtransaction.h>
 #include <utils/fileutils.h>
 #include <utils/settings/settingsmanager.h>
+#include <utils/stringpool.h>
 
+#include <QBasicTimer>
 #include <QDateTime>
+#include <QLoggingCategory>
+#include <QTimerEvent>
 
 #include <ranges>
+#include <unordered_map>
 #include <unordered_set>
 
+Q_LOGGING_CATEGORY(LIBRARY, "fy.library")
+
 using namespace std::chrono_literals;
 
+// Delay before writing the library snapshot after a change, so bursts of changes are written once
+#if QT_VERSION >= QT_VERSION_CHECK(6, 5, 0)
+constexpr auto SnapshotDelay = 10s;
+#else
+constexpr auto SnapshotDelay = 10000;
+#endif
+
+namespace {
+struct SortedTracks
+{
+    Fooyin::TrackList tracks;
+    // Sort key of each track
+    std::vector<QString> keys;
+};
+} // namespace
+
 namespace Fooyin {
 class UnifiedMusicLibraryPrivate
 {
@@ -44,10 +72,15 @@ public:
     UnifiedMusicLibraryPrivate(UnifiedMusicLibrary* self, LibraryManager* libraryManager, DbConnectionPoolPtr dbPool,
                                std::shared_ptr<PlaylistLoader> playlistLoader, std::shared_ptr<AudioLoader> audioLoader,
                                SettingsManager* settings);
+    ~UnifiedMusicLibraryPrivate();
 
+    void setTracks(SortedTracks sortedTracks);
+    void indexTracks(size_t first = 0);
+
+    void loadAllTracks();
     void loadTracks(const TrackList& trackToLoad);
     QFuture<void> addTracks(const TrackList& newTracks);
-    void updateLibraryTracks(const TrackList& updatedTracks);
+    void updateLibraryTracks(const SortedTracks& updatedTracks);
     QFuture<void> updateTracksMetadata(const TrackList& tracksToUpdate);
     QFuture<void> updateTracks(const TrackList& tracksToUpdate);
     void removeTracks(const TrackList& tracksToRemove);
@@ -60,11 +93,15 @@ public:
     void libraryStatusChanged(const LibraryInfo& library) const;
 
     void changeSort(const QString& sort);
-    QFuture<TrackList> recalSortTracks(const QString& sort, const TrackList& tracks);
-    QFuture<TrackList> resortTracks(const TrackList& tracks);
+    [[nodiscard]] SortedTracks calcSortTracks(const QString& sort, const TrackList& tracks);
+    QFuture<SortedTracks> recalSortTracks(const QString& sort, const TrackList& tracks);
+    QFuture<SortedTracks> resortTracks();
 
     void handleTracksLoaded();
 
+    void scheduleSnapshot();
+    void writeSnapshot();
+
     UnifiedMusicLibrary* m_self;
 
     LibraryManager* m_libraryManager;
@@ -75,6 +112,13 @@ public:
     TrackSorter m_sorter;
 
     TrackList m_tracks;
+    // Library sort key of each track in m_tracks, kept here so the shared track data isn't detached to set them
+    std::vector<QString> m_sortKeys;
+    // Track id -> index in m_tracks
+    std::unordered_map<int, size_t> m_trackIndexes;
+
+    QBasicTimer m_snapshotTimer;
+    QFuture<void> m_snapshotWriter;
 };
 
 UnifiedMusicLibraryPrivate::UnifiedMusicLibraryPrivate(UnifiedMusicLibrary* self, LibraryManager* libraryManager,
@@ -94,6 +138,75 @@ UnifiedMusicLibraryPrivate::UnifiedMusicLibraryPrivate(UnifiedMusicLibrary* self
         m_self, [this](bool enabled) { m_threadHandler.setupWatchers(m_libraryManager->allLibraries(), enabled); });
 }
 
+UnifiedMusicLibraryPrivate::~UnifiedMusicLibraryPrivate()
+{
+    m_snapshotWriter.waitForFinished();
+}
+
+void UnifiedMusicLibraryPrivate::setTracks(SortedTracks sortedTracks)
+{
+    m_tracks   = std::move(sortedTracks.tracks);
+    m_sortKeys = std::move(sortedTracks.keys);
+    indexTracks();
+}
+
+void UnifiedMusicLibraryPrivate::indexTracks(size_t first)
+{
+    if(first == 0) {
+        m_trackIndexes.clear();
+        m_trackIndexes.reserve(m_tracks.size());
+    }
+
+    for(size_t i{first}; i < m_tracks.size(); ++i) {
+        // The first occurrence takes precedence
+        m_trackIndexes.emplace(m_tracks.at(i).id(), i);
+    }
+}
+
+void UnifiedMusicLibraryPrivate::loadAllTracks()
+{
+    const DbConnectionProvider dbProvider{m_dbPool};
+    TrackDatabase trackDatabase;
+    trackDatabase.initialise(dbProvider);
+
+    const int64_t revision = trackDatabase.libraryRevision();
+    const bool markUnavailable
+        = m_settings->fileValue(Settings::Core::Internal::MarkUnavailableStartup, false).toBool();
+
+    Utils::asyncExec([dbPool = m_dbPool, revision, markUnavailable]() {
+        auto snapshot = LibrarySnapshot::read(Core::librarySnapshotPath(), revision);
+        if(!snapshot) {
+            return snapshot;
+        }
+
+        // Stats don't bump the revision, so may have changed since the snapshot was written
+        const DbConnectionHandler dbHandler{dbPool, DbConnection::Mode::ReadOnly};
+        TrackDatabase statsDatabase;
+        statsDatabase.initialise(DbConnectionProvider{dbPool, DbConnection::Mode::ReadOnly});
+        if(!statsDatabase.reloadTrackStats(snapshot->tracks)) {
+            return std::optional<LibrarySnapshot::Contents>{};
+        }
+
+        if(markUnavailable) {
+            std::ranges::for_each(snapshot->tracks, [](auto& track) { track.setIsEnabled(track.exists()); });
+        }
+        return snapshot;
+    }).then(m_self, [this](const std::optional<LibrarySnapshot::Contents>& snapshot) {
+        if(!snapshot) {
+            m_threadHandler.getAllTracks();
+            return;
+        }
+
+        if(snapshot->sort != m_settings->value<Settings::Core::LibrarySortScript>()) {
+            loadTracks(snapshot->tracks);
+            return;
+        }
+
+        setTracks({.tracks = snapshot->tracks, .keys = snapshot->sortKeys});
+        emit m_self->tracksLoaded(m_tracks);
+    });
+}
+
 void UnifiedMusicLibraryPrivate::loadTracks(const TrackList& trackToLoad)
 {
     if(trackToLoad.empty()) {
@@ -103,9 +216,10 @@ void UnifiedMusicLibraryPrivate::loadTracks(const TrackList& trackToLoad)
 
     auto sortTracks = recalSortTracks(m_settings->value<Settings::Core::LibrarySortScript>(), trackToLoad);
 
-    sortTracks.then(m_self, [this](const TrackList& sortedTracks) {
-        m_tracks = sortedTracks;
+    sortTracks.then(m_self, [this](const SortedTracks& sortedTracks) {
+        setTracks(sortedTracks);
         emit m_self->tracksLoaded(m_tracks);
+        scheduleSnapshot();
     });
 }
 
@@ -113,28 +227,32 @@ QFuture<void> UnifiedMusicLibraryPrivate::addTracks(const TrackList& newTracks)
 {
     TrackList tracksToAdd;
     std::ranges::copy_if(newTracks, std::back_inserter(tracksToAdd),
-                         [](const Track& track) { return track.isNewTrack(); });
+                         [this](const Track& track) { return !m_trackIndexes.contains(track.id()); });
     auto sortTracks = recalSortTracks(m_settings->value<Settings::Core::LibrarySortScript>(), tracksToAdd);
 
-    return sortTracks.then(m_self, [this](const TrackList& sortedTracks) {
-        std::ranges::copy(sortedTracks, std::back_inserter(m_tracks));
+    return sortTracks.then(m_self, [this](const SortedTracks& sortedTracks) {
+        const size_t first = m_tracks.size();
+        std::ranges::copy(sortedTracks.tracks, std::back_inserter(m_tracks));
+        std::ranges::copy(sortedTracks.keys, std::back_inserter(m_sortKeys));
+        indexTracks(first);
 
-        resortTracks(m_tracks).then(m_self, [this, sortedTracks](const TrackList& sortedLibraryTracks) {
-            m_tracks = sortedLibraryTracks;
+        resortTracks().then(m_self, [this, sortedTracks](const SortedTracks& sortedLibraryTracks) {
+            setTracks(sortedLibraryTracks);
 
-            emit m_self->tracksAdded(sortedTracks);
+            emit m_self->tracksAdded(sortedTracks.tracks);
         });
     });
 }
 
-void UnifiedMusicLibraryPrivate::updateLibraryTracks(const TrackList& updatedTracks)
+void UnifiedMusicLibraryPrivate::updateLibraryTracks(const SortedTracks& updatedTracks)
 {
-    for(const auto& track : updatedTracks) {
-        auto trackIt
-            = std::ranges::find_if(m_tracks, [&track](const Track& oldTrack) { return oldTrack.id() == track.id(); });
-        if(trackIt != m_tracks.end()) {
-            *trackIt = track;
-            trackIt->clearWasModified();
+    for(size_t i{0}; i < updatedTracks.tracks.size(); ++i) {
+        const Track& track = updatedTracks.tracks.at(i);
+        if(const auto indexIt = m_trackIndexes.find(track.id()); indexIt != m_trackIndexes.cend()) {
+            Track& libraryTrack = m_tracks.at(indexIt->second);
+            libraryTrack        = track;
+            libraryTrack.clearWasModified();
+            m_sortKeys.at(indexIt->second) = updatedTracks.keys.at(i);
         }
     }
 }
@@ -143,12 +261,12 @@ QFuture<void> UnifiedMusicLibraryPrivate::updateTracksMetadata(const TrackList&
 {
     auto sortTracks = recalSortTracks(m_settings->value<Settings::Core::LibrarySortScript>(), tracksToUpdate);
 
-    return sortTracks.then(m_self, [this](const TrackList& sortedTracks) {
+    return sortTracks.then(m_self, [this](const SortedTracks& sortedTracks) {
         updateLibraryTracks(sortedTracks);
 
-        resortTracks(m_tracks).then(m_self, [this, sortedTracks](const TrackList& sortedLibraryTracks) {
-            m_tracks = sortedLibraryTracks;
-            emit m_self->tracksMetadataChanged(sortedTracks);
+        resortTracks().then(m_self, [this, sortedTracks](const SortedTracks& sortedLibraryTracks) {
+            setTracks(sortedLibraryTracks);
+            emit m_self->tracksMetadataChanged(sortedTracks.tracks);
         });
     });
 }
@@ -157,12 +275,12 @@ QFuture<void> UnifiedMusicLibraryPrivate::updateTracks(const TrackList& tracksTo
 {
     auto sortTracks = recalSortTracks(m_settings->value<Settings::Core::LibrarySortScript>(), tracksToUpdate);
 
-    return sortTracks.then(m_self, [this](const TrackList& sortedTracks) {
+    return sortTracks.then(m_self, [this](const SortedTracks& sortedTracks) {
         updateLibraryTracks(sortedTracks);
 
-        resortTracks(m_tracks).then(m_self, [this, sortedTracks](const TrackList& sortedLibraryTracks) {
-            m_tracks = sortedLibraryTracks;
-            emit m_self->tracksUpdated(sortedTracks);
+        resortTracks().then(m_self, [this, sortedTracks](const SortedTracks& sortedLibraryTracks) {
+            setTracks(sortedLibraryTracks);
+            emit m_self->tracksUpdated(sortedTracks.tracks);
         });
     });
 }
@@ -171,18 +289,22 @@ void UnifiedMusicLibraryPrivate::removeTracks(const TrackList& tracksToRemove)
 {
     const std::unordered_set<Track, Track::TrackHash> toRemove(tracksToRemove.begin(), tracksToRemove.end());
 
-    TrackList remainingTracks;
-    remainingTracks.reserve(m_tracks.size());
+    SortedTracks remainingTracks;
+    remainingTracks.tracks.reserve(m_tracks.size());
+    remainingTracks.keys.reserve(m_sortKeys.size());
 
-    for(const auto& track : m_tracks) {
-        if(!toRemove.contains(track)) {
-            remainingTracks.push_back(track);
+    for(size_t i{0}; i < m_tracks.size(); ++i) {
+        if(!toRemove.contains(m_tracks.at(i))) {
+            remainingTracks.tracks.push_back(m_tracks.at(i));
+            remainingTracks.keys.push_back(m_sortKeys.at(i));
         }
     }
 
-    m_tracks = std::move(remainingTracks);
+    setTracks(std::move(remainingTracks));
 
     emit m_self->tracksDeleted(tracksToRemove);
+
+    StringPool::instance().prune();
 }
 
 void UnifiedMusicLibraryPrivate::handleScanResult(const ScanResult& result)
@@ -203,8 +325,8 @@ void UnifiedMusicLibraryPrivate::scannedTracks(int id, const TrackList& tracks)
 {
     addTracks(tracks).then([this, id, tracks]() {
         recalSortTracks(m_settings->value<Settings::Core::ExternalSortScript>(), tracks)
-            .then(m_self, [this, id](const TrackList& sortedScannedTracks) {
-                emit m_self->tracksScanned(id, sortedScannedTracks);
+            .then(m_self, [this, id](const SortedTracks& sortedScannedTracks) {
+                emit m_self->tracksScanned(id, sortedScannedTracks.tracks);
             });
     });
 }
@@ -220,11 +342,12 @@ void UnifiedMusicLibraryPrivate::removeLibrary(const LibraryInfo& library, const
         return;
     }
 
-    TrackList newTracks;
+    SortedTracks newTracks;
     TrackList removedTracks;
     TrackList updatedTracks;
 
-    for(auto& track : m_tracks) {
+    for(size_t i{0}; i < m_tracks.size(); ++i) {
+        Track& track = m_tracks.at(i);
         if(track.libraryId() == library.id) {
             if(tracksRemoved.contains(track.id())) {
                 removedTracks.push_back(track);
@@ -232,12 +355,12 @@ void UnifiedMusicLibraryPrivate::removeLibrary(const LibraryInfo& library, const
             }
             track.setLibraryId(-1);
             updatedTracks.push_back(track);
-            newTracks.push_back(track);
         }
-        newTracks.push_back(track);
+        newTracks.tracks.push_back(track);
+        newTracks.keys.push_back(m_sortKeys.at(i));
     }
 
-    m_tracks = newTracks;
+    setTracks(std::move(newTracks));
 
     emit m_self->tracksDeleted(removedTracks);
     emit m_self->tracksMetadataChanged(updatedTracks);
@@ -250,24 +373,83 @@ void UnifiedMusicLibraryPrivate::libraryStatusChanged(const LibraryInfo& library
 
 void UnifiedMusicLibraryPrivate::changeSort(const QString& sort)
 {
-    recalSortTracks(sort, m_tracks).then(m_self, [this](const TrackList& sortedTracks) {
-        m_tracks = sortedTracks;
+    recalSortTracks(sort, m_tracks).then(m_self, [this](const SortedTracks& sortedTracks) {
+        setTracks(sortedTracks);
         emit m_self->tracksSorted(m_tracks);
     });
 }
 
-QFuture<TrackList> UnifiedMusicLibraryPrivate::recalSortTracks(const QString& sort, const TrackList& tracks)
+SortedTracks UnifiedMusicLibraryPrivate::calcSortTracks(const QString& sort, const TrackList& tracks)
 {
-    return Utils::asyncExec([this, sort, tracks]() { return m_sorter.calcSortTracks(sort, tracks); });
+    const std::vector<QString> keys    = m_sorter.calcSortKeys(sort, tracks);
+    const std::vector<int> permutation = TrackSorter::sortPermutation(keys);
+
+    return {.tracks = TrackSorter::applyPermutation(tracks, permutation),
+            .keys   = TrackSorter::applyPermutation(keys, permutation)};
 }
 
-QFuture<TrackList> UnifiedMusicLibraryPrivate::resortTracks(const TrackList& tracks)
+QFuture<SortedTracks> UnifiedMusicLibraryPrivate::recalSortTracks(const QString& sort, const TrackList& tracks)
 {
-    return Utils::asyncExec([tracks]() { return TrackSorter::sortTracks(tracks); });
+    return Utils::asyncExec([this, sort, tracks]() { return calcSortTracks(sort, tracks); });
+}
+
+QFuture<SortedTracks> UnifiedMusicLibraryPrivate::resortTracks()
+{
+    // Only the stored keys are compared, so the sort script isn't evaluated again
+    return Utils::asyncExec([tracks = m_tracks, keys = m_sortKeys]() {
+        const std::vector<int> permutation = TrackSorter::sortPermutation(keys);
+        return SortedTracks{.tracks = TrackSorter::applyPermutation(tracks, permutation),
+                            .keys   = TrackSorter::applyPermutation(keys, permutation)};
+    });
+}
+
+void UnifiedMusicLibraryPrivate::scheduleSnapshot()
+{
+    m_snapshotTimer.start(SnapshotDelay, m_self);
+}
+
+void UnifiedMusicLibraryPrivate::writeSnapshot()
+{
+    if(m_snapshotWriter.isRunning()) {
+        scheduleSnapshot();
+        return;
+    }
+
+    const QString sort = m_settings->value<Settings::Core::LibrarySortScript>();
+
+    // Written from the database rather than m_tracks, as changes may have been committed which haven't reached us yet
+    m_snapshotWriter = Utils::asyncExec([this, sort]() {
+        const DbConnectionHandler dbHandler{m_dbPool, DbConnection::Mode::ReadOnly};
+        const DbConnectionProvider dbProvider{m_dbPool, DbConnection::Mode::ReadOnly};
+
+        TrackDatabase trackDatabase;
+        trackDatabase.initialise(dbProvider);
+
+        int64_t revision{-1};
+        TrackList tracks;
+        {
+            // Read together so the revision matches the tracks
+            DbTransaction transaction{dbProvider.db()};
+            if(!transaction) {
+                return;
+            }
+            revision = trackDatabase.libraryRevision();
+            tracks   = trackDatabase.getAllTracks();
+            transaction.commit();
+        }
+
+        if(revision >= 0) {
+            const SortedTracks sortedTracks = calcSortTracks(sort, tracks);
+            LibrarySnapshot::write(Core::librarySnapshotPath(), sortedTracks.tracks, sortedTracks.keys, revision, sort);
+        }
+    });
 }
 
 void UnifiedMusicLibraryPrivate::handleTracksLoaded()
 {
+    qCDebug(LIBRARY).noquote() << StringPool::instance().report();
+
+    m_threadHandler.libraryLoaded();
     m_threadHandler.setupWatchers(m_libraryManager->allLibraries(),
                                   m_settings->value<Settings::Core::Internal::MonitorLibraries>());
     if(m_settings->value<Settings::Core::AutoRefresh>()) {
@@ -315,6 +497,14 @@ UnifiedMusicLibrary::UnifiedMusicLibrary(LibraryManager* libraryManager, DbConne
 
     QObject::connect(
         this, &MusicLibrary::tracksLoaded, this, [this]() { p->handleTracksLoaded(); }, Qt::QueuedConnection);
+
+    const auto scheduleSnapshot = [this]() {
+        p->scheduleSnapshot();
+    };
+    QObject::connect(this, &MusicLibrary::tracksAdded, this, scheduleSnapshot);
+    QObject::connect(this, &MusicLibrary::tracksMetadataChanged, this, scheduleSnapshot);
+    QObject::connect(this, &MusicLibrary::tracksDeleted, this, scheduleSnapshot);
+    QObject::connect(this, &MusicLibrary::tracksSorted, this, scheduleSnapshot);
 }
 
 UnifiedMusicLibrary::~UnifiedMusicLibrary() = default;
@@ -342,7 +532,7 @@ std::optional<LibraryInfo> UnifiedMusicLibrary::libraryForPath(const QString& pa
 
 void UnifiedMusicLibrary::loadAllTracks()
 {
-    p->m_threadHandler.getAllTracks();
+    p->loadAllTracks();
 }
 
 bool UnifiedMusicLibrary::isEmpty() const
@@ -403,9 +593,8 @@ TrackList UnifiedMusicLibrary::tracks() const
 
 Track UnifiedMusicLibrary::trackForId(int id) const
 {
-    auto trackIt = std::ranges::find_if(p->m_tracks, [id](const Track& track) { return track.id() == id; });
-    if(trackIt != p->m_tracks.cend()) {
-        return *trackIt;
+    if(const auto indexIt = p->m_trackIndexes.find(id); indexIt != p->m_trackIndexes.cend()) {
+        return p->m_tracks.at(indexIt->second);
     }
     return {};
 }
@@ -416,9 +605,8 @@ TrackList UnifiedMusicLibrary::tracksForIds(const TrackIds& ids) const
     tracks.reserve(ids.size());
 
     for(const int id : ids) {
-        auto trackIt = std::ranges::find_if(p->m_tracks, [id](const Track& track) { return track.id() == id; });
-        if(trackIt != p->m_tracks.cend()) {
-            tracks.push_back(*trackIt);
+        if(const auto indexIt = p->m_trackIndexes.find(id); indexIt != p->m_trackIndexes.cend()) {
+            tracks.push_back(p->m_tracks.at(indexIt->second));
         }
     }
 
@@ -462,7 +650,7 @@ void UnifiedMusicLibrary::updateTrackStats(const Track& track)
 
 void UnifiedMusicLibrary::trackWasPlayed(const Track& track)
 {
-    const QString hash  = track.hash();
+    const uint64_t hash = track.hash();
     const auto currTime = QDateTime::currentMSecsSinceEpoch();
     const int playCount = track.playCount() + 1;
 
@@ -490,6 +678,16 @@ WriteRequest UnifiedMusicLibrary::removeUnavailbleTracks()
 {
     return p->m_threadHandler.removeUnavailbleTracks(p->m_tracks);
 }
+
+void UnifiedMusicLibrary::timerEvent(QTimerEvent* event)
+{
+    if(event->timerId() == p->m_snapshotTimer.timerId()) {
+        p->m_snapshotTimer.stop();
+        p->writeSnapshot();
+    }
+
+    MusicLibrary::timerEvent(event);
+}
 } // namespace Fooyin
 
 #include "moc_unifiedmusiclibrary.cpp"
@@ -75,6 +75,9 @@ public:
     void cleanupTracks();
     WriteRequest removeUnavailbleTracks() override;
 
+protected:
+    void timerEvent(QTimerEvent* event) override;
+
 private:
     std::unique_ptr<UnifiedMusicLibraryPrivate> p;
 };
@@ -0,0 +1,188 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <core/constants.h>
+#include <utils/perfecthash.h>
+
+namespace Fooyin {
+/*!
+ * The fields of Constants::MetaData, so field names can be resolved once and dispatched on.
+ */
+enum class MetaField : uint8_t
+{
+    Title,
+    Artist,
+    UniqueArtist,
+    Album,
+    AlbumArtist,
+    Track,
+    TrackTotal,
+    Disc,
+    DiscTotal,
+    Genre,
+    Composer,
+    Performer,
+    Duration,
+    DurationSecs,
+    DurationMSecs,
+    Lyrics,
+    Comment,
+    Date,
+    Year,
+    FileSize,
+    FileSizeNatural,
+    Bitrate,
+    SampleRate,
+    FirstPlayed,
+    LastPlayed,
+    PlayCount,
+    Rating,
+    RatingStars,
+    RatingEditor,
+    Codec,
+    CodecProfile,
+    Tool,
+    TagType,
+    Encoding,
+    Channels,
+    BitDepth,
+    AddedTime,
+    LastModified,
+    FilePath,
+    RelativePath,
+    FileName,
+    Extension,
+    FileNameWithExt,
+    Directory,
+    Path,
+    Subsong,
+    RGTrackGain,
+    RGTrackPeak,
+    RGTrackPeakDB,
+    RGAlbumGain,
+    RGAlbumPeak,
+    RGAlbumPeakDB,
+    Unknown,
+};
+
+constexpr auto MetaFieldCount = static_cast<size_t>(MetaField::Unknown);
+
+namespace Detail {
+// clang-format off
+constexpr PerfectHashMap MetaFields{std::array{
+    std::pair{Constants::MetaData::Title, MetaField::Title},
+    std::pair{Constants::MetaData::Artist, MetaField::Artist},
+    std::pair{Constants::MetaData::UniqueArtist, MetaField::UniqueArtist},
+    std::pair{Constants::MetaData::Album, MetaField::Album},
+    std::pair{Constants::MetaData::AlbumArtist, MetaField::AlbumArtist},
+    std::pair{Constants::MetaData::Track, MetaField::Track},
+    std::pair{Constants::MetaData::TrackTotal, MetaField::TrackTotal},
+    std::pair{Constants::MetaData::Disc, MetaField::Disc},
+    std::pair{Constants::MetaData::DiscTotal, MetaField::DiscTotal},
+    std::pair{Constants::MetaData::Genre, MetaField::Genre},
+    std::pair{Constants::MetaData::Composer, MetaField::Composer},
+    std::pair{Constants::MetaData::Performer, MetaField::Performer},
+    std::pair{Constants::MetaData::Duration, MetaField::Duration},
+    std::pair{Constants::MetaData::DurationSecs, MetaField::DurationSecs},
+    std::pair{Constants::MetaData::DurationMSecs, MetaField::DurationMSecs},
+    std::pair{Constants::MetaData::Lyrics, MetaField::Lyrics},
+    std::pair{Constants::MetaData::Comment, MetaField::Comment},
+    std::pair{Constants::MetaData::Date, MetaField::Date},
+    std::pair{Constants::MetaData::Year, MetaField::Year},
+    std::pair{Constants::MetaData::FileSize, MetaField::FileSize},
+    std::pair{Constants::MetaData::FileSizeNatural, MetaField::FileSizeNatural},
+    std::pair{Constants::MetaData::Bitrate, MetaField::Bitrate},
+    std::pair{Constants::MetaData::SampleRate, MetaField::SampleRate},
+    std::pair{Constants::MetaData::FirstPlayed, MetaField::FirstPlayed},
+    std::pair{Constants::MetaData::LastPlayed, MetaField::LastPlayed},
+    std::pair{Constants::MetaData::PlayCount, MetaField::PlayCount},
+    std::pair{Constants::MetaData::Rating, MetaField::Rating},
+    std::pair{Constants::MetaData::RatingStars, MetaField::RatingStars},
+    std::pair{Constants::MetaData::RatingEditor, MetaField::RatingEditor},
+    std::pair{Constants::MetaData::Codec, MetaField::Codec},
+    std::pair{Constants::MetaData::CodecProfile, MetaField::CodecProfile},
+    std::pair{Constants::MetaData::Tool, MetaField::Tool},
+    std::pair{Constants::MetaData::TagType, MetaField::TagType},
+    std::pair{Constants::MetaData::Encoding, MetaField::Encoding},
+    std::pair{Constants::MetaData::Channels, MetaField::Channels},
+    std::pair{Constants::MetaData::BitDepth, MetaField::BitDepth},
+    std::pair{Constants::MetaData::AddedTime, MetaField::AddedTime},
+    std::pair{Constants::MetaData::LastModified, MetaField::LastModified},
+    std::pair{Constants::MetaData::FilePath, MetaField::FilePath},
+    std::pair{Constants::MetaData::RelativePath, MetaField::RelativePath},
+    std::pair{Constants::MetaData::FileName, MetaField::FileName},
+    std::pair{Constants::MetaData::Extension, MetaField::Extension},
+    std::pair{Constants::MetaData::FileNameWithExt, MetaField::FileNameWithExt},
+    std::pair{Constants::MetaData::Directory, MetaField::Directory},
+    std::pair{Constants::MetaData::Path, MetaField::Path},
+    std::pair{Constants::MetaData::Subsong, MetaField::Subsong},
+    std::pair{Constants::MetaData::RGTrackGain, MetaField::RGTrackGain},
+    std::pair{Constants::MetaData::RGTrackPeak, MetaField::RGTrackPeak},
+    std::pair{Constants::MetaData::RGTrackPeakDB, MetaField::RGTrackPeakDB},
+    std::pair{Constants::MetaData::RGAlbumGain, MetaField::RGAlbumGain},
+    std::pair{Constants::MetaData::RGAlbumPeak, MetaField::RGAlbumPeak},
+    std::pair{Constants::MetaData::RGAlbumPeakDB, MetaField::RGAlbumPeakDB}
+}};
+// clang-format on
+
+static_assert(MetaFields.size() == MetaFieldCount);
+} // namespace Detail
+
+/*!
+ * Returns the field named @p name, ignoring case, or MetaField::Unknown if it isn't a known field.
+ */
+template <typename Name>
+constexpr MetaField metaField(const Name& name)
+{
+    return Detail::MetaFields.find(name).value_or(MetaField::Unknown);
+}
+
+/*!
+ * A table of one @c T for each MetaField, such as the function used to evaluate the field.
+ */
+template <typename T>
+class MetaFieldTable
+{
+public:
+    T& operator[](MetaField field)
+    {
+        return m_values.at(static_cast<size_t>(field));
+    }
+
+    /*!
+     * Returns the value for the field named @p name, or nullptr if it isn't a known field or has no value.
+     */
+    template <typename Name>
+    const T* find(const Name& name) const
+    {
+        const MetaField field = metaField(name);
+        if(field == MetaField::Unknown) {
+            return nullptr;
+        }
+
+        const T& value = m_values.at(static_cast<size_t>(field));
+        return value ? &value : nullptr;
+    }
+
+private:
+    std::array<T, MetaFieldCount> m_values;
+};
+} // namespace Fooyin
@@ -34,6 +34,14 @@ using namespace Qt::StringLiterals;
 
 namespace {
 using AlbumTracks = std::vector<int>;
+
+// Past this the tracks are saved in full instead
+constexpr auto MaxTrackChanges = 100;
+
+bool isSameTrack(const Fooyin::Track& lhs, const Fooyin::Track& rhs)
+{
+    return lhs.id() == rhs.id() && lhs == rhs;
+}
 } // namespace
 
 namespace Fooyin {
@@ -134,6 +142,10 @@ public:
     int getNextIndex(int delta, Playlist::PlayModes mode, bool onlyCheck);
     [[nodiscard]] std::optional<Track> getTrack(int index) const;
 
+    void addTrackChange(Playlist::TrackChange change);
+    void addTrackChanges(const TrackList& oldTracks, const TrackList& newTracks);
+    void resetTrackChanges(bool recorded);
+
     UId m_id;
     int m_dbId{-1};
     QString m_name;
@@ -156,6 +168,8 @@ public:
     bool m_isTemporary{false};
     bool m_modified{false};
     bool m_tracksModified{false};
+    Playlist::TrackChanges m_trackChanges;
+    bool m_trackChangesRecorded{true};
 
     bool m_isAutoPlaylist{false};
     QString m_query;
@@ -257,12 +271,11 @@ void PlaylistPrivate::sortAlbumTracks(AlbumTracks& album, const QString& sortScr
         trackIndexes.emplace_back(m_tracks.at(trackIndex), m_id, trackIndex);
     }
 
-    trackIndexes
-        = m_sorter.calcSortTracks(sortScript, trackIndexes, PlaylistTrack::extractor, PlaylistTrack::extractorConst);
+    const auto permutation = m_sorter.sortPermutation(sortScript, trackIndexes, PlaylistTrack::extractorConst);
 
     album.clear();
-    for(const auto& track : trackIndexes) {
-        album.emplace_back(track.indexInPlaylist);
+    for(const int index : permutation) {
+        album.emplace_back(trackIndexes.at(index).indexInPlaylist);
     }
 }
 
@@ -488,6 +501,99 @@ std::optional<Track> PlaylistPrivate::getTrack(int index) const
     return m_tracks.at(index);
 }
 
+void PlaylistPrivate::addTrackChange(Playlist::TrackChange change)
+{
+    if(!m_trackChangesRecorded) {
+        return;
+    }
+
+    using Type = Playlist::TrackChange::Type;
+
+    if(!m_trackChanges.empty()) {
+        auto& last = m_trackChanges.back();
+        if(change.type == Type::Insert && last.type == Type::Insert && change.index == last.index + last.count) {
+            std::ranges::copy(change.tracks, std::back_inserter(last.tracks));
+            last.count += change.count;
+            return;
+        }
+        if(change.type == Type::Remove && last.type == Type::Remove
+           && (change.index == last.index || change.index + change.count == last.index)) {
+            last.index = change.index;
+            last.count += change.count;
+            return;
+        }
+    }
+
+    if(std::cmp_greater_equal(m_trackChanges.size(), MaxTrackChanges)) {
+        resetTrackChanges(false);
+        return;
+    }
+
+    m_trackChanges.push_back(std::move(change));
+}
+
+void PlaylistPrivate::addTrackChanges(const TrackList& oldTracks, const TrackList& newTracks)
+{
+    using Type = Playlist::TrackChange::Type;
+
+    const auto oldCount = static_cast<int>(oldTracks.size());
+    const auto newCount = static_cast<int>(newTracks.size());
+
+    // Only the tracks between the unchanged start and end need to be saved
+    const auto mismatch = std::ranges::mismatch(oldTracks, newTracks, isSameTrack);
+    const auto start    = static_cast<int>(std::distance(oldTracks.cbegin(), mismatch.in1));
+
+    int end{0};
+    while(end < std::min(oldCount, newCount) - start
+          && isSameTrack(oldTracks.at(oldCount - end - 1), newTracks.at(newCount - end - 1))) {
+        ++end;
+    }
+
+    const int removed  = oldCount - start - end;
+    const int inserted = newCount - start - end;
+
+    if(removed > 1 && removed == inserted) {
+        // Check for a block of tracks being moved, in which case the changed range is rotated
+        const auto oldRange = std::ranges::subrange(oldTracks.cbegin() + start, oldTracks.cbegin() + start + removed);
+        const auto newRange = std::ranges::subrange(newTracks.cbegin() + start, newTracks.cbegin() + start + removed);
+
+        const auto pivot = std::ranges::find_if(std::next(oldRange.begin()), oldRange.end(),
+                                                [&newRange](const Track& track) {
+                                                    return isSameTrack(track, newRange.front());
+                                                });
+        if(pivot != oldRange.end()) {
+            const auto split = static_cast<int>(std::distance(oldRange.begin(), pivot));
+            if(std::ranges::equal(pivot, oldRange.end(), newRange.begin(), newRange.end() - split, isSameTrack)
+               && std::ranges::equal(oldRange.begin(), pivot, newRange.end() - split, newRange.end(), isSameTrack)) {
+                // Move whichever side of the split is smaller
+                if(split <= removed - split) {
+                    addTrackChange({.type = Type::Move, .index = start, .count = split, .to = start + removed - split});
+                }
+                else {
+                    addTrackChange({.type = Type::Move, .index = start + split, .count = removed - split, .to = start});
+                }
+                return;
+            }
+        }
+    }
+
+    if(removed > 0) {
+        addTrackChange({.type = Type::Remove, .index = start, .count = removed});
+    }
+    if(inserted > 0) {
+        addTrackChange({.type   = Type::Insert,
+                        .index  = start,
+                        .count  = inserted,
+                        .tracks = {newTracks.cbegin() + start, newTracks.cbegin() + start + inserted}});
+    }
+}
+
+void PlaylistPrivate::resetTrackChanges(bool recorded)
+{
+    m_trackChanges.clear();
+    m_trackChangesRecorded = recorded;
+}
+
 Playlist::Playlist(PrivateKey /*key*/, int dbId, QString name, int index, SettingsManager* settings)
     : p{std::make_unique<PlaylistPrivate>(dbId, std::move(name), index, settings)}
 { }
@@ -570,6 +676,14 @@ bool Playlist::tracksModified() const
     return p->m_tracksModified;
 }
 
+std::optional<Playlist::TrackChanges> Playlist::trackChanges() const
+{
+    if(!p->m_trackChangesRecorded) {
+        return {};
+    }
+    return p->m_trackChanges;
+}
+
 bool Playlist::isTemporary() const
 {
     return p->m_isTemporary;
@@ -652,6 +766,7 @@ void Playlist::resetFlags()
 {
     p->m_modified       = false;
     p->m_tracksModified = false;
+    p->resetTrackChanges(true);
 }
 
 QStringList Playlist::supportedPlaylistExtensions()
@@ -710,11 +825,15 @@ void Playlist::setModified(bool modified)
 void Playlist::setTracksModified(bool modified)
 {
     p->m_tracksModified = modified;
+    // Changes can't be known if marked as modified externally
+    p->resetTrackChanges(!modified);
 }
 
 void Playlist::replaceTracks(const TrackList& tracks)
 {
-    if(std::exchange(p->m_tracks, tracks) != tracks) {
+    const TrackList oldTracks = std::exchange(p->m_tracks, tracks);
+    if(!std::ranges::equal(oldTracks, tracks, isSameTrack)) {
+        p->addTrackChanges(oldTracks, tracks);
         p->m_tracksModified = true;
         p->m_trackShuffleOrder.clear();
         p->m_albumShuffleOrder.clear();
@@ -727,6 +846,10 @@ void Playlist::appendTracks(const TrackList& tracks)
         return;
     }
 
+    p->addTrackChange({.type   = TrackChange::Type::Insert,
+                       .index  = trackCount(),
+                       .count  = static_cast<int>(tracks.size()),
+                       .tracks = tracks});
     std::ranges::copy(tracks, std::back_inserter(p->m_tracks));
     p->m_tracksModified = true;
     p->m_trackShuffleOrder.clear();
@@ -802,6 +925,7 @@ std::vector<int> Playlist::removeTracks(const std::vector<int>& indexes)
 
         p->m_tracks.erase(p->m_tracks.begin() + index);
         removedIndexes.emplace_back(index);
+        p->addTrackChange({.type = TrackChange::Type::Remove, .index = index, .count = 1});
 
         std::erase_if(p->m_trackShuffleOrder, [index](int num) { return num == index; });
         for(auto& num : p->m_trackShuffleOrder) {
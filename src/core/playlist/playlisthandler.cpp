@@ -87,6 +87,8 @@ public:
     MusicLibrary* m_library;
     SettingsManager* m_settings;
     PlaylistDatabase m_playlistConnector;
+    // Used to load playlists, so they aren't held up by library writes
+    PlaylistDatabase m_playlistReader;
 
     std::vector<std::unique_ptr<Playlist>> m_playlists;
     std::vector<std::unique_ptr<Playlist>> m_removedPlaylists;
@@ -107,11 +109,12 @@ PlaylistHandlerPrivate::PlaylistHandlerPrivate(PlaylistHandler* self, DbConnecti
 {
     const DbConnectionProvider dbProvider{m_dbPool};
     m_playlistConnector.initialise(dbProvider);
+    m_playlistReader.initialise(DbConnectionProvider{m_dbPool, DbConnection::Mode::ReadOnly});
 }
 
 void PlaylistHandlerPrivate::reloadPlaylists()
 {
-    const std::vector<PlaylistInfo> infos = m_playlistConnector.getAllPlaylists();
+    const std::vector<PlaylistInfo> infos = m_playlistReader.getAllPlaylists();
 
     for(const auto& info : infos) {
         if(info.isAutoPlaylist) {
@@ -137,8 +140,11 @@ void PlaylistHandlerPrivate::populatePlaylists()
             playlist->regenerateTracks(tracks);
         }
         else {
-            const TrackList playlistTracks = m_playlistConnector.getPlaylistTracks(*playlist, idTracks);
+            bool inSync{true};
+            const TrackList playlistTracks = m_playlistReader.getPlaylistTracks(*playlist, idTracks, &inSync);
             playlist->replaceTracks(playlistTracks);
+            // Later changes are saved relative to the stored tracks, so only rewrite them if they differ
+            playlist->setTracksModified(!inSync);
         }
     }
 
@@ -31,6 +31,8 @@
 #include <QDateTime>
 #include <QDebug>
 
+#include <set>
+
 using namespace Qt::StringLiterals;
 
 using TokenType = Fooyin::ScriptScanner::TokenType;
@@ -112,6 +114,30 @@ QStringList evalStringList(const Fooyin::ScriptResult& evalExpr, const QStringLi
     return listResult;
 }
 
+// Returns true if the script reads fields which may be deferred (see Track::setFieldsDeferred).
+// Function arguments are checked as well, to catch fields accessed with e.g. $meta(comment).
+bool usesDeferredFields(const Fooyin::ExpressionList& expressions)
+{
+    using namespace Fooyin::Constants::MetaData;
+    static const std::set<QString> deferredFields{
+        QString::fromLatin1(Comment),  QString::fromLatin1(CodecProfile), QString::fromLatin1(Tool),
+        QString::fromLatin1(TagType), QString::fromLatin1(Encoding)};
+
+    return std::ranges::any_of(expressions, [](const Fooyin::Expression& expr) {
+        if(const auto* list = std::get_if<Fooyin::ExpressionList>(&expr.value)) {
+            return usesDeferredFields(*list);
+        }
+        if(const auto* func = std::get_if<Fooyin::FuncValue>(&expr.value)) {
+            return usesDeferredFields(func->args);
+        }
+        if(expr.type == Fooyin::Expr::Literal || expr.type == Fooyin::Expr::Variable
+           || expr.type == Fooyin::Expr::VariableList || expr.type == Fooyin::Expr::VariableRaw) {
+            return deferredFields.contains(std::get<QString>(expr.value).toUpper());
+        }
+        return false;
+    });
+}
+
 bool matchSearch(const Fooyin::Track& track, const QString& search, bool singleString)
 {
     if(search.isEmpty()) {
@@ -1412,11 +1438,13 @@ TrackListType ScriptParserPrivate::evaluateQuery(const ParsedScript& input, cons
             }
         }
         if constexpr(std::is_same_v<TrackListType, PlaylistTrackList>) {
-            filteredTracks = m_sorter.calcSortTracks(sort, filteredTracks, PlaylistTrack::extractor,
-                                                     PlaylistTrack::extractorConst, m_sortOrder);
+            const auto permutation
+                = m_sorter.sortPermutation(sort, filteredTracks, PlaylistTrack::extractorConst, m_sortOrder);
+            filteredTracks = TrackSorter::applyPermutation(filteredTracks, permutation);
         }
         else {
-            filteredTracks = m_sorter.calcSortTracks(sort, filteredTracks, m_sortOrder);
+            const auto permutation = m_sorter.sortPermutation(sort, filteredTracks, std::identity{}, m_sortOrder);
+            filteredTracks         = TrackSorter::applyPermutation(filteredTracks, permutation);
         }
     }
 
@@ -1430,9 +1458,25 @@ ScriptResult ScriptParserPrivate::compareValues(const Expression& exp, const aut
         return {};
     }
 
-    const ScriptResult first = evalExpression(args.at(0), tracks);
-    if(!first.cond) {
-        return {};
+    std::optional<double> firstValue;
+    if constexpr(std::is_same_v<std::decay_t<decltype(tracks)>, Track>) {
+        // Compare numeric fields directly rather than formatting and parsing them again
+        if(args.at(0).type == Expr::Variable) {
+            firstValue = m_registry->numericValue(std::get<QString>(args.at(0).value), tracks);
+        }
+    }
+
+    if(!firstValue) {
+        const ScriptResult first = evalExpression(args.at(0), tracks);
+        if(!first.cond) {
+            return {};
+        }
+
+        bool ok{false};
+        firstValue = first.value.toDouble(&ok);
+        if(!ok) {
+            return {};
+        }
     }
 
     const ScriptResult second = evalExpression(args.at(1), tracks);
@@ -1441,18 +1485,13 @@ ScriptResult ScriptParserPrivate::compareValues(const Expression& exp, const aut
     }
 
     bool ok{false};
-    const double firstValue = first.value.toDouble(&ok);
-    if(!ok) {
-        return {};
-    }
-
     const double secondValue = second.value.toDouble(&ok);
     if(!ok) {
         return {};
     }
 
     ScriptResult result;
-    result.cond = comparator(firstValue, secondValue);
+    result.cond = comparator(*firstValue, secondValue);
     return result;
 }
 
@@ -1652,6 +1691,10 @@ QString ScriptParser::evaluate(const ParsedScript& input, const TrackList& track
 
     p->m_isQuery = false;
 
+    if(usesDeferredFields(input.expressions)) {
+        Track::loadDeferredFields(tracks);
+    }
+
     return p->evaluate(input, tracks);
 }
 
@@ -1694,6 +1737,10 @@ TrackList ScriptParser::filter(const ParsedScript& input, const TrackList& track
 
     p->m_isQuery = true;
 
+    if(usesDeferredFields(input.expressions)) {
+        Track::loadDeferredFields(tracks);
+    }
+
     return p->evaluateQuery(input, tracks);
 }
 
@@ -25,6 +25,7 @@
 #include "functions/timefuncs.h"
 #include "functions/tracklistfuncs.h"
 #include "library/librarymanager.h"
+#include "metafield.h"
 
 #include <core/constants.h>
 #include <core/player/playercontroller.h>
@@ -50,6 +51,7 @@ using Func                = std::variant<NativeFunc, NativeVoidFunc, NativeTrack
 using TrackFunc     = std::function<Fooyin::ScriptRegistry::FuncRet(const Fooyin::Track&)>;
 using TrackSetFunc  = std::function<void(Fooyin::Track&, const Fooyin::ScriptRegistry::FuncRet&)>;
 using TrackListFunc = std::function<Fooyin::ScriptRegistry::FuncRet(const Fooyin::TrackList&)>;
+using NumericFunc   = std::function<std::optional<double>(const Fooyin::Track&)>;
 
 template <typename FuncType>
 auto generateSetFunc(FuncType func)
@@ -136,8 +138,9 @@ public:
 
     bool m_useVariousArtists{false};
 
-    std::unordered_map<QString, TrackFunc> m_metadata;
-    std::unordered_map<QString, TrackSetFunc> m_setMetadata;
+    MetaFieldTable<TrackFunc> m_metadata;
+    MetaFieldTable<NumericFunc> m_numericMetadata;
+    MetaFieldTable<TrackSetFunc> m_setMetadata;
     std::unordered_map<QString, TrackListFunc> m_listProperties;
     std::unordered_map<QString, Func> m_funcs;
     std::unordered_map<QString, NativeVoidFunc> m_playbackVars;
@@ -294,116 +297,154 @@ void ScriptRegistryPrivate::addPlaylistVars()
 
 void ScriptRegistryPrivate::addDefaultMetadata()
 {
-    using namespace Fooyin::Constants;
-
-    m_metadata[QString::fromLatin1(MetaData::Title)]        = &Track::effectiveTitle;
-    m_metadata[QString::fromLatin1(MetaData::Artist)]       = &Track::primaryArtist;
-    m_metadata[QString::fromLatin1(MetaData::UniqueArtist)] = &Track::uniqueArtists;
-    m_metadata[QString::fromLatin1(MetaData::Album)]        = &Track::album;
-    m_metadata[QString::fromLatin1(MetaData::AlbumArtist)]  = [this](const Track& track) {
+    m_metadata[MetaField::Title]        = &Track::effectiveTitle;
+    m_metadata[MetaField::Artist]       = &Track::primaryArtist;
+    m_metadata[MetaField::UniqueArtist] = &Track::uniqueArtists;
+    m_metadata[MetaField::Album]        = &Track::album;
+    m_metadata[MetaField::AlbumArtist]  = [this](const Track& track) {
         return track.effectiveAlbumArtist(m_useVariousArtists);
     };
-    m_metadata[QString::fromLatin1(MetaData::Track)]      = &Track::trackNumber;
-    m_metadata[QString::fromLatin1(MetaData::TrackTotal)] = &Track::trackTotal;
-    m_metadata[QString::fromLatin1(MetaData::Disc)]       = &Track::discNumber;
-    m_metadata[QString::fromLatin1(MetaData::DiscTotal)]  = &Track::discTotal;
-    m_metadata[QString::fromLatin1(MetaData::Genre)]      = &Track::genres;
-    m_metadata[QString::fromLatin1(MetaData::Composer)]   = &Track::composer;
-    m_metadata[QString::fromLatin1(MetaData::Performer)]  = &Track::performer;
-    m_metadata[QString::fromLatin1(MetaData::Duration)]   = [](const Track& track) {
+    m_metadata[MetaField::Track]      = &Track::trackNumber;
+    m_metadata[MetaField::TrackTotal] = &Track::trackTotal;
+    m_metadata[MetaField::Disc]       = &Track::discNumber;
+    m_metadata[MetaField::DiscTotal]  = &Track::discTotal;
+    m_metadata[MetaField::Genre]      = &Track::genres;
+    m_metadata[MetaField::Composer]   = &Track::composer;
+    m_metadata[MetaField::Performer]  = &Track::performer;
+    m_metadata[MetaField::Duration]   = [](const Track& track) {
         const auto duration = track.duration();
         return duration == 0 ? QString{} : Utils::msToString(duration);
     };
-    m_metadata[QString::fromLatin1(MetaData::DurationSecs)] = [](const Track& track) {
+    m_metadata[MetaField::DurationSecs] = [](const Track& track) {
         const auto duration = track.duration();
         return duration == 0 ? QString{} : QString::number(duration / 1000);
     };
-    m_metadata[QString::fromLatin1(MetaData::DurationMSecs)] = [](const Track& track) {
+    m_metadata[MetaField::DurationMSecs] = [](const Track& track) {
         const auto duration = track.duration();
         return duration == 0 ? QString{} : QString::number(duration);
     };
-    m_metadata[QString::fromLatin1(MetaData::Comment)]         = &Track::comment;
-    m_metadata[QString::fromLatin1(MetaData::Date)]            = &Track::date;
-    m_metadata[QString::fromLatin1(MetaData::Year)]            = &Track::year;
-    m_metadata[QString::fromLatin1(MetaData::FileSize)]        = &Track::fileSize;
-    m_metadata[QString::fromLatin1(MetaData::FileSizeNatural)] = [](const Track& track) {
+    m_metadata[MetaField::Comment]         = &Track::comment;
+    m_metadata[MetaField::Date]            = &Track::date;
+    m_metadata[MetaField::Year]            = &Track::year;
+    m_metadata[MetaField::FileSize]        = &Track::fileSize;
+    m_metadata[MetaField::FileSizeNatural] = [](const Track& track) {
         return Utils::formatFileSize(track.fileSize());
     };
-    m_metadata[QString::fromLatin1(MetaData::Bitrate)] = [this](const Track& track) {
+    m_metadata[MetaField::Bitrate] = [this](const Track& track) {
         return getBitrate(track);
     };
-    m_metadata[QString::fromLatin1(MetaData::SampleRate)] = [](const Track& track) {
+    m_metadata[MetaField::SampleRate] = [](const Track& track) {
         return track.sampleRate() > 0 ? QString::number(track.sampleRate()) : QString{};
     };
-    m_metadata[QString::fromLatin1(MetaData::BitDepth)] = [](const Track& track) {
+    m_metadata[MetaField::BitDepth] = [](const Track& track) {
         return track.bitDepth() > 0 ? track.bitDepth() : -1;
     };
-    m_metadata[QString::fromLatin1(MetaData::FirstPlayed)] = [](const Track& track) {
+    m_metadata[MetaField::FirstPlayed] = [](const Track& track) {
         return formatDateTime(track.firstPlayed());
     };
-    m_metadata[QString::fromLatin1(MetaData::LastPlayed)] = [](const Track& track) {
+    m_metadata[MetaField::LastPlayed] = [](const Track& track) {
         return formatDateTime(track.lastPlayed());
     };
-    m_metadata[QString::fromLatin1(MetaData::PlayCount)]    = &Track::playCount;
-    m_metadata[QString::fromLatin1(MetaData::Rating)]       = &Track::rating;
-    m_metadata[QString::fromLatin1(MetaData::RatingStars)]  = &Track::ratingStars;
-    m_metadata[QString::fromLatin1(MetaData::RatingEditor)] = &Track::ratingStars;
-    m_metadata[QString::fromLatin1(MetaData::Codec)]        = [](const Track& track) {
+    m_metadata[MetaField::PlayCount]    = &Track::playCount;
+    m_metadata[MetaField::Rating]       = &Track::rating;
+    m_metadata[MetaField::RatingStars]  = &Track::ratingStars;
+    m_metadata[MetaField::RatingEditor] = &Track::ratingStars;
+    m_metadata[MetaField::Codec]        = [](const Track& track) {
         return !track.codec().isEmpty() ? track.codec() : track.extension().toUpper();
     };
-    m_metadata[QString::fromLatin1(MetaData::CodecProfile)] = &Track::codecProfile;
-    m_metadata[QString::fromLatin1(MetaData::Tool)]         = &Track::tool;
-    m_metadata[QString::fromLatin1(MetaData::TagType)]      = [](const Track& track) {
+    m_metadata[MetaField::CodecProfile] = &Track::codecProfile;
+    m_metadata[MetaField::Tool]         = &Track::tool;
+    m_metadata[MetaField::TagType]      = [](const Track& track) {
         return track.tagType(u" | "_s);
     };
-    m_metadata[QString::fromLatin1(MetaData::Encoding)]  = &Track::encoding;
-    m_metadata[QString::fromLatin1(MetaData::Channels)]  = trackChannels;
-    m_metadata[QString::fromLatin1(MetaData::AddedTime)] = [](const Track& track) {
+    m_metadata[MetaField::Encoding]  = &Track::encoding;
+    m_metadata[MetaField::Channels]  = trackChannels;
+    m_metadata[MetaField::AddedTime] = [](const Track& track) {
         return formatDateTime(track.addedTime());
     };
-    m_metadata[QString::fromLatin1(MetaData::LastModified)] = [](const Track& track) {
+    m_metadata[MetaField::LastModified] = [](const Track& track) {
         return formatDateTime(track.lastModified());
     };
-    m_metadata[QString::fromLatin1(MetaData::FilePath)]        = &Track::filepath;
-    m_metadata[QString::fromLatin1(MetaData::FileName)]        = &Track::filename;
-    m_metadata[QString::fromLatin1(MetaData::Extension)]       = &Track::extension;
-    m_metadata[QString::fromLatin1(MetaData::FileNameWithExt)] = &Track::filenameExt;
-    m_metadata[QString::fromLatin1(MetaData::Directory)]       = &Track::directory;
-    m_metadata[QString::fromLatin1(MetaData::Path)]            = &Track::path;
-    m_metadata[QString::fromLatin1(MetaData::Subsong)]         = &Track::subsong;
-    m_metadata[QString::fromLatin1(MetaData::RGTrackGain)]     = [](const Track& track) {
+    m_metadata[MetaField::FilePath]        = &Track::filepath;
+    m_metadata[MetaField::FileName]        = &Track::filename;
+    m_metadata[MetaField::Extension]       = &Track::extension;
+    m_metadata[MetaField::FileNameWithExt] = &Track::filenameExt;
+    m_metadata[MetaField::Directory]       = &Track::directory;
+    m_metadata[MetaField::Path]            = &Track::path;
+    m_metadata[MetaField::Subsong]         = &Track::subsong;
+    m_metadata[MetaField::RGTrackGain]     = [](const Track& track) {
         return formatGain(track.rgTrackGain());
     };
-    m_metadata[QString::fromLatin1(MetaData::RGTrackPeak)]   = &Track::rgTrackPeak;
-    m_metadata[QString::fromLatin1(MetaData::RGTrackPeakDB)] = [](const Track& track) {
+    m_metadata[MetaField::RGTrackPeak]   = &Track::rgTrackPeak;
+    m_metadata[MetaField::RGTrackPeakDB] = [](const Track& track) {
         return formatPeak(track.rgTrackPeak());
     };
-    m_metadata[QString::fromLatin1(MetaData::RGAlbumGain)] = [](const Track& track) {
+    m_metadata[MetaField::RGAlbumGain] = [](const Track& track) {
         return formatGain(track.rgAlbumGain());
     };
-    m_metadata[QString::fromLatin1(MetaData::RGAlbumPeak)]   = &Track::rgAlbumPeak;
-    m_metadata[QString::fromLatin1(MetaData::RGAlbumPeakDB)] = [](const Track& track) {
+    m_metadata[MetaField::RGAlbumPeak]   = &Track::rgAlbumPeak;
+    m_metadata[MetaField::RGAlbumPeakDB] = [](const Track& track) {
         return formatPeak(track.rgAlbumPeak());
     };
 
-    m_setMetadata[QString::fromLatin1(MetaData::Title)]        = generateSetFunc(&Track::setTitle);
-    m_setMetadata[QString::fromLatin1(MetaData::Artist)]       = generateSetFunc(&Track::setArtists);
-    m_setMetadata[QString::fromLatin1(MetaData::Album)]        = generateSetFunc(&Track::setAlbum);
-    m_setMetadata[QString::fromLatin1(MetaData::AlbumArtist)]  = generateSetFunc(&Track::setAlbumArtists);
-    m_setMetadata[QString::fromLatin1(MetaData::Track)]        = generateSetFunc(&Track::setTrackNumber);
-    m_setMetadata[QString::fromLatin1(MetaData::TrackTotal)]   = generateSetFunc(&Track::setTrackTotal);
-    m_setMetadata[QString::fromLatin1(MetaData::Disc)]         = generateSetFunc(&Track::setDiscNumber);
-    m_setMetadata[QString::fromLatin1(MetaData::DiscTotal)]    = generateSetFunc(&Track::setDiscTotal);
-    m_setMetadata[QString::fromLatin1(MetaData::Genre)]        = generateSetFunc(&Track::setGenres);
-    m_setMetadata[QString::fromLatin1(MetaData::Composer)]     = generateSetFunc(&Track::setComposers);
-    m_setMetadata[QString::fromLatin1(MetaData::Performer)]    = generateSetFunc(&Track::setPerformers);
-    m_setMetadata[QString::fromLatin1(MetaData::Duration)]     = generateSetFunc(&Track::setDuration);
-    m_setMetadata[QString::fromLatin1(MetaData::Comment)]      = generateSetFunc(&Track::setComment);
-    m_setMetadata[QString::fromLatin1(MetaData::Rating)]       = generateSetFunc(&Track::setRating);
-    m_setMetadata[QString::fromLatin1(MetaData::RatingStars)]  = generateSetFunc(&Track::setRatingStars);
-    m_setMetadata[QString::fromLatin1(MetaData::RatingEditor)] = generateSetFunc(&Track::setRatingStars);
-    m_setMetadata[QString::fromLatin1(MetaData::Date)]         = generateSetFunc(&Track::setDate);
-    m_setMetadata[QString::fromLatin1(MetaData::Year)]         = generateSetFunc(&Track::setYear);
+    // Only fields whose string form is an exact integer, so comparisons give the same result either way
+    const auto unlessNegative = [](auto value) -> std::optional<double> {
+        return value >= 0 ? std::optional<double>{static_cast<double>(value)} : std::nullopt;
+    };
+    m_numericMetadata[MetaField::Track] = [unlessNegative](const Track& track) {
+        return unlessNegative(track.trackNumberValue());
+    };
+    m_numericMetadata[MetaField::TrackTotal] = [unlessNegative](const Track& track) {
+        return unlessNegative(track.trackTotalValue());
+    };
+    m_numericMetadata[MetaField::Disc] = [unlessNegative](const Track& track) {
+        return unlessNegative(track.discNumberValue());
+    };
+    m_numericMetadata[MetaField::DiscTotal] = [unlessNegative](const Track& track) {
+        return unlessNegative(track.discTotalValue());
+    };
+    m_numericMetadata[MetaField::Year] = [unlessNegative](const Track& track) {
+        return unlessNegative(track.year());
+    };
+    m_numericMetadata[MetaField::PlayCount] = [unlessNegative](const Track& track) {
+        return unlessNegative(track.playCount());
+    };
+    m_numericMetadata[MetaField::DurationSecs] = [](const Track& track) -> std::optional<double> {
+        const auto duration = track.duration();
+        return duration == 0 ? std::nullopt : std::optional<double>{static_cast<double>(duration / 1000)};
+    };
+    m_numericMetadata[MetaField::DurationMSecs] = [](const Track& track) -> std::optional<double> {
+        const auto duration = track.duration();
+        return duration == 0 ? std::nullopt : std::optional<double>{static_cast<double>(duration)};
+    };
+    m_numericMetadata[MetaField::SampleRate] = [](const Track& track) -> std::optional<double> {
+        return track.sampleRate() > 0 ? std::optional<double>{track.sampleRate()} : std::nullopt;
+    };
+    m_numericMetadata[MetaField::BitDepth] = [](const Track& track) -> std::optional<double> {
+        return track.bitDepth() > 0 ? std::optional<double>{track.bitDepth()} : std::nullopt;
+    };
+    m_numericMetadata[MetaField::FileSize] = [](const Track& track) {
+        return std::optional<double>{static_cast<double>(track.fileSize())};
+    };
+
+    m_setMetadata[MetaField::Title]        = generateSetFunc(&Track::setTitle);
+    m_setMetadata[MetaField::Artist]       = generateSetFunc(&Track::setArtists);
+    m_setMetadata[MetaField::Album]        = generateSetFunc(&Track::setAlbum);
+    m_setMetadata[MetaField::AlbumArtist]  = generateSetFunc(&Track::setAlbumArtists);
+    m_setMetadata[MetaField::Track]        = generateSetFunc(&Track::setTrackNumber);
+    m_setMetadata[MetaField::TrackTotal]   = generateSetFunc(&Track::setTrackTotal);
+    m_setMetadata[MetaField::Disc]         = generateSetFunc(&Track::setDiscNumber);
+    m_setMetadata[MetaField::DiscTotal]    = generateSetFunc(&Track::setDiscTotal);
+    m_setMetadata[MetaField::Genre]        = generateSetFunc(&Track::setGenres);
+    m_setMetadata[MetaField::Composer]     = generateSetFunc(&Track::setComposers);
+    m_setMetadata[MetaField::Performer]    = generateSetFunc(&Track::setPerformers);
+    m_setMetadata[MetaField::Duration]     = generateSetFunc(&Track::setDuration);
+    m_setMetadata[MetaField::Comment]      = generateSetFunc(&Track::setComment);
+    m_setMetadata[MetaField::Rating]       = generateSetFunc(&Track::setRating);
+    m_setMetadata[MetaField::RatingStars]  = generateSetFunc(&Track::setRatingStars);
+    m_setMetadata[MetaField::RatingEditor] = generateSetFunc(&Track::setRatingStars);
+    m_setMetadata[MetaField::Date]         = generateSetFunc(&Track::setDate);
+    m_setMetadata[MetaField::Year]         = generateSetFunc(&Track::setYear);
 }
 
 QString ScriptRegistryPrivate::getBitrate(const Track& track) const
@@ -455,9 +496,12 @@ ScriptRegistry::~ScriptRegistry() = default;
 
 bool ScriptRegistry::isVariable(const QString& var, const Track& track) const
 {
+    if(p->m_metadata.find(var)) {
+        return true;
+    }
+
     const QString variable = var.toUpper();
-    return p->m_metadata.contains(variable) || p->m_playbackVars.contains(variable)
-        || p->m_libraryVars.contains(variable) || track.hasExtraTag(variable);
+    return p->m_playbackVars.contains(variable) || p->m_libraryVars.contains(variable) || track.hasExtraTag(variable);
 }
 
 bool ScriptRegistry::isVariable(const QString& var, const TrackList& tracks) const
@@ -478,17 +522,27 @@ bool ScriptRegistry::isFunction(const QString& func) const
     return p->m_funcs.contains(func);
 }
 
+std::optional<double> ScriptRegistry::numericValue(const QString& var, const Track& track) const
+{
+    if(const auto* func = p->m_numericMetadata.find(var)) {
+        return (*func)(track);
+    }
+    return {};
+}
+
 ScriptResult ScriptRegistry::value(const QString& var, const Track& track) const
 {
+    // Resolved without allocating, as this is evaluated for every field of every track
+    if(const auto* func = p->m_metadata.find(var)) {
+        return calculateResult((*func)(track));
+    }
+
     if(var.isEmpty() || (!isVariable(var, track) && !isListVariable(var))) {
         return {};
     }
 
     const QString variable = var.toUpper();
 
-    if(p->m_metadata.contains(variable)) {
-        return calculateResult(p->m_metadata.at(variable)(track));
-    }
     if(p->m_playbackVars.contains(variable)) {
         return calculateResult(p->m_playbackVars.at(variable)());
     }
@@ -515,8 +569,8 @@ ScriptResult ScriptRegistry::value(const QString& var, const TrackList& tracks)
     }
 
     if(!tracks.empty()) {
-        if(p->m_metadata.contains(variable)) {
-            return calculateResult(p->m_metadata.at(variable)(tracks.front()));
+        if(const auto* func = p->m_metadata.find(var)) {
+            return calculateResult((*func)(tracks.front()));
         }
         return calculateResult(tracks.front().extraTag(variable.toUpper()));
     }
@@ -606,13 +660,13 @@ void ScriptRegistry::setValue(const QString& var, const FuncRet& value, Track& t
         return;
     }
 
-    const QString tag = var.toUpper();
-
-    if(p->m_setMetadata.contains(tag)) {
-        p->m_setMetadata.at(tag)(track, value);
+    if(const auto* func = p->m_setMetadata.find(var)) {
+        (*func)(track, value);
         return;
     }
 
+    const QString tag = var.toUpper();
+
     const auto setOrAddTag = [&](const auto& val) {
         if(track.hasExtraTag(tag)) {
             track.replaceExtraTag(tag, val);
@@ -20,25 +20,98 @@
 #include "core/constants.h"
 #include <core/track.h>
 
-#include <utils/crypto.h>
+#include "metafield.h"
+
+#include <utils/fasthash.h>
+#include <utils/stringpool.h>
 #include <utils/utils.h>
 
 #include <QDir>
 #include <QFileInfo>
 #include <QIODevice>
-#include <QRegularExpression>
+#include <QtEndian>
 
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <mutex>
 #include <ranges>
 
 using namespace Qt::StringLiterals;
 
-constexpr auto MaxStarCount   = 10;
-constexpr auto YearRegex      = R"lit(\b\d{4}\b)lit";
-constexpr auto YearMonthRegex = R"lit(\b(\d{4})-(\d{2})\b)lit";
-constexpr auto FullDateRegex  = R"lit(\b(\d{4})-(\d{2})-(\d{2})\b)lit";
+constexpr auto MaxStarCount = 10;
 
 namespace {
+// Values repeated across many tracks share a buffer from the pool
+QString intern(const QString& str)
+{
+    return Fooyin::StringPool::instance().intern(str);
+}
+
+QStringList intern(const QStringList& strs)
+{
+    return Fooyin::StringPool::instance().intern(strs);
+}
+
+// Unset or non-numeric values are stored as -1
+int toNumber(const QString& str)
+{
+    bool ok{false};
+    const int number = str.toInt(&ok);
+    return ok && number >= 0 ? number : -1;
+}
+
+bool isWordChar(QChar ch)
+{
+    return ch.isLetterOrNumber() || ch == u'_';
+}
+
+/*!
+ * Finds the first date in @p date made up of @p parts: a 4 digit year, then 2 digit month and day,
+ * separated by '-' and bounded by non-word characters.
+ * Equivalent to matching \b\d{4}\b, \b\d{4}-\d{2}\b or \b\d{4}-\d{2}-\d{2}\b, without a regex.
+ */
+std::optional<std::array<int, 3>> findDate(QStringView date, int parts)
+{
+    const qsizetype length = 4 + (static_cast<qsizetype>(parts) - 1) * 3;
+
+    for(qsizetype start{0}; start + length <= date.size(); ++start) {
+        if((start > 0 && isWordChar(date.at(start - 1)))
+           || (start + length < date.size() && isWordChar(date.at(start + length)))) {
+            continue;
+        }
+
+        std::array<int, 3> values{0, 1, 1};
+        qsizetype pos{start};
+        bool matched{true};
+
+        for(int part{0}; part < parts && matched; ++part) {
+            if(part > 0 && date.at(pos++) != u'-') {
+                matched = false;
+                break;
+            }
+
+            const int digits = part == 0 ? 4 : 2;
+            int value{0};
+            for(int i{0}; i < digits; ++i) {
+                const char16_t ch = date.at(pos++).unicode();
+                if(ch < u'0' || ch > u'9') {
+                    matched = false;
+                    break;
+                }
+                value = value * 10 + (ch - u'0');
+            }
+            values.at(part) = value;
+        }
+
+        if(matched) {
+            return values;
+        }
+    }
+
+    return {};
+}
+
 QString validNum(auto num)
 {
     if(num > 0) {
@@ -47,36 +120,68 @@ QString validNum(auto num)
     return {};
 };
 
-using MetaMap = std::unordered_map<QString, std::function<QString(const Fooyin::Track& track)>>;
-MetaMap metaMap()
-{
-    using namespace Fooyin::Constants::MetaData;
-    // clang-format off
-    static const MetaMap metaMap{
-        {QString::fromLatin1(Title),        [](const Fooyin::Track& track) { return track.title(); }},
-        {QString::fromLatin1(Artist),       [](const Fooyin::Track& track) { return track.artist(); }},
-        {QString::fromLatin1(Album),        [](const Fooyin::Track& track) { return track.album(); }},
-        {QString::fromLatin1(AlbumArtist),  [](const Fooyin::Track& track) { return track.albumArtist(); }},
-        {QString::fromLatin1(Track),        [](const Fooyin::Track& track) { return track.trackNumber(); }},
-        {QString::fromLatin1(TrackTotal),   [](const Fooyin::Track& track) { return track.trackTotal(); }},
-        {QString::fromLatin1(Disc),         [](const Fooyin::Track& track) { return track.discNumber(); }},
-        {QString::fromLatin1(DiscTotal),    [](const Fooyin::Track& track) { return track.discTotal(); }},
-        {QString::fromLatin1(Genre),        [](const Fooyin::Track& track) { return track.genre(); }},
-        {QString::fromLatin1(Composer),     [](const Fooyin::Track& track) { return track.composer(); }},
-        {QString::fromLatin1(Performer),    [](const Fooyin::Track& track) { return track.performer(); }},
-        {QString::fromLatin1(Comment),      [](const Fooyin::Track& track) { return track.comment(); }},
-        {QString::fromLatin1(Date),         [](const Fooyin::Track& track) { return track.date(); }},
-        {QString::fromLatin1(Year),         [](const Fooyin::Track& track) { return validNum(track.year()); }},
-        {QString::fromLatin1(Rating),       [](const Fooyin::Track& track) { return validNum(track.rating()); }},
-        {QString::fromLatin1(RatingEditor), [](const Fooyin::Track& track) { return validNum(track.rating()); }},
-        {QString::fromLatin1(RatingStars),  [](const Fooyin::Track& track) { return validNum(track.ratingStars()); }}
-    };
-    // clang-format on
-    return metaMap;
+// Fields stored as tags, rather than calculated or read from the file's properties
+bool isTrackTag(Fooyin::MetaField field)
+{
+    using Fooyin::MetaField;
+
+    switch(field) {
+        case(MetaField::Title):
+        case(MetaField::Artist):
+        case(MetaField::Album):
+        case(MetaField::AlbumArtist):
+        case(MetaField::Track):
+        case(MetaField::TrackTotal):
+        case(MetaField::Disc):
+        case(MetaField::DiscTotal):
+        case(MetaField::Genre):
+        case(MetaField::Composer):
+        case(MetaField::Performer):
+        case(MetaField::Comment):
+        case(MetaField::Date):
+        case(MetaField::Year):
+        case(MetaField::Rating):
+        case(MetaField::RatingEditor):
+        case(MetaField::RatingStars):
+            return true;
+        default:
+            return false;
+    }
 }
 } // namespace
 
 namespace Fooyin {
+/*!
+ * Fields which are rarely needed, so may be left out when loading the library.
+ * They're then fetched from the database on first access using the loader set with
+ * Track::setDeferredLoader. As this can happen from any thread, @c pending is only
+ * cleared once the fields have been written.
+ */
+class TrackDeferredData : public QSharedData
+{
+public:
+    TrackDeferredData() = default;
+    TrackDeferredData(const TrackDeferredData& other)
+        : QSharedData{other}
+        , pending{other.pending.load(std::memory_order_acquire)}
+        , comment{other.comment}
+        , tool{other.tool}
+        , tagTypes{other.tagTypes}
+        , encoding{other.encoding}
+        , extraProps{other.extraProps}
+    { }
+
+    TrackDeferredData& operator=(const TrackDeferredData& other) = delete;
+
+    std::atomic_bool pending{false};
+
+    QString comment;
+    QString tool;
+    QStringList tagTypes;
+    QString encoding;
+    Track::ExtraProperties extraProps;
+};
+
 class TrackPrivate : public QSharedData
 {
 public:
@@ -85,8 +190,9 @@ public:
     int libraryId{-1};
     bool enabled{true};
     int id{-1};
-    QString hash;
+    uint64_t hash{0};
     QString codec;
+    QString codecProfile;
     QString filepath;
     QString directory;
     QString filename;
@@ -99,17 +205,20 @@ public:
     QString trackTotal;
     QString discNumber;
     QString discTotal;
+    // Parsed from the strings above when set
+    int trackNumberValue{-1};
+    int trackTotalValue{-1};
+    int discNumberValue{-1};
+    int discTotalValue{-1};
     QStringList genres;
     QStringList composers;
     QStringList performers;
-    QString comment;
     QString date;
     int year{-1};
-    int64_t dateSinceEpoch;
-    int64_t yearSinceEpoch;
+    std::optional<int64_t> dateSinceEpoch;
+    std::optional<int64_t> yearSinceEpoch;
     Track::ExtraTags extraTags;
     QStringList removedTags;
-    Track::ExtraProperties extraProps;
 
     QString cuePath;
 
@@ -121,10 +230,6 @@ public:
     int sampleRate{0};
     int channels{2};
     int bitDepth{-1};
-    QString codecProfile;
-    QString tool;
-    QStringList tagTypes;
-    QString encoding;
 
     float rating{-1};
     int playcount{0};
@@ -138,15 +243,15 @@ public:
     float rgTrackPeak{Constants::InvalidPeak};
     float rgAlbumPeak{Constants::InvalidPeak};
 
-    QString sort;
-
     bool metadataWasModified{false};
-    bool isNewTrack{true};
 
     // Archive related
     bool isInArchive{false};
     QString archivePath;
     QString filepathWithinArchive;
+
+    // Shared between copies until modified, so a load is seen by every copy
+    QSharedDataPointer<TrackDeferredData> deferred{new TrackDeferredData()};
 };
 
 void TrackPrivate::splitArchiveUrl()
@@ -166,12 +271,92 @@ void TrackPrivate::splitArchiveUrl()
 
     const QFileInfo info{filepathWithinArchive};
     filename  = info.completeBaseName();
-    extension = info.suffix().toLower();
+    extension = intern(info.suffix().toLower());
     directory = info.dir().dirName();
     if(directory == "."_L1) {
         directory = QFileInfo{archivePath}.fileName();
     }
+    directory = intern(directory);
+}
+
+namespace {
+// Striped rather than a mutex per track
+std::mutex& deferredMutex(const TrackDeferredData* data)
+{
+    static std::array<std::mutex, 64> mutexes;
+    return mutexes.at(std::hash<const TrackDeferredData*>{}(data) % mutexes.size());
+}
+
+std::mutex& loaderMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+Track::DeferredLoader& deferredLoader()
+{
+    static Track::DeferredLoader loader;
+    return loader;
+}
+
+void loadDeferred(const TrackIds& ids, const std::vector<TrackDeferredData*>& pending)
+{
+    if(pending.empty()) {
+        return;
+    }
+
+    Track::DeferredLoader loader;
+    {
+        const std::scoped_lock lock{loaderMutex()};
+        loader = deferredLoader();
+    }
+
+    TrackList loaded;
+    // Left pending on failure, so the fields aren't later written back empty
+    if(!loader || !loader(ids, loaded)) {
+        return;
+    }
+
+    std::unordered_map<int, const Track*> loadedTracks;
+    for(const Track& track : loaded) {
+        loadedTracks.emplace(track.id(), &track);
+    }
+
+    for(size_t i{0}; i < pending.size(); ++i) {
+        TrackDeferredData* data = pending.at(i);
+
+        const std::scoped_lock lock{deferredMutex(data)};
+        if(!data->pending.load(std::memory_order_relaxed)) {
+            // Loaded by another thread in the meantime
+            continue;
+        }
+
+        if(const auto trackIt = loadedTracks.find(ids.at(i)); trackIt != loadedTracks.cend()) {
+            const Track& track = *trackIt->second;
+
+            data->comment    = track.comment();
+            data->tool       = track.tool();
+            data->tagTypes   = track.tagTypes();
+            data->encoding   = track.encoding();
+            data->extraProps = track.extraProperties();
+        }
+
+        data->pending.store(false, std::memory_order_release);
+    }
+}
+
+// Returns the deferred fields of @p p, loading them first if needed.
+// Setters call this before detaching so a copy never misses fields which are still to be loaded.
+const TrackDeferredData& deferredData(const QSharedDataPointer<TrackPrivate>& p)
+{
+    const TrackDeferredData* data = p->deferred.constData();
+    if(data->pending.load(std::memory_order_acquire)) {
+        // Shared data is only modified under its mutex while pending
+        loadDeferred({p->id}, {const_cast<TrackDeferredData*>(data)});
+    }
+    return *data;
 }
+} // namespace
 
 Track::Track()
     : Track{{}}
@@ -208,15 +393,36 @@ bool Track::operator<(const Track& other) const
     return uniqueFilepath() < other.uniqueFilepath();
 }
 
-QString Track::generateHash()
+uint64_t Track::generateHash()
 {
-    QString title = p->title;
-    if(title.isEmpty()) {
-        title = p->directory + p->filename;
+    FastHash hash;
+
+    // Fields are separated so the same text split differently doesn't match
+    const auto addField = [&hash](QStringView field) {
+        static constexpr char16_t FieldSeparator{u'\x1f'};
+        hash.addData(field);
+        hash.addData(&FieldSeparator, sizeof(FieldSeparator));
+    };
+
+    for(const QString& artist : std::as_const(p->artists)) {
+        addField(artist);
+    }
+    addField(p->album);
+    addField(p->discNumber);
+    addField(p->trackNumber);
+
+    if(p->title.isEmpty()) {
+        hash.addData(p->directory);
+        addField(p->filename);
+    }
+    else {
+        addField(p->title);
     }
 
-    p->hash = Utils::generateHash(p->artists.join(","_L1), p->album, p->discNumber, p->trackNumber, title,
-                                  QString::number(p->subsong));
+    const auto subsong = qToLittleEndian(static_cast<int32_t>(p->subsong));
+    hash.addData(&subsong, sizeof(subsong));
+
+    p->hash = hash.result();
     return p->hash;
 }
 
@@ -259,11 +465,6 @@ bool Track::exists() const
     return QFileInfo::exists(filepath());
 }
 
-bool Track::isNewTrack() const
-{
-    return p->isNewTrack;
-}
-
 int Track::libraryId() const
 {
     return p->libraryId;
@@ -294,7 +495,7 @@ int Track::id() const
     return p->id;
 }
 
-QString Track::hash() const
+uint64_t Track::hash() const
 {
     return p->hash;
 }
@@ -483,6 +684,26 @@ QString Track::discTotal() const
     return p->discTotal;
 }
 
+int Track::trackNumberValue() const
+{
+    return p->trackNumberValue;
+}
+
+int Track::trackTotalValue() const
+{
+    return p->trackTotalValue;
+}
+
+int Track::discNumberValue() const
+{
+    return p->discNumberValue;
+}
+
+int Track::discTotalValue() const
+{
+    return p->discTotalValue;
+}
+
 QStringList Track::genres() const
 {
     return p->genres;
@@ -515,7 +736,7 @@ QString Track::performer() const
 
 QString Track::comment() const
 {
-    return p->comment;
+    return deferredData(p).comment;
 }
 
 QString Track::date() const
@@ -605,26 +826,18 @@ bool Track::isArchivePath(const QString& path)
 
 bool Track::isMultiValueTag(const QString& tag)
 {
-    const QString trackTag = tag.toUpper();
-
-    const auto map = metaMap();
-    if(!map.contains(trackTag)) {
+    const MetaField field = metaField(tag);
+    if(!isTrackTag(field)) {
         return true;
     }
 
-    return trackTag == QLatin1String{Constants::MetaData::Artist}
-        || trackTag == QLatin1String{Constants::MetaData::AlbumArtist}
-        || trackTag == QLatin1String{Constants::MetaData::Genre}
-        || trackTag == QLatin1String{Constants::MetaData::Composer}
-        || trackTag == QLatin1String{Constants::MetaData::Performer};
+    return field == MetaField::Artist || field == MetaField::AlbumArtist || field == MetaField::Genre
+        || field == MetaField::Composer || field == MetaField::Performer;
 }
 
 bool Track::isExtraTag(const QString& tag)
 {
-    const QString trackTag = tag.toUpper();
-
-    const auto map = metaMap();
-    return !map.contains(trackTag);
+    return !isTrackTag(metaField(tag));
 }
 
 bool Track::hasExtraTag(const QString& tag) const
@@ -709,7 +922,7 @@ QMap<QString, QString> Track::metadata() const
     addField(GenreKey, p->genres);
     addField(ComposerKey, p->composers);
     addField(PerformerKey, p->performers);
-    addField(CommentKey, p->comment);
+    addField(CommentKey, deferredData(p).comment);
     addField(DateKey, p->date);
 
     return map;
@@ -717,17 +930,18 @@ QMap<QString, QString> Track::metadata() const
 
 bool Track::hasExtraProperty(const QString& prop) const
 {
-    return p->extraProps.contains(prop);
+    return deferredData(p).extraProps.contains(prop);
 }
 
 Track::ExtraProperties Track::extraProperties() const
 {
-    return p->extraProps;
+    return deferredData(p).extraProps;
 }
 
 QByteArray Track::serialiseExtraProperties() const
 {
-    if(p->extraProps.empty()) {
+    const auto& extraProps = deferredData(p).extraProps;
+    if(extraProps.empty()) {
         return {};
     }
 
@@ -735,7 +949,7 @@ QByteArray Track::serialiseExtraProperties() const
     QDataStream stream(&out, QIODevice::WriteOnly);
     stream.setVersion(QDataStream::Qt_6_0);
 
-    stream << p->extraProps;
+    stream << extraProps;
 
     return out;
 }
@@ -792,23 +1006,23 @@ QString Track::codecProfile() const
 
 QString Track::tool() const
 {
-    return p->tool;
+    return deferredData(p).tool;
 }
 
 QString Track::tagType(const QString& sep) const
 {
-    return p->tagTypes.empty() ? QString{}
-                               : p->tagTypes.join(!sep.isEmpty() ? sep : QLatin1String{Constants::UnitSeparator});
+    const auto& tagTypes = deferredData(p).tagTypes;
+    return tagTypes.empty() ? QString{} : tagTypes.join(!sep.isEmpty() ? sep : QLatin1String{Constants::UnitSeparator});
 }
 
 QStringList Track::tagTypes() const
 {
-    return p->tagTypes;
+    return deferredData(p).tagTypes;
 }
 
 QString Track::encoding() const
 {
-    return p->encoding;
+    return deferredData(p).encoding;
 }
 
 int Track::playCount() const
@@ -841,11 +1055,6 @@ uint64_t Track::lastPlayed() const
     return p->lastPlayed;
 }
 
-QString Track::sort() const
-{
-    return p->sort;
-}
-
 bool Track::hasMatch(const QString& term) const
 {
     const auto contains = [&term](const QString& text) {
@@ -879,7 +1088,7 @@ void Track::setId(int id)
     p->id = id;
 }
 
-void Track::setHash(const QString& hash)
+void Track::setHash(uint64_t hash)
 {
     p->hash = hash;
 }
@@ -900,8 +1109,8 @@ void Track::setFilePath(const QString& path)
         p->isInArchive = false;
         const QFileInfo info{p->filepath};
         p->filename  = info.completeBaseName();
-        p->extension = info.suffix().toLower();
-        p->directory = info.dir().dirName();
+        p->extension = intern(info.suffix().toLower());
+        p->directory = intern(info.dir().dirName());
     }
 }
 
@@ -909,7 +1118,7 @@ void Track::setTitle(const QString& title)
 {
     p->title = title;
 
-    if(!p->hash.isEmpty()) {
+    if(p->hash != 0) {
         generateHash();
     }
 }
@@ -920,19 +1129,19 @@ void Track::setArtists(const QStringList& artists)
         p->artists.clear();
     }
     else {
-        p->artists = artists;
+        p->artists = intern(artists);
     }
 
-    if(!p->hash.isEmpty()) {
+    if(p->hash != 0) {
         generateHash();
     }
 }
 
 void Track::setAlbum(const QString& title)
 {
-    p->album = title;
+    p->album = intern(title);
 
-    if(!p->hash.isEmpty()) {
+    if(p->hash != 0) {
         generateHash();
     }
 }
@@ -943,7 +1152,7 @@ void Track::setAlbumArtists(const QStringList& artists)
         p->albumArtists.clear();
     }
     else {
-        p->albumArtists = artists;
+        p->albumArtists = intern(artists);
     }
 }
 
@@ -962,14 +1171,18 @@ void Track::setTrackNumber(const QString& number)
         p->trackNumber = number;
     }
 
-    if(!p->hash.isEmpty()) {
+    p->trackNumberValue = toNumber(p->trackNumber);
+    p->trackTotalValue  = toNumber(p->trackTotal);
+
+    if(p->hash != 0) {
         generateHash();
     }
 }
 
 void Track::setTrackTotal(const QString& total)
 {
-    p->trackTotal = total;
+    p->trackTotal      = total;
+    p->trackTotalValue = toNumber(total);
 }
 
 void Track::setDiscNumber(const QString& number)
@@ -987,14 +1200,18 @@ void Track::setDiscNumber(const QString& number)
         p->discNumber = number;
     }
 
-    if(!p->hash.isEmpty()) {
+    p->discNumberValue = toNumber(p->discNumber);
+    p->discTotalValue  = toNumber(p->discTotal);
+
+    if(p->hash != 0) {
         generateHash();
     }
 }
 
 void Track::setDiscTotal(const QString& total)
 {
-    p->discTotal = total;
+    p->discTotal      = total;
+    p->discTotalValue = toNumber(total);
 }
 
 void Track::setGenres(const QStringList& genres)
@@ -1003,93 +1220,59 @@ void Track::setGenres(const QStringList& genres)
         p->genres.clear();
     }
     else {
-        p->genres = genres;
+        p->genres = intern(genres);
     }
 }
 
 void Track::setComposers(const QStringList& composers)
 {
-    p->composers = composers;
+    p->composers = intern(composers);
 }
 
 void Track::setPerformers(const QStringList& performers)
 {
-    p->performers = performers;
+    p->performers = intern(performers);
 }
 
 void Track::setComment(const QString& comment)
 {
-    p->comment = comment;
+    deferredData(p);
+    p->deferred->comment = comment;
 }
 
 void Track::setDate(const QString& date)
 {
-    p->date = date;
+    p->date           = date;
+    p->year           = -1;
+    p->dateSinceEpoch = {};
+    p->yearSinceEpoch = {};
+
     if(date.isEmpty()) {
-        p->year = -1;
         return;
     }
 
     // TODO: Replace with std::chrono::parse once full compiler support is availble
 
-    static const QRegularExpression fullDateRegex{QLatin1String{FullDateRegex}};
-    static const QRegularExpression yearMonthRegex{QLatin1String{YearMonthRegex}};
-    static const QRegularExpression yearRegex{QLatin1String{YearRegex}};
-
-    auto processDate = [this](const std::chrono::year_month_day& ymd) {
-        const std::chrono::sys_days days{ymd};
-        auto timePoint    = std::chrono::time_point_cast<std::chrono::milliseconds>(days);
-        p->dateSinceEpoch = timePoint.time_since_epoch().count();
-
-        const std::chrono::sys_days startOfYear{ymd.year() / 1 / 1};
-        auto yearTimePoint = std::chrono::time_point_cast<std::chrono::milliseconds>(startOfYear);
-        p->yearSinceEpoch  = yearTimePoint.time_since_epoch().count();
-        p->year            = static_cast<int>(ymd.year());
-    };
-
-    // First try to match the full date
-    QRegularExpressionMatch match = fullDateRegex.match(date);
-    if(match.hasMatch()) {
-        bool yearOk{false};
-        bool monthOk{false};
-        bool dayOk{false};
-        const int year  = match.captured(1).toInt(&yearOk);
-        const int month = match.captured(2).toInt(&monthOk);
-        const int day   = match.captured(3).toInt(&dayOk);
-
-        if(yearOk && monthOk && dayOk) {
-            const std::chrono::year_month_day ymd{std::chrono::year{year} / month / day};
-            processDate(ymd);
-            return;
+    // Try the full date first, then the year and month, then just the year
+    for(const int parts : {3, 2, 1}) {
+        const auto values = findDate(date, parts);
+        if(!values) {
+            continue;
         }
-    }
 
-    // Then try to match the year and month
-    match = yearMonthRegex.match(date);
-    if(match.hasMatch()) {
-        bool yearOk{false};
-        bool monthOk{false};
-        const int year  = match.captured(1).toInt(&yearOk);
-        const int month = match.captured(2).toInt(&monthOk);
-
-        if(yearOk && monthOk) {
-            const std::chrono::year_month_day ymd{std::chrono::year{year} / month / 1};
-            processDate(ymd);
-            return;
+        const std::chrono::year_month_day ymd{std::chrono::year{values->at(0)} / values->at(1) / values->at(2)};
+        if(!ymd.ok()) {
+            continue;
         }
-    }
 
-    // Finally, try to match just the year
-    match = yearRegex.match(date);
-    if(match.hasMatch()) {
-        bool yearOk{false};
-        const int year = match.captured(0).toInt(&yearOk);
+        const std::chrono::sys_days days{ymd};
+        p->dateSinceEpoch = std::chrono::time_point_cast<std::chrono::milliseconds>(days).time_since_epoch().count();
 
-        if(yearOk) {
-            const std::chrono::year_month_day ymd{std::chrono::year{year} / 1 / 1};
-            processDate(ymd);
-            return;
-        }
+        const std::chrono::sys_days startOfYear{ymd.year() / 1 / 1};
+        p->yearSinceEpoch
+            = std::chrono::time_point_cast<std::chrono::milliseconds>(startOfYear).time_since_epoch().count();
+        p->year = static_cast<int>(ymd.year());
+        return;
     }
 }
 
@@ -1148,77 +1331,103 @@ void Track::clearRGInfo()
 
 QString Track::metaValue(const QString& name) const
 {
-    const QString tag = name.toUpper();
-
-    const auto map = metaMap();
-    if(map.contains(tag)) {
-        return map.at(tag)(*this);
-    }
-
-    return extraTag(tag).join(QLatin1String{Constants::UnitSeparator});
+    switch(metaField(name)) {
+        case(MetaField::Title):
+            return title();
+        case(MetaField::Artist):
+            return artist();
+        case(MetaField::Album):
+            return album();
+        case(MetaField::AlbumArtist):
+            return albumArtist();
+        case(MetaField::Track):
+            return trackNumber();
+        case(MetaField::TrackTotal):
+            return trackTotal();
+        case(MetaField::Disc):
+            return discNumber();
+        case(MetaField::DiscTotal):
+            return discTotal();
+        case(MetaField::Genre):
+            return genre();
+        case(MetaField::Composer):
+            return composer();
+        case(MetaField::Performer):
+            return performer();
+        case(MetaField::Comment):
+            return comment();
+        case(MetaField::Date):
+            return date();
+        case(MetaField::Year):
+            return validNum(year());
+        case(MetaField::Rating):
+        case(MetaField::RatingEditor):
+            return validNum(rating());
+        case(MetaField::RatingStars):
+            return validNum(ratingStars());
+        default:
+            break;
+    }
+
+    return extraTag(name.toUpper()).join(QLatin1String{Constants::UnitSeparator});
 }
 
 QString Track::techInfo(const QString& name) const
 {
-    auto validNum = [](auto num) -> QString {
-        if(num > 0) {
-            return QString::number(num);
-        }
-        return {};
-    };
-
-    const QString prop = name.toUpper();
-
-    using namespace Constants::MetaData;
-
-    // clang-format off
-    static const std::unordered_map<QString, std::function<QString(const Track& track)>> infoMap{
-        {QString::fromLatin1(Codec),        [](const Track& track) { return track.codec(); }},
-        {QString::fromLatin1(CodecProfile), [](const Track& track) { return track.codecProfile(); }},
-        {QString::fromLatin1(Tool),         [](const Track& track) { return track.tool(); }},
-        {QString::fromLatin1(Encoding),     [](const Track& track) { return track.tagType(u","_s); }},
-        {QString::fromLatin1(TagType),      [](const Track& track) { return track.encoding(); }},
-        {QString::fromLatin1(SampleRate),   [validNum](const Track& track) { return validNum(track.sampleRate()); }},
-        {QString::fromLatin1(Bitrate),      [validNum](const Track& track) { return validNum(track.bitrate()); }},
-        {QString::fromLatin1(Channels),     [validNum](const Track& track) { return validNum(track.channels()); }},
-        {QString::fromLatin1(BitDepth),     [validNum](const Track& track) { return validNum(track.bitDepth()); }},
-        {QString::fromLatin1(Duration),     [validNum](const Track& track) { return validNum(track.duration()); }},
-        {QString::fromLatin1(RGTrackGain),  [](const Track& track) { return track.hasTrackGain() ? QString::number(track.rgTrackGain()) : QString{}; }},
-        {QString::fromLatin1(RGTrackPeak),  [](const Track& track) { return track.hasTrackPeak() ? QString::number(track.rgTrackPeak()) : QString{}; }},
-        {QString::fromLatin1(RGAlbumGain),  [](const Track& track) { return track.hasAlbumGain() ? QString::number(track.rgAlbumGain()) : QString{}; }},
-        {QString::fromLatin1(RGAlbumPeak),  [](const Track& track) { return track.hasAlbumPeak() ? QString::number(track.rgAlbumPeak()) : QString{}; }}
-    };
-    // clang-format on
-
-    if(infoMap.contains(prop)) {
-        return infoMap.at(prop)(*this);
-    }
-
-    return extraTag(prop).join(QLatin1String{Constants::UnitSeparator});
+    switch(metaField(name)) {
+        case(MetaField::Codec):
+            return codec();
+        case(MetaField::CodecProfile):
+            return codecProfile();
+        case(MetaField::Tool):
+            return tool();
+        case(MetaField::Encoding):
+            return tagType(u","_s);
+        case(MetaField::TagType):
+            return encoding();
+        case(MetaField::SampleRate):
+            return validNum(sampleRate());
+        case(MetaField::Bitrate):
+            return validNum(bitrate());
+        case(MetaField::Channels):
+            return validNum(channels());
+        case(MetaField::BitDepth):
+            return validNum(bitDepth());
+        case(MetaField::Duration):
+            return validNum(duration());
+        case(MetaField::RGTrackGain):
+            return hasTrackGain() ? QString::number(rgTrackGain()) : QString{};
+        case(MetaField::RGTrackPeak):
+            return hasTrackPeak() ? QString::number(rgTrackPeak()) : QString{};
+        case(MetaField::RGAlbumGain):
+            return hasAlbumGain() ? QString::number(rgAlbumGain()) : QString{};
+        case(MetaField::RGAlbumPeak):
+            return hasAlbumPeak() ? QString::number(rgAlbumPeak()) : QString{};
+        default:
+            break;
+    }
+
+    return extraTag(name.toUpper()).join(QLatin1String{Constants::UnitSeparator});
 }
 
 std::optional<int64_t> Track::dateValue(const QString& name) const
 {
-    const QString prop = name.toUpper();
-
-    using namespace Constants::MetaData;
-
-    // clang-format off
-    static const std::unordered_map<QString, std::function<std::optional<int64_t>(const Track& track)>> dateMap{
-        {QString::fromLatin1(Date),         [](const Fooyin::Track& track) { return track.p->dateSinceEpoch; }},
-        {QString::fromLatin1(Year),         [](const Fooyin::Track& track) { return track.p->yearSinceEpoch; }},
-        {QString::fromLatin1(FirstPlayed),  [](const Fooyin::Track& track) { return track.firstPlayed(); }},
-        {QString::fromLatin1(LastPlayed),   [](const Fooyin::Track& track) { return track.lastPlayed(); }},
-        {QString::fromLatin1(AddedTime),    [](const Fooyin::Track& track) { return track.addedTime(); }},
-        {QString::fromLatin1(LastModified), [](const Fooyin::Track& track) { return track.lastModified(); }}
-    };
-    // clang-format on
-
-    if(dateMap.contains(prop)) {
-        return dateMap.at(prop)(*this);
+    switch(metaField(name)) {
+        case(MetaField::Date):
+            return p->dateSinceEpoch;
+        case(MetaField::Year):
+            return p->yearSinceEpoch;
+        case(MetaField::FirstPlayed):
+            return firstPlayed();
+        case(MetaField::LastPlayed):
+            return lastPlayed();
+        case(MetaField::AddedTime):
+            return addedTime();
+        case(MetaField::LastModified):
+            return lastModified();
+        default:
+            return {};
     }
-
-    return {};
 }
 
 void Track::setCuePath(const QString& path)
@@ -1294,17 +1503,20 @@ void Track::storeExtraTags(const QByteArray& tags)
 
 void Track::setExtraProperty(const QString& prop, const QString& value)
 {
-    p->extraProps[prop] = value;
+    deferredData(p);
+    p->deferred->extraProps[prop] = value;
 }
 
 void Track::removeExtraProperty(const QString& prop)
 {
-    p->extraProps.remove(prop);
+    deferredData(p);
+    p->deferred->extraProps.remove(prop);
 }
 
 void Track::clearExtraProperties()
 {
-    p->extraProps.clear();
+    deferredData(p);
+    p->deferred->extraProps.clear();
 }
 
 void Track::storeExtraProperties(const QByteArray& props)
@@ -1317,7 +1529,8 @@ void Track::storeExtraProperties(const QByteArray& props)
     QDataStream stream(&in, QIODevice::ReadOnly);
     stream.setVersion(QDataStream::Qt_6_0);
 
-    stream >> p->extraProps;
+    deferredData(p);
+    stream >> p->deferred->extraProps;
 }
 
 void Track::setSubsong(int index)
@@ -1366,27 +1579,30 @@ void Track::setBitDepth(int depth)
 
 void Track::setCodec(const QString& codec)
 {
-    p->codec = codec;
+    p->codec = intern(codec);
 }
 
 void Track::setCodecProfile(const QString& profile)
 {
-    p->codecProfile = profile;
+    p->codecProfile = intern(profile);
 }
 
 void Track::setTool(const QString& tool)
 {
-    p->tool = tool;
+    deferredData(p);
+    p->deferred->tool = intern(tool);
 }
 
 void Track::setTagTypes(const QStringList& tagTypes)
 {
-    p->tagTypes = tagTypes;
+    deferredData(p);
+    p->deferred->tagTypes = intern(tagTypes);
 }
 
 void Track::setEncoding(const QString& encoding)
 {
-    p->encoding = encoding;
+    deferredData(p);
+    p->deferred->encoding = intern(encoding);
 }
 
 void Track::setPlayCount(int count)
@@ -1421,15 +1637,41 @@ void Track::setLastPlayed(uint64_t time)
     }
 }
 
-void Track::setSort(const QString& sort)
+void Track::clearWasModified()
 {
-    p->sort       = sort;
-    p->isNewTrack = false;
+    p->metadataWasModified = false;
 }
 
-void Track::clearWasModified()
+bool Track::hasDeferredFields() const
 {
-    p->metadataWasModified = false;
+    return p->deferred->pending.load(std::memory_order_acquire);
+}
+
+void Track::setFieldsDeferred()
+{
+    p->deferred->pending.store(true, std::memory_order_release);
+}
+
+void Track::setDeferredLoader(DeferredLoader loader)
+{
+    const std::scoped_lock lock{loaderMutex()};
+    deferredLoader() = std::move(loader);
+}
+
+void Track::loadDeferredFields(const TrackList& tracks)
+{
+    TrackIds ids;
+    std::vector<TrackDeferredData*> pending;
+
+    for(const Track& track : tracks) {
+        const TrackDeferredData* data = track.p->deferred.constData();
+        if(data->pending.load(std::memory_order_acquire)) {
+            ids.emplace_back(track.p->id);
+            pending.emplace_back(const_cast<TrackDeferredData*>(data));
+        }
+    }
+
+    loadDeferred(ids, pending);
 }
 
 QString Track::findCommonField(const TrackList& tracks)
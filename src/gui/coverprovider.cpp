@@ -64,7 +64,8 @@ QString generateAlbumCoverKey(const Fooyin::Track& track, Fooyin::Track::Cover t
 
 QString generateTrackCoverKey(const Fooyin::Track& track, Fooyin::Track::Cover type)
 {
-    return Fooyin::Utils::generateHash(u"FyCover"_s + QString::number(static_cast<int>(type)), track.hash());
+    return Fooyin::Utils::generateHash(u"FyCover"_s + QString::number(static_cast<int>(type)),
+                                       QString::number(track.hash()));
 }
 
 QString generateThumbCoverKey(const QString& key, int size)
@@ -22,6 +22,8 @@
 #include <core/constants.h>
 #include <core/library/tracksort.h>
 
+#include <functional>
+
 namespace {
 QStyleOptionViewItem::Position getCoverPosition(const QString& text, const char* cover)
 {
@@ -143,8 +145,8 @@ void LibraryTreeItem::replaceTrack(const Track& track)
     std::ranges::replace_if(m_tracks, [track](const Track& child) { return child.id() == track.id(); }, track);
 }
 
-void LibraryTreeItem::sortTracks()
+void LibraryTreeItem::sortTracks(TrackSorter& sorter, const QString& sort)
 {
-    m_tracks = TrackSorter::sortTracks(m_tracks);
+    m_tracks = TrackSorter::applyPermutation(m_tracks, sorter.sortPermutation(sort, m_tracks, std::identity{}));
 }
 } // namespace Fooyin
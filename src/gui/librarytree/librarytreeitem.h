@@ -29,6 +29,8 @@
 #include <QStyleOptionViewItem>
 
 namespace Fooyin {
+class TrackSorter;
+
 class LibraryTreeItem : public TreeItem<LibraryTreeItem>
 {
 public:
@@ -62,7 +64,7 @@ public:
     void addTracks(const TrackList& tracks);
     void removeTrack(const Track& track);
     void replaceTrack(const Track& track);
-    void sortTracks();
+    void sortTracks(TrackSorter& sorter, const QString& sort);
 
 private:
     bool m_pending;
@@ -24,6 +24,7 @@
 
 #include <core/constants.h>
 #include <core/coresettings.h>
+#include <core/library/tracksort.h>
 #include <gui/coverprovider.h>
 #include <gui/guiconstants.h>
 #include <utils/datastream.h>
@@ -149,6 +150,7 @@ public:
 
     QThread m_populatorThread;
     LibraryTreePopulator m_populator;
+    TrackSorter m_sorter;
 
     LibraryTreeItem m_summaryNode;
     NodeKeyMap m_pendingNodes;
@@ -174,6 +176,7 @@ LibraryTreeModelPrivate::LibraryTreeModelPrivate(LibraryTreeModel* self, Library
     , m_settings{settings}
     , m_coverProvider{m_audioLoader, m_settings}
     , m_populator{libraryManager}
+    , m_sorter{libraryManager}
     , m_iconSize{
           CoverProvider::findThumbnailSize(m_settings->value<Settings::Gui::Internal::LibTreeIconSize>().toSize())}
 {
@@ -359,7 +362,7 @@ void LibraryTreeModelPrivate::populateModel(PendingTreeData& data)
         if(m_nodes.contains(key)) {
             auto& node = m_nodes.at(key);
             node.addTracks(item.tracks());
-            node.sortTracks();
+            node.sortTracks(m_sorter, m_settings->value<Settings::Core::LibrarySortScript>());
         }
         else {
             m_nodes[key] = item;
@@ -280,8 +280,8 @@ PlaylistItem* PlaylistPopulatorPrivate::iterateTrack(const PlaylistTrack& track,
     playlistTrack.setDepth(m_trackDepth);
     playlistTrack.calculateSize();
 
-    const auto baseKey
-        = Utils::generateMd5Hash(parent->key().toString(UId::Id128), track.track.hash(), QString::number(index));
+    const auto baseKey = Utils::generateMd5Hash(parent->key().toString(UId::Id128),
+                                                QString::number(track.track.hash()), QString::number(index));
     const UId key{UId::create()};
 
     auto* trackItem = getOrInsertItem(key, PlaylistItem::Track, playlistTrack, parent, baseKey);
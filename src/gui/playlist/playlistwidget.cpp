@@ -1463,15 +1463,16 @@ void PlaylistWidgetPrivate::sortTracks(const QString& script)
         std::ranges::sort(indexesToSort);
 
         Utils::asyncExec([this, currentTracks, script, indexesToSort]() {
-            auto tracks = m_sorter.calcSortTracks(script, currentTracks, indexesToSort, PlaylistTrack::extractor,
-                                                  PlaylistTrack::extractorConst);
+            const auto permutation
+                = m_sorter.sortPermutation(script, currentTracks, indexesToSort, PlaylistTrack::extractorConst);
+            auto tracks = TrackSorter::applyPermutation(currentTracks, permutation);
             return PlaylistTrack::updateIndexes(tracks);
         }).then(m_self, handleSortedTracks);
     }
     else {
         Utils::asyncExec([this, currentTracks, script]() {
-            auto tracks = m_sorter.calcSortTracks(script, currentTracks, PlaylistTrack::extractor,
-                                                  PlaylistTrack::extractorConst);
+            const auto permutation = m_sorter.sortPermutation(script, currentTracks, PlaylistTrack::extractorConst);
+            auto tracks            = TrackSorter::applyPermutation(currentTracks, permutation);
             return PlaylistTrack::updateIndexes(tracks);
         }).then(m_self, handleSortedTracks);
     }
@@ -1492,8 +1493,9 @@ void PlaylistWidgetPrivate::sortColumn(int column, Qt::SortOrder order)
     const QString sortField = m_columns.at(column).field;
 
     Utils::asyncExec([this, sortField, currentTracks, order]() {
-        auto tracks = m_sorter.calcSortTracks(sortField, currentTracks, PlaylistTrack::extractor,
-                                              PlaylistTrack::extractorConst, order);
+        const auto permutation
+            = m_sorter.sortPermutation(sortField, currentTracks, PlaylistTrack::extractorConst, order);
+        auto tracks = TrackSorter::applyPermutation(currentTracks, permutation);
         return PlaylistTrack::updateIndexes(tracks);
     }).then(m_self, [this, currentPlaylist, currentTracks](const PlaylistTrackList& sortedTracks) {
         auto* sortCmd
@@ -333,6 +333,7 @@ void InfoPopulator::run(InfoItem::Options options, const TrackList& tracks)
 
     p->reset();
 
+    Track::loadDeferredFields(tracks);
     p->addTrackNodes(options, tracks);
 
     if(mayRun()) {
@@ -40,6 +40,8 @@
 #include <QLabel>
 #include <QMenu>
 #include <QPushButton>
+#include <QSpinBox>
+#include <QThread>
 
 using namespace Qt::StringLiterals;
 
@@ -105,6 +107,8 @@ private:
 
     QLineEdit* m_restrictTypes;
     QLineEdit* m_excludeTypes;
+    QSpinBox* m_scanThreads;
+    QCheckBox* m_deferProperties;
 
     QCheckBox* m_autoRefresh;
     QCheckBox* m_monitorLibraries;
@@ -124,6 +128,8 @@ LibraryGeneralPageWidget::LibraryGeneralPageWidget(ActionManager* actionManager,
     , m_model{new LibraryModel(m_libraryManager, this)}
     , m_restrictTypes{new QLineEdit(this)}
     , m_excludeTypes{new QLineEdit(this)}
+    , m_scanThreads{new QSpinBox(this)}
+    , m_deferProperties{new QCheckBox(tr("Read audio properties after scanning"), this)}
     , m_autoRefresh{new QCheckBox(tr("Auto refresh on startup"), this)}
     , m_monitorLibraries{new QCheckBox(tr("Monitor libraries"), this)}
     , m_markUnavailable{new QCheckBox(tr("Mark unavailable tracks on playback"), this)}
@@ -144,6 +150,11 @@ LibraryGeneralPageWidget::LibraryGeneralPageWidget(ActionManager* actionManager,
     m_autoRefresh->setToolTip(tr("Scan libraries for changes on startup"));
     m_monitorLibraries->setToolTip(tr("Monitor libraries for external changes"));
 
+    m_scanThreads->setRange(1, 64);
+    m_scanThreads->setToolTip(tr("Number of threads used to read file metadata when scanning libraries"));
+    m_deferProperties->setToolTip(tr("Only read tags of new files when scanning, and read duration, bitrate and "
+                                     "other audio properties in the background afterwards"));
+
     auto* fileTypesGroup  = new QGroupBox(tr("File Types"), this);
     auto* fileTypesLayout = new QGridLayout(fileTypesGroup);
 
@@ -160,6 +171,9 @@ LibraryGeneralPageWidget::LibraryGeneralPageWidget(ActionManager* actionManager,
     row = 0;
     mainLayout->addWidget(m_libraryView, row++, 0, 1, 2);
     mainLayout->addWidget(fileTypesGroup, row++, 0, 1, 2);
+    mainLayout->addWidget(new QLabel(tr("Scan threads") + ":"_L1, this), row, 0);
+    mainLayout->addWidget(m_scanThreads, row++, 1, Qt::AlignLeft);
+    mainLayout->addWidget(m_deferProperties, row++, 0, 1, 2);
     mainLayout->addWidget(m_autoRefresh, row++, 0, 1, 2);
     mainLayout->addWidget(m_monitorLibraries, row++, 0, 1, 2);
     mainLayout->addWidget(m_markUnavailable, row++, 0, 1, 2);
@@ -185,6 +199,10 @@ void LibraryGeneralPageWidget::load()
 
     m_restrictTypes->setText(restrictExtensions.join(u';'));
     m_excludeTypes->setText(excludeExtensions.join(u';'));
+    m_scanThreads->setValue(
+        m_settings->fileValue(Settings::Core::Internal::LibraryScanThreads, QThread::idealThreadCount()).toInt());
+    m_deferProperties->setChecked(
+        m_settings->fileValue(Settings::Core::Internal::LibraryDeferProperties, false).toBool());
 
     m_autoRefresh->setChecked(m_settings->value<Settings::Core::AutoRefresh>());
     m_monitorLibraries->setChecked(m_settings->value<Settings::Core::Internal::MonitorLibraries>());
@@ -204,6 +222,8 @@ void LibraryGeneralPageWidget::apply()
                         m_restrictTypes->text().split(u';', Qt::SkipEmptyParts));
     m_settings->fileSet(Settings::Core::Internal::LibraryExcludeTypes,
                         m_excludeTypes->text().split(u';', Qt::SkipEmptyParts));
+    m_settings->fileSet(Settings::Core::Internal::LibraryScanThreads, m_scanThreads->value());
+    m_settings->fileSet(Settings::Core::Internal::LibraryDeferProperties, m_deferProperties->isChecked());
 
     m_settings->set<Settings::Core::AutoRefresh>(m_autoRefresh->isChecked());
     m_settings->set<Settings::Core::Internal::MonitorLibraries>(m_monitorLibraries->isChecked());
@@ -218,6 +238,8 @@ void LibraryGeneralPageWidget::reset()
 {
     m_settings->fileRemove(Settings::Core::Internal::LibraryRestrictTypes);
     m_settings->fileRemove(Settings::Core::Internal::LibraryExcludeTypes);
+    m_settings->fileRemove(Settings::Core::Internal::LibraryScanThreads);
+    m_settings->fileRemove(Settings::Core::Internal::LibraryDeferProperties);
 
     m_settings->reset<Settings::Core::AutoRefresh>();
     m_settings->reset<Settings::Core::Internal::MonitorLibraries>();
@@ -22,6 +22,8 @@
 #include <core/library/tracksort.h>
 #include <core/track.h>
 
+#include <functional>
+
 using namespace Qt::StringLiterals;
 
 namespace Fooyin::Filters {
@@ -112,8 +114,8 @@ void FilterItem::replaceTrack(const Track& track)
     std::ranges::replace_if(m_tracks, [track](const Track& child) { return child.id() == track.id(); }, track);
 }
 
-void FilterItem::sortTracks()
+void FilterItem::sortTracks(TrackSorter& sorter, const QString& sort)
 {
-    m_tracks = TrackSorter::sortTracks(m_tracks);
+    m_tracks = TrackSorter::applyPermutation(m_tracks, sorter.sortPermutation(sort, m_tracks, std::identity{}));
 }
 } // namespace Fooyin::Filters
@@ -26,7 +26,10 @@
 
 #include <QStringList>
 
-namespace Fooyin::Filters {
+namespace Fooyin {
+class TrackSorter;
+
+namespace Filters {
 class FilterItem;
 
 class FilterItem : public TreeItem<FilterItem>
@@ -60,7 +63,7 @@ public:
     void addTracks(const TrackList& tracks);
     void removeTrack(const Track& track);
     void replaceTrack(const Track& track);
-    void sortTracks();
+    void sortTracks(TrackSorter& sorter, const QString& sort);
 
 private:
     Md5Hash m_key;
@@ -68,4 +71,5 @@ private:
     TrackList m_tracks;
     bool m_isSummary;
 };
-} // namespace Fooyin::Filters
+} // namespace Filters
+} // namespace Fooyin
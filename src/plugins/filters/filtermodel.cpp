@@ -25,6 +25,7 @@
 #include "settings/filtersettings.h"
 
 #include <core/coresettings.h>
+#include <core/library/tracksort.h>
 #include <core/track.h>
 #include <gui/coverprovider.h>
 #include <gui/guiconstants.h>
@@ -125,6 +126,7 @@ public:
     bool m_resetting{false};
     QThread m_populatorThread;
     FilterPopulator m_populator;
+    TrackSorter m_sorter;
     CoverProvider* m_coverProvider;
 
     FilterItem m_summaryNode;
@@ -152,6 +154,7 @@ FilterModelPrivate::FilterModelPrivate(FilterModel* self, LibraryManager* librar
     : m_self{self}
     , m_settings{settings}
     , m_populator{libraryManager}
+    , m_sorter{libraryManager}
     , m_coverProvider{coverProvider}
     , m_decorationSize{
           CoverProvider::findThumbnailSize(m_settings->value<Settings::Filters::FilterIconSize>().toSize())}
@@ -258,7 +261,7 @@ void FilterModelPrivate::populateModel(PendingTreeData& data)
         if(m_nodes.contains(key)) {
             auto& node = m_nodes.at(key);
             node.addTracks(item.tracks());
-            node.sortTracks();
+            node.sortTracks(m_sorter, m_settings->value<Settings::Core::LibrarySortScript>());
         }
         else {
             newItems.push_back(item);
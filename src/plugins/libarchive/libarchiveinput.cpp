@@ -25,6 +25,8 @@
 #include <QLoggingCategory>
 #include <QMimeDatabase>
 
+#include <cstring>
+
 #ifdef Q_OS_WIN
 #define NOMINMAX
 #endif
@@ -34,6 +36,10 @@ Q_LOGGING_CATEGORY(LIBARCH, "fy.libarchive")
 
 using namespace Qt::StringLiterals;
 
+// Reads from the archive are at least this size, to avoid many small reads when parsing tags
+constexpr qint64 MinReadSize = 16 * 1024;
+constexpr qint64 MaxSkipSize = 64 * 1024;
+
 namespace {
 QStringList fileExtensions()
 {
@@ -62,16 +68,37 @@ bool setupForReading(archive* archive, const QString& filename)
 
     return true;
 }
+
+// Opens @p filename with the header of the entry at @p index read
+Fooyin::LibArchive::ArchivePtr openAtEntry(const QString& filename, int index)
+{
+    Fooyin::LibArchive::ArchivePtr archive{archive_read_new()};
+
+    if(!setupForReading(archive.get(), filename)) {
+        return nullptr;
+    }
+
+    archive_entry* entry{nullptr};
+    for(int i{0}; i <= index; ++i) {
+        if(archive_read_next_header(archive.get(), &entry) != ARCHIVE_OK) {
+            return nullptr;
+        }
+    }
+
+    return archive;
+}
 } // namespace
 
 namespace Fooyin::LibArchive {
-LibArchiveIODevice::LibArchiveIODevice(ArchivePtr archive, archive_entry* entry, QObject* parent)
+LibArchiveIODevice::LibArchiveIODevice(ArchivePtr archive, archive_entry* entry, ReopenArchive reopen,
+                                       QObject* parent)
     : QIODevice{parent}
     , m_archive{std::move(archive)}
-    , m_entry{entry}
+    , m_reopen{std::move(reopen)}
+    , m_size{archive_entry_size_is_set(entry) ? archive_entry_size(entry) : -1}
+    , m_archivePos{0}
 {
     open(QIODevice::ReadOnly);
-    m_buffer.open(QBuffer::ReadWrite);
 }
 
 LibArchiveIODevice::~LibArchiveIODevice()
@@ -79,78 +106,164 @@ LibArchiveIODevice::~LibArchiveIODevice()
     m_archive.reset();
 }
 
-bool LibArchiveIODevice::seek(qint64 pos)
+bool LibArchiveIODevice::open(OpenMode mode)
 {
-    if(!isOpen()) {
-        return false;
-    }
+    // Data is already cached in m_chunks
+    return QIODevice::open(mode | QIODevice::Unbuffered);
+}
 
-    QIODevice::seek(pos);
+qint64 LibArchiveIODevice::size() const
+{
+    return std::max<qint64>(m_size, 0);
+}
 
-    if(pos <= m_buffer.size()) {
-        return m_buffer.seek(pos);
-    }
+archive* LibArchiveIODevice::releaseArchive()
+{
+    return m_archive.release();
+}
 
-    qint64 bufferLen = pos - m_buffer.size();
-    std::vector<char> tmpBuffer(1024);
+qint64 LibArchiveIODevice::readData(char* data, qint64 maxlen)
+{
+    if(!isOpen() || !m_archive) {
+        return -1;
+    }
 
-    while(bufferLen > 0) {
-        qint64 lenToRead = std::min(static_cast<qint64>(tmpBuffer.size()), bufferLen);
+    qint64 pos = this->pos();
+    qint64 total{0};
 
-        lenToRead = archive_read_data(m_archive.get(), tmpBuffer.data(), static_cast<size_t>(lenToRead));
-        if(lenToRead > 0) {
-            m_buffer.buffer().append(tmpBuffer.data(), static_cast<qsizetype>(lenToRead));
-            bufferLen -= lenToRead;
+    while(total < maxlen && (m_size < 0 || pos < m_size)) {
+        const qint64 cached = readCached(pos, data + total, maxlen - total);
+        if(cached > 0) {
+            total += cached;
+            pos += cached;
             continue;
         }
-        if(lenToRead < 0) {
-            qCWarning(LIBARCH) << "Seeking failed:" << archive_error_string(m_archive.get());
-            setErrorString(QString::fromLocal8Bit(archive_error_string(m_archive.get())));
-            close();
+
+        if(pos < m_archivePos && !rewind()) {
+            break;
+        }
+        if(pos > m_archivePos && !skipTo(pos)) {
+            break;
+        }
+
+        const qint64 read = readArchive(maxlen - total);
+        if(read < 0) {
+            return total > 0 ? total : -1;
+        }
+        if(read == 0) {
+            break;
         }
-        return false;
     }
 
-    return m_buffer.seek(pos);
+    return total;
 }
 
-qint64 LibArchiveIODevice::size() const
+qint64 LibArchiveIODevice::writeData(const char* /*data*/, qint64 /*len*/)
 {
-    return archive_entry_size(m_entry);
+    return -1;
 }
 
-archive* LibArchiveIODevice::releaseArchive()
+qint64 LibArchiveIODevice::readCached(qint64 pos, char* data, qint64 maxlen) const
 {
-    return m_archive.release();
+    auto chunkIt = m_chunks.upper_bound(pos);
+    if(chunkIt == m_chunks.cbegin()) {
+        return 0;
+    }
+    --chunkIt;
+
+    const qint64 offset = pos - chunkIt->first;
+    const qint64 len    = std::min(maxlen, chunkIt->second.size() - offset);
+    if(len <= 0) {
+        return 0;
+    }
+
+    std::memcpy(data, chunkIt->second.constData() + offset, static_cast<size_t>(len));
+    return len;
 }
 
-qint64 LibArchiveIODevice::readData(char* data, qint64 maxlen)
+qint64 LibArchiveIODevice::readArchive(qint64 maxlen)
 {
-    if(!isOpen()) {
+    qint64 len = std::max(maxlen, MinReadSize);
+
+    const auto nextIt = m_chunks.upper_bound(m_archivePos);
+    if(nextIt != m_chunks.cend()) {
+        len = std::min(len, nextIt->first - m_archivePos);
+    }
+    if(m_size >= 0) {
+        len = std::min(len, m_size - m_archivePos);
+    }
+    if(len <= 0) {
+        return 0;
+    }
+
+    // Extend the chunk ending here if there is one
+    auto chunkIt = nextIt;
+    if(chunkIt != m_chunks.cbegin()) {
+        --chunkIt;
+    }
+    if(chunkIt == m_chunks.cend() || chunkIt->first + chunkIt->second.size() != m_archivePos) {
+        chunkIt = m_chunks.emplace_hint(nextIt, m_archivePos, QByteArray{});
+    }
+
+    QByteArray& chunk         = chunkIt->second;
+    const qsizetype chunkSize = chunk.size();
+    chunk.resize(chunkSize + len);
+
+    const auto read = archive_read_data(m_archive.get(), chunk.data() + chunkSize, static_cast<size_t>(len));
+    chunk.resize(chunkSize + std::max<qint64>(read, 0));
+    if(chunk.isEmpty()) {
+        m_chunks.erase(chunkIt);
+    }
+
+    if(read < 0) {
+        setArchiveError("Reading failed:");
         return -1;
     }
 
-    if(m_buffer.pos() + maxlen > m_buffer.size()) {
-        const qint64 lenToRead = m_buffer.pos() + maxlen - m_buffer.size();
-        std::vector<char> tmpBuffer(lenToRead);
+    m_archivePos += read;
+    return read;
+}
+
+bool LibArchiveIODevice::skipTo(qint64 pos)
+{
+    std::vector<char> discard(static_cast<size_t>(std::min(pos - m_archivePos, MaxSkipSize)));
 
-        const auto read = archive_read_data(m_archive.get(), tmpBuffer.data(), lenToRead);
-        if(read > 0) {
-            m_buffer.buffer().append(tmpBuffer.data(), read);
+    while(m_archivePos < pos) {
+        const qint64 len = std::min(pos - m_archivePos, static_cast<qint64>(discard.size()));
+        const auto read  = archive_read_data(m_archive.get(), discard.data(), static_cast<size_t>(len));
+        if(read < 0) {
+            setArchiveError("Seeking failed:");
+            return false;
         }
-        else if(read < 0) {
-            qCWarning(LIBARCH) << "Reading failed:" << archive_error_string(m_archive.get());
-            setErrorString(QString::fromLocal8Bit(archive_error_string(m_archive.get())));
-            return -1;
+        if(read == 0) {
+            return false;
         }
+        m_archivePos += read;
     }
 
-    return m_buffer.read(data, maxlen);
+    return true;
 }
 
-qint64 LibArchiveIODevice::writeData(const char* /*data*/, qint64 /*len*/)
+bool LibArchiveIODevice::rewind()
 {
-    return -1;
+    if(!m_reopen) {
+        return false;
+    }
+
+    ArchivePtr archive = m_reopen();
+    if(!archive) {
+        return false;
+    }
+
+    m_archive    = std::move(archive);
+    m_archivePos = 0;
+    return true;
+}
+
+void LibArchiveIODevice::setArchiveError(const char* message)
+{
+    qCWarning(LIBARCH) << message << archive_error_string(m_archive.get());
+    setErrorString(QString::fromLocal8Bit(archive_error_string(m_archive.get())));
 }
 
 QStringList LibArchiveReader::extensions() const
@@ -167,11 +280,21 @@ bool LibArchiveReader::init(const QString& file)
 {
     m_file = file;
     m_type = QFileInfo{file}.suffix();
+
+    m_hasZipIndex = m_type.compare("zip"_L1, Qt::CaseInsensitive) == 0 && m_zipIndex.read(file);
+    if(!m_hasZipIndex) {
+        m_zipIndex.clear();
+    }
+
     return true;
 }
 
 std::unique_ptr<QIODevice> LibArchiveReader::entry(const QString& file)
 {
+    if(auto device = storedEntry(file)) {
+        return device;
+    }
+
     ArchivePtr archive{archive_read_new()};
 
     if(!setupForReading(archive.get(), m_file)) {
@@ -180,7 +303,7 @@ std::unique_ptr<QIODevice> LibArchiveReader::entry(const QString& file)
 
     archive_entry* entry{nullptr};
 
-    while(archive_read_next_header(archive.get(), &entry) == ARCHIVE_OK) {
+    for(int index{0}; archive_read_next_header(archive.get(), &entry) == ARCHIVE_OK; ++index) {
         if(archive_read_has_encrypted_entries(archive.get()) == 1) {
             qCInfo(LIBARCH) << "Unable to read encrypted file" << m_file;
             return nullptr;
@@ -189,7 +312,10 @@ std::unique_ptr<QIODevice> LibArchiveReader::entry(const QString& file)
         if(archive_entry_filetype(entry) == AE_IFREG) {
             const QString entryPath = QDir::fromNativeSeparators(QFile::decodeName(archive_entry_pathname(entry)));
             if(entryPath == file) {
-                return std::make_unique<LibArchiveIODevice>(std::move(archive), entry, nullptr);
+                auto reopen = [archiveFile = m_file, index]() {
+                    return openAtEntry(archiveFile, index);
+                };
+                return std::make_unique<LibArchiveIODevice>(std::move(archive), entry, reopen);
             }
         }
     }
@@ -208,18 +334,31 @@ bool LibArchiveReader::readTracks(ReadEntryCallback readEntry)
 
     archive_entry* entry{nullptr};
 
-    while(archive_read_next_header(archive.get(), &entry) == ARCHIVE_OK) {
+    for(int index{0}; archive_read_next_header(archive.get(), &entry) == ARCHIVE_OK; ++index) {
         if(archive_read_has_encrypted_entries(archive.get()) == 1) {
             qCInfo(LIBARCH) << "Unable to read encrypted file" << m_file;
             return false;
         }
 
-        if(archive_entry_filetype(entry) == AE_IFREG) {
-            const QString entryPath = QDir::fromNativeSeparators(QFile::decodeName(archive_entry_pathname(entry)));
-            auto entryDev           = std::make_unique<LibArchiveIODevice>(std::move(archive), entry, nullptr);
+        if(archive_entry_filetype(entry) != AE_IFREG) {
+            continue;
+        }
+
+        const QString entryPath = QDir::fromNativeSeparators(QFile::decodeName(archive_entry_pathname(entry)));
 
-            readEntry(entryPath, entryDev.get());
-            archive.reset(entryDev->releaseArchive());
+        // Stored entries are read straight from the file, and libarchive seeks past their data
+        if(auto storedDev = storedEntry(entryPath)) {
+            readEntry(entryPath, storedDev.get());
+            continue;
+        }
+
+        auto entryDev = std::make_unique<LibArchiveIODevice>(
+            std::move(archive), entry, [this, index]() { return openAtEntry(m_file, index); });
+
+        readEntry(entryPath, entryDev.get());
+        archive.reset(entryDev->releaseArchive());
+        if(!archive) {
+            return false;
         }
     }
 
@@ -255,12 +394,15 @@ QByteArray LibArchiveReader::readCover(const Track& track, Track::Cover cover)
             if(isImageFile(entryPath)) {
                 const QFileInfo info{entryPath};
                 if(info.path() == track.relativeArchivePath()) {
-                    auto entryDev = std::make_unique<LibArchiveIODevice>(std::move(archive), entry, nullptr);
-                    if(entryDev) {
-                        // Use first valid image
-                        coverData = entryDev->readAll();
-                        break;
+                    if(auto storedDev = storedEntry(entryPath)) {
+                        coverData = storedDev->readAll();
+                    }
+                    else {
+                        LibArchiveIODevice entryDev{std::move(archive), entry, {}};
+                        coverData = entryDev.readAll();
                     }
+                    // Use first valid image
+                    break;
                 }
             }
         }
@@ -268,6 +410,11 @@ QByteArray LibArchiveReader::readCover(const Track& track, Track::Cover cover)
 
     return coverData;
 }
+
+std::unique_ptr<QIODevice> LibArchiveReader::storedEntry(const QString& path) const
+{
+    return m_hasZipIndex ? m_zipIndex.openStored(path) : nullptr;
+}
 } // namespace Fooyin::LibArchive
 
 #include "moc_libarchiveinput.cpp"
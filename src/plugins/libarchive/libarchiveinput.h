@@ -19,14 +19,18 @@
 
 #pragma once
 
+#include "zipindex.h"
+
 #include <core/engine/audioinput.h>
 #include <core/engine/audioloader.h>
 
-#include <QBuffer>
 #include <QFile>
 
 #include <archive.h>
 
+#include <functional>
+#include <map>
+
 struct archive;
 struct archive_entry;
 
@@ -43,15 +47,23 @@ struct ArchiveDeleter
 };
 using ArchivePtr = std::unique_ptr<archive, ArchiveDeleter>;
 
+/*!
+ * Streams an entry of an archive opened with libarchive.
+ * Only the data actually read is kept; anything seeked over is decompressed and discarded,
+ * so reading the tags of an entry doesn't buffer the whole of it.
+ * Seeking back over discarded data reopens the archive using @p reopen.
+ */
 class LibArchiveIODevice : public QIODevice
 {
     Q_OBJECT
 
 public:
-    LibArchiveIODevice(ArchivePtr archive, archive_entry* entry, QObject* parent = nullptr);
+    using ReopenArchive = std::function<ArchivePtr()>;
+
+    LibArchiveIODevice(ArchivePtr archive, archive_entry* entry, ReopenArchive reopen, QObject* parent = nullptr);
     ~LibArchiveIODevice() override;
 
-    bool seek(qint64 pos) override;
+    bool open(OpenMode mode) override;
     [[nodiscard]] qint64 size() const override;
 
     archive* releaseArchive();
@@ -61,9 +73,20 @@ protected:
     qint64 writeData(const char* data, qint64 len) override;
 
 private:
+    qint64 readCached(qint64 pos, char* data, qint64 maxlen) const;
+    qint64 readArchive(qint64 maxlen);
+    bool skipTo(qint64 pos);
+    bool rewind();
+    void setArchiveError(const char* message);
+
     ArchivePtr m_archive;
-    archive_entry* m_entry;
-    QBuffer m_buffer;
+    ReopenArchive m_reopen;
+    // -1 if unknown
+    qint64 m_size;
+    // Offset of the next byte to be read from the archive
+    qint64 m_archivePos;
+    // Data read so far, keyed by offset
+    std::map<qint64, QByteArray> m_chunks;
 };
 
 class LibArchiveReader : public ArchiveReader
@@ -78,8 +101,12 @@ public:
     QByteArray readCover(const Track& track, Track::Cover cover) override;
 
 private:
+    [[nodiscard]] std::unique_ptr<QIODevice> storedEntry(const QString& path) const;
+
     QString m_file;
-    std::unique_ptr<LibArchiveIODevice> m_device;
     QString m_type;
+    // Only read for zip archives
+    ZipIndex m_zipIndex;
+    bool m_hasZipIndex{false};
 };
 } // namespace Fooyin::LibArchive
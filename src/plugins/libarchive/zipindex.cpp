@@ -0,0 +1,283 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "zipindex.h"
+
+#include <QDir>
+#include <QLoggingCategory>
+#include <QtEndian>
+
+#include <optional>
+
+Q_LOGGING_CATEGORY(ZIP_INDEX, "fy.libarchive.zip")
+
+constexpr quint32 EndOfDirSignature       = 0x06054b50;
+constexpr quint32 Zip64EndOfDirSignature  = 0x06064b50;
+constexpr quint32 Zip64LocatorSignature   = 0x07064b50;
+constexpr quint32 DirectoryEntrySignature = 0x02014b50;
+constexpr quint32 LocalHeaderSignature    = 0x04034b50;
+constexpr quint16 Zip64ExtraId            = 0x0001;
+constexpr quint16 EncryptedFlag           = 1 << 0;
+constexpr quint16 Utf8Flag                = 1 << 11;
+constexpr quint16 StoredMethod            = 0;
+constexpr qint64 EndOfDirSize             = 22;
+constexpr qint64 Zip64LocatorSize         = 20;
+constexpr qint64 Zip64EndOfDirSize        = 56;
+constexpr qint64 DirectoryEntrySize       = 46;
+constexpr qint64 LocalHeaderSize          = 30;
+constexpr qint64 MaxCommentSize           = 0xFFFF;
+constexpr qint64 MaxCentralDirectorySize  = 64 * 1024 * 1024;
+constexpr quint32 Zip64Placeholder        = 0xFFFFFFFF;
+
+namespace {
+template <typename T>
+T readLE(const QByteArray& data, qint64 offset)
+{
+    return qFromLittleEndian<T>(data.constData() + offset);
+}
+
+QByteArray readAt(QFile& file, qint64 offset, qint64 size)
+{
+    if(!file.seek(offset)) {
+        return {};
+    }
+    QByteArray data = file.read(size);
+    return data.size() == size ? data : QByteArray{};
+}
+
+struct CentralDirectory
+{
+    qint64 offset{0};
+    qint64 size{0};
+};
+
+std::optional<CentralDirectory> findCentralDirectory(QFile& file)
+{
+    const qint64 fileSize = file.size();
+    if(fileSize < EndOfDirSize) {
+        return {};
+    }
+
+    // The end of directory record is followed by a comment of up to 64 KiB
+    const qint64 tailSize  = std::min(fileSize, EndOfDirSize + MaxCommentSize);
+    const qint64 tailStart = fileSize - tailSize;
+    const QByteArray tail  = readAt(file, tailStart, tailSize);
+    if(tail.isEmpty()) {
+        return {};
+    }
+
+    for(qint64 pos = tailSize - EndOfDirSize; pos >= 0; --pos) {
+        if(readLE<quint32>(tail, pos) != EndOfDirSignature) {
+            continue;
+        }
+
+        CentralDirectory dir{.offset = readLE<quint32>(tail, pos + 16), .size = readLE<quint32>(tail, pos + 12)};
+
+        if(dir.offset == Zip64Placeholder || dir.size == Zip64Placeholder) {
+            const qint64 locatorPos = tailStart + pos - Zip64LocatorSize;
+            const QByteArray locator = locatorPos >= 0 ? readAt(file, locatorPos, Zip64LocatorSize) : QByteArray{};
+            if(locator.isEmpty() || readLE<quint32>(locator, 0) != Zip64LocatorSignature) {
+                return {};
+            }
+
+            const QByteArray record = readAt(file, readLE<qint64>(locator, 8), Zip64EndOfDirSize);
+            if(record.isEmpty() || readLE<quint32>(record, 0) != Zip64EndOfDirSignature) {
+                return {};
+            }
+
+            dir.size   = readLE<qint64>(record, 40);
+            dir.offset = readLE<qint64>(record, 48);
+        }
+
+        if(dir.offset < 0 || dir.size < 0 || dir.offset + dir.size > fileSize) {
+            return {};
+        }
+        return dir;
+    }
+
+    return {};
+}
+
+// Replaces any sizes or offsets too large for the directory entry with their zip64 values
+void readZip64Extra(const QByteArray& extra, qint64& compressedSize, qint64& size, qint64& headerOffset)
+{
+    for(qint64 pos{0}; pos + 4 <= extra.size();) {
+        const auto id       = readLE<quint16>(extra, pos);
+        const auto dataSize = readLE<quint16>(extra, pos + 2);
+        pos += 4;
+
+        if(id == Zip64ExtraId) {
+            qint64 fieldPos = pos;
+            for(qint64* value : {&size, &compressedSize, &headerOffset}) {
+                if(*value == Zip64Placeholder && fieldPos + 8 <= pos + dataSize && fieldPos + 8 <= extra.size()) {
+                    *value = readLE<qint64>(extra, fieldPos);
+                    fieldPos += 8;
+                }
+            }
+            return;
+        }
+
+        pos += dataSize;
+    }
+}
+} // namespace
+
+namespace Fooyin::LibArchive {
+FileRangeDevice::FileRangeDevice(std::unique_ptr<QFile> file, qint64 offset, qint64 size, QObject* parent)
+    : QIODevice{parent}
+    , m_file{std::move(file)}
+    , m_offset{offset}
+    , m_size{size}
+{
+    open(QIODevice::ReadOnly);
+}
+
+bool FileRangeDevice::open(OpenMode mode)
+{
+    // Reads are already served straight from the file
+    return QIODevice::open(mode | QIODevice::Unbuffered);
+}
+
+qint64 FileRangeDevice::size() const
+{
+    return m_size;
+}
+
+qint64 FileRangeDevice::readData(char* data, qint64 maxlen)
+{
+    const qint64 len = std::min(maxlen, m_size - pos());
+    if(len <= 0) {
+        return 0;
+    }
+
+    if(!m_file->seek(m_offset + pos())) {
+        return -1;
+    }
+
+    return m_file->read(data, len);
+}
+
+qint64 FileRangeDevice::writeData(const char* /*data*/, qint64 /*len*/)
+{
+    return -1;
+}
+
+bool ZipIndex::read(const QString& filepath)
+{
+    clear();
+
+    QFile file{filepath};
+    if(!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    const auto dir = findCentralDirectory(file);
+    if(!dir || dir->size > MaxCentralDirectorySize) {
+        return false;
+    }
+
+    const QByteArray entries = readAt(file, dir->offset, dir->size);
+    if(entries.size() != dir->size) {
+        return false;
+    }
+
+    for(qint64 pos{0}; pos + DirectoryEntrySize <= entries.size();) {
+        if(readLE<quint32>(entries, pos) != DirectoryEntrySignature) {
+            qCDebug(ZIP_INDEX) << "Invalid central directory in" << filepath;
+            clear();
+            return false;
+        }
+
+        const auto flags       = readLE<quint16>(entries, pos + 8);
+        const auto method      = readLE<quint16>(entries, pos + 10);
+        qint64 compressedSize  = readLE<quint32>(entries, pos + 20);
+        qint64 size            = readLE<quint32>(entries, pos + 24);
+        const auto nameLength  = readLE<quint16>(entries, pos + 28);
+        const auto extraLength = readLE<quint16>(entries, pos + 30);
+        const auto commentLen  = readLE<quint16>(entries, pos + 32);
+        qint64 headerOffset    = readLE<quint32>(entries, pos + 42);
+
+        const qint64 namePos = pos + DirectoryEntrySize;
+        pos                  = namePos + nameLength + extraLength + commentLen;
+        if(pos > entries.size()) {
+            break;
+        }
+
+        if(method != StoredMethod || (flags & EncryptedFlag)) {
+            continue;
+        }
+
+        readZip64Extra(entries.sliced(namePos + nameLength, extraLength), compressedSize, size, headerOffset);
+        if(compressedSize != size) {
+            continue;
+        }
+
+        const QByteArray rawName = entries.sliced(namePos, nameLength);
+        // Decoded the same way as the paths libarchive returns, so lookups by those paths match
+        const QString name = QDir::fromNativeSeparators((flags & Utf8Flag) ? QString::fromUtf8(rawName)
+                                                                           : QFile::decodeName(rawName));
+        if(name.isEmpty() || name.endsWith(u'/')) {
+            continue;
+        }
+
+        m_storedEntries.emplace(name, Entry{.size = size, .headerOffset = headerOffset});
+    }
+
+    m_file = filepath;
+    return true;
+}
+
+void ZipIndex::clear()
+{
+    m_file.clear();
+    m_storedEntries.clear();
+}
+
+std::unique_ptr<QIODevice> ZipIndex::openStored(const QString& path) const
+{
+    const auto entryIt = m_storedEntries.find(path);
+    if(entryIt == m_storedEntries.cend()) {
+        return nullptr;
+    }
+
+    const Entry& entry = entryIt->second;
+
+    auto file = std::make_unique<QFile>(m_file);
+    if(!file->open(QIODevice::ReadOnly)) {
+        return nullptr;
+    }
+
+    // The local header's name and extra field lengths can differ from those in the central directory
+    const QByteArray header = readAt(*file, entry.headerOffset, LocalHeaderSize);
+    if(header.isEmpty() || readLE<quint32>(header, 0) != LocalHeaderSignature) {
+        qCDebug(ZIP_INDEX) << "Invalid local header for" << path << "in" << m_file;
+        return nullptr;
+    }
+
+    const qint64 dataOffset
+        = entry.headerOffset + LocalHeaderSize + readLE<quint16>(header, 26) + readLE<quint16>(header, 28);
+    if(dataOffset + entry.size > file->size()) {
+        return nullptr;
+    }
+
+    return std::make_unique<FileRangeDevice>(std::move(file), dataOffset, entry.size);
+}
+} // namespace Fooyin::LibArchive
+
+#include "moc_zipindex.cpp"
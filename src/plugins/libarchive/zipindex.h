@@ -0,0 +1,83 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <QFile>
+#include <QIODevice>
+
+#include <memory>
+#include <unordered_map>
+
+namespace Fooyin::LibArchive {
+/*!
+ * Read-only view of a range of a file.
+ */
+class FileRangeDevice : public QIODevice
+{
+    Q_OBJECT
+
+public:
+    FileRangeDevice(std::unique_ptr<QFile> file, qint64 offset, qint64 size, QObject* parent = nullptr);
+
+    bool open(OpenMode mode) override;
+    [[nodiscard]] qint64 size() const override;
+
+protected:
+    qint64 readData(char* data, qint64 maxlen) override;
+    qint64 writeData(const char* data, qint64 len) override;
+
+private:
+    std::unique_ptr<QFile> m_file;
+    qint64 m_offset;
+    qint64 m_size;
+};
+
+/*!
+ * Index of the entries in a zip archive, read from its central directory.
+ * Entries which are stored uncompressed can be read directly from the archive
+ * file, so only the parts of them actually needed are read.
+ */
+class ZipIndex
+{
+public:
+    /*!
+     * Reads the central directory of @p filepath.
+     * @returns false if it isn't a zip archive or the directory couldn't be read.
+     */
+    bool read(const QString& filepath);
+    void clear();
+
+    /*!
+     * Returns a device for the entry at @p path if it's stored uncompressed, otherwise nullptr.
+     */
+    [[nodiscard]] std::unique_ptr<QIODevice> openStored(const QString& path) const;
+
+private:
+    struct Entry
+    {
+        qint64 size{0};
+        // Offset of the local file header
+        qint64 headerOffset{0};
+    };
+
+    QString m_file;
+    std::unordered_map<QString, Entry> m_storedEntries;
+};
+} // namespace Fooyin::LibArchive
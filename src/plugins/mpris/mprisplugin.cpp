@@ -422,7 +422,7 @@ void MprisPlugin::loadMetaData(const PlaylistTrack& playlistTrack)
         emit reloadMetadata();
     };
 
-    const QString coverKey = Utils::generateHash(u"MPRIS"_s, track.hash());
+    const QString coverKey = Utils::generateHash(u"MPRIS"_s, QString::number(track.hash()));
     if(m_currCoverKey != coverKey) {
         QFile::remove(currentCoverPath());
 
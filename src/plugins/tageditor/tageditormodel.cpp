@@ -25,6 +25,7 @@
 #include <core/scripting/scriptregistry.h>
 #include <gui/guisettings.h>
 #include <gui/trackselectioncontroller.h>
+#include <utils/async.h>
 #include <utils/helpers.h>
 #include <utils/settings/settingsmanager.h>
 #include <utils/starrating.h>
@@ -59,6 +60,7 @@ public:
     ScriptRegistry m_scriptRegistry;
 
     TrackList m_tracks;
+    int m_loadId{0};
 
     QString m_defaultFieldtext{u"<input field name>"_s};
     std::vector<TagEditorField> m_fields;
@@ -201,6 +203,29 @@ TrackList TagEditorModel::tracks() const
 }
 
 void TagEditorModel::reset(const TrackList& tracks, const std::vector<TagEditorField>& fields)
+{
+    const int loadId = ++p->m_loadId;
+
+    if(std::ranges::none_of(tracks, &Track::hasDeferredFields)) {
+        populate(tracks, fields);
+        return;
+    }
+
+    // Clear the previous tracks while the rarely used fields are loaded off the GUI thread
+    beginResetModel();
+    p->reset();
+    p->m_tracks = tracks;
+    p->m_fields.clear();
+    endResetModel();
+
+    Utils::asyncExec([tracks]() { Track::loadDeferredFields(tracks); }).then(this, [this, loadId, tracks, fields]() {
+        if(loadId == p->m_loadId) {
+            populate(tracks, fields);
+        }
+    });
+}
+
+void TagEditorModel::populate(const TrackList& tracks, const std::vector<TagEditorField>& fields)
 {
     beginResetModel();
     p->reset();
@@ -64,6 +64,8 @@ public:
     void removePendingRow() override;
 
 private:
+    void populate(const TrackList& tracks, const std::vector<TagEditorField>& fields);
+
     std::unique_ptr<TagEditorModelPrivate> p;
 };
 } // namespace TagEditor
@@ -176,7 +176,7 @@ QString WaveBarDatabase::cacheKey(const Track& track)
 
 QString WaveBarDatabase::cacheKey(const Track& track, int channels)
 {
-    return Utils::generateHash(track.hash(), QString::number(track.duration()), QString::number(track.sampleRate()),
-                               QString::number(channels));
+    return Utils::generateHash(QString::number(track.hash()), QString::number(track.duration()),
+                               QString::number(track.sampleRate()), QString::number(channels));
 }
 } // namespace Fooyin::WaveBar
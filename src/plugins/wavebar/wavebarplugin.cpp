@@ -50,6 +50,7 @@ Fooyin::DbConnection::DbParams dbConnectionParams()
     params.type           = u"QSQLITE"_s;
     params.connectOptions = u"QSQLITE_OPEN_URI"_s;
     params.filePath       = Fooyin::WaveBar::cachePath();
+    params.writeAheadLog  = true;
 
     return params;
 }
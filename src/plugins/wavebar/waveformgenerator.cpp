@@ -117,6 +117,9 @@ void WaveformGenerator::initialiseThread()
     m_dbHandler = std::make_unique<DbConnectionHandler>(m_dbPool);
     m_waveDb.initialise(DbConnectionProvider{m_dbPool});
     m_waveDb.initialiseDatabase();
+
+    m_readDbHandler = std::make_unique<DbConnectionHandler>(m_dbPool, DbConnection::Mode::ReadOnly);
+    m_waveReader.initialise(DbConnectionProvider{m_dbPool, DbConnection::Mode::ReadOnly});
 }
 
 void WaveformGenerator::generate(const Track& track, int samplesPerChannel, bool render, bool update)
@@ -132,10 +135,10 @@ void WaveformGenerator::generate(const Track& track, int samplesPerChannel, bool
 
     setState(Running);
 
-    if(!update && m_waveDb.existsInCache(trackKey)) {
+    if(!update && m_waveReader.existsInCache(trackKey)) {
         if(render) {
             WaveformData<int16_t> data;
-            if(m_waveDb.loadCachedData(trackKey, data)) {
+            if(m_waveReader.loadCachedData(trackKey, data)) {
                 const auto floatData = convertCache<float>(data);
                 m_data.channelData   = floatData.channelData;
                 m_data.complete      = true;
@@ -61,7 +61,10 @@ private:
     std::unique_ptr<AudioDecoder> m_decoder;
     DbConnectionPoolPtr m_dbPool;
     std::unique_ptr<DbConnectionHandler> m_dbHandler;
+    std::unique_ptr<DbConnectionHandler> m_readDbHandler;
     WaveBarDatabase m_waveDb;
+    // Cache lookups, which shouldn't wait on another thread storing data
+    WaveBarDatabase m_waveReader;
 
     Track m_track;
     AudioFormat m_format;
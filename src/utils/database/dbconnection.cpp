@@ -25,6 +25,8 @@
 
 Q_LOGGING_CATEGORY(DB_CON, "fy.db")
 
+using namespace Qt::StringLiterals;
+
 namespace {
 void createDatabase(const Fooyin::DbConnection::DbParams& params, const QString& connectionName)
 {
@@ -34,29 +36,44 @@ void createDatabase(const Fooyin::DbConnection::DbParams& params, const QString&
     database.setDatabaseName(params.filePath);
 }
 
-void cloneDatabase(const Fooyin::DbConnection& original, const QString& connectionName)
+void cloneDatabase(const Fooyin::DbConnection& original, const QString& connectionName,
+                   Fooyin::DbConnection::Mode mode)
 {
-    QSqlDatabase::cloneDatabase(original.name(), connectionName);
+    QSqlDatabase database = QSqlDatabase::cloneDatabase(original.name(), connectionName);
+
+    if(mode == Fooyin::DbConnection::Mode::ReadOnly) {
+        QString options = database.connectOptions();
+        if(!options.isEmpty()) {
+            options.append(u';');
+        }
+        options.append(u"QSQLITE_OPEN_READONLY"_s);
+        database.setConnectOptions(options);
+    }
 }
 } // namespace
 
 namespace Fooyin {
 DbConnection::DbConnection(const DbParams& params, const QString& connectionName)
     : m_name{connectionName}
+    , m_mode{Mode::ReadWrite}
+    , m_stats{DbQueryStats::registerConnection(connectionName)}
 {
     createDatabase(params, connectionName);
 }
 
-DbConnection::DbConnection(const DbConnection& original, const QString& connectionName)
+DbConnection::DbConnection(const DbConnection& original, const QString& connectionName, Mode mode)
     : m_name{connectionName}
+    , m_mode{mode}
+    , m_stats{DbQueryStats::registerConnection(connectionName)}
 {
-    cloneDatabase(original, connectionName);
+    cloneDatabase(original, connectionName, mode);
 }
 
 DbConnection::~DbConnection()
 {
     close();
     QSqlDatabase::removeDatabase(m_name);
+    DbQueryStats::unregisterConnection(m_name);
 }
 
 QString DbConnection::name() const
@@ -64,6 +81,16 @@ QString DbConnection::name() const
     return m_name;
 }
 
+DbConnection::Mode DbConnection::mode() const
+{
+    return m_mode;
+}
+
+std::shared_ptr<DbQueryStats> DbConnection::stats() const
+{
+    return m_stats;
+}
+
 bool DbConnection::open()
 {
     auto db = this->db();
@@ -78,6 +105,9 @@ bool DbConnection::open()
 
 void DbConnection::close()
 {
+    // Prepared statements must be finalised before closing
+    m_statements.clear();
+
     auto db = this->db();
     if(db.isOpen()) {
         if(db.rollback()) {
@@ -96,4 +126,14 @@ QSqlDatabase DbConnection::db() const
 {
     return QSqlDatabase::database(m_name);
 }
+
+DbQuery& DbConnection::cachedQuery(const QString& statement)
+{
+    if(const auto queryIt = m_statements.find(statement); queryIt != m_statements.end()) {
+        queryIt->second.reset();
+        return queryIt->second;
+    }
+
+    return m_statements.emplace(statement, DbQuery{db(), statement}).first->second;
+}
 } // namespace Fooyin
@@ -22,17 +22,18 @@
 #include <utils/database/dbconnectionpool.h>
 
 namespace Fooyin {
-DbConnectionHandler::DbConnectionHandler(const DbConnectionPoolPtr& dbPool)
+DbConnectionHandler::DbConnectionHandler(const DbConnectionPoolPtr& dbPool, DbConnection::Mode mode)
+    : m_mode{mode}
 {
-    if(dbPool && !dbPool->hasThreadConnection() && dbPool->createThreadConnection()) {
+    if(dbPool && !dbPool->hasThreadConnection(mode) && dbPool->createThreadConnection(mode)) {
         m_dbPool = dbPool;
     }
 }
 
 DbConnectionHandler::~DbConnectionHandler()
 {
-    if(m_dbPool && m_dbPool->hasThreadConnection()) {
-        m_dbPool->destroyThreadConnection();
+    if(m_dbPool && m_dbPool->hasThreadConnection(m_mode)) {
+        m_dbPool->destroyThreadConnection(m_mode);
     }
 }
 
@@ -27,15 +27,44 @@ Q_LOGGING_CATEGORY(DB_POOL, "fy.db")
 using namespace Qt::StringLiterals;
 
 namespace {
-bool updatePragmas(Fooyin::DbConnection* connection)
+bool execPragma(Fooyin::DbConnection* connection, const QString& pragma)
 {
-    QSqlQuery foreignKeys{connection->db()};
-    if(!foreignKeys.exec(u"PRAGMA foreign_keys = ON;"_s)) {
+    QSqlQuery query{connection->db()};
+    return query.exec(pragma);
+}
+
+bool updatePragmas(Fooyin::DbConnection* connection, bool writeAheadLog)
+{
+    if(!execPragma(connection, u"PRAGMA foreign_keys = ON;"_s)) {
         return false;
     }
 
+    if(writeAheadLog && connection->mode() == Fooyin::DbConnection::Mode::ReadWrite) {
+        // Stored in the database, so this only has an effect the first time.
+        // Failing isn't fatal, it just means readers may wait on writers.
+        if(!execPragma(connection, u"PRAGMA journal_mode = WAL;"_s)) {
+            qCInfo(DB_POOL) << "Unable to enable write-ahead log:" << connection->name();
+        }
+        // Commits may be rolled back after a power loss, but the database can't be corrupted in WAL mode
+        execPragma(connection, u"PRAGMA synchronous = NORMAL;"_s);
+    }
+
     return true;
 }
+
+void addTotals(Fooyin::DbConnectionPool::ConnectionStats& totals, const Fooyin::DbQueryStats& stats)
+{
+    totals.statements += stats.statements.load(std::memory_order_relaxed);
+    totals.lockFailures += stats.lockFailures.load(std::memory_order_relaxed);
+    totals.execTime += std::chrono::nanoseconds{stats.execTime.load(std::memory_order_relaxed)};
+    totals.longestExec
+        = std::max(totals.longestExec, std::chrono::nanoseconds{stats.longestExec.load(std::memory_order_relaxed)});
+}
+
+size_t modeIndex(Fooyin::DbConnection::Mode mode)
+{
+    return mode == Fooyin::DbConnection::Mode::ReadOnly ? 1 : 0;
+}
 } // namespace
 
 namespace Fooyin {
@@ -49,55 +78,130 @@ DbConnectionPool::DbConnectionPool(PrivateKey /*key*/, const DbConnection::DbPar
                                    const QString& connectionName)
     : m_connectionCount{0}
     , m_prototype{params, connectionName}
-{ }
+    , m_writeAheadLog{params.writeAheadLog}
+{
+    for(const auto mode : {DbConnection::Mode::ReadWrite, DbConnection::Mode::ReadOnly}) {
+        auto& closed  = m_closedStats.at(modeIndex(mode));
+        closed.name   = connectionName;
+        closed.mode   = mode;
+        closed.closed = true;
+    }
+}
 
 DbConnectionPoolPtr DbConnectionPool::create(const DbConnection::DbParams& params, const QString& connectionName)
 {
     return std::make_shared<DbConnectionPool>(PrivateKey{}, params, connectionName);
 }
 
-bool DbConnectionPool::hasThreadConnection() const
+bool DbConnectionPool::hasThreadConnection(DbConnection::Mode mode) const
+{
+    return threadConnections(mode).hasLocalData();
+}
+
+std::vector<DbConnectionPool::ConnectionStats> DbConnectionPool::connectionStats() const
+{
+    const std::scoped_lock lock{m_statsMutex};
+
+    std::vector<ConnectionStats> stats;
+    auto closedStats = m_closedStats;
+
+    for(const auto& entry : m_stats) {
+        // Only referenced here once the connection has been destroyed
+        if(entry.stats.use_count() == 1) {
+            addTotals(closedStats.at(modeIndex(entry.mode)), *entry.stats);
+            continue;
+        }
+
+        ConnectionStats connectionStats;
+        connectionStats.name = entry.name;
+        connectionStats.mode = entry.mode;
+        addTotals(connectionStats, *entry.stats);
+        stats.push_back(connectionStats);
+    }
+
+    for(const auto& closed : closedStats) {
+        if(closed.statements > 0) {
+            stats.push_back(closed);
+        }
+    }
+
+    return stats;
+}
+
+DbConnection* DbConnectionPool::threadConnection(DbConnection::Mode mode) const
 {
-    return m_threadConnections.hasLocalData();
+    if(mode == DbConnection::Mode::ReadOnly && m_readConnections.hasLocalData()) {
+        return m_readConnections.localData();
+    }
+
+    return m_threadConnections.localData();
 }
 
-bool DbConnectionPool::createThreadConnection()
+bool DbConnectionPool::createThreadConnection(DbConnection::Mode mode)
 {
-    if(m_threadConnections.hasLocalData()) {
-        qCWarning(DB_POOL) << "Thread connection already exists:" << m_threadConnections.localData()->name();
+    auto& connections = threadConnections(mode);
+
+    if(connections.hasLocalData()) {
+        qCWarning(DB_POOL) << "Thread connection already exists:" << connections.localData()->name();
         return false;
     }
 
     const int connectionIndex = m_connectionCount.fetch_add(1, std::memory_order_acquire) + 1;
-    const auto connectionName = u"%1-%2"_s.arg(m_prototype.name()).arg(connectionIndex);
-    auto connection           = std::make_unique<DbConnection>(m_prototype, connectionName);
+    const auto connectionName = mode == DbConnection::Mode::ReadOnly
+                                  ? u"%1-ro-%2"_s.arg(m_prototype.name()).arg(connectionIndex)
+                                  : u"%1-%2"_s.arg(m_prototype.name()).arg(connectionIndex);
+    auto connection           = std::make_unique<DbConnection>(m_prototype, connectionName, mode);
 
     if(!connection->open()) {
         qCWarning(DB_POOL) << "Failed to open thread connection:" << connectionName;
         return false;
     }
 
-    if(!updatePragmas(connection.get())) {
+    if(!updatePragmas(connection.get(), m_writeAheadLog)) {
         qCWarning(DB_POOL) << "Failed to set pragmas:" << connectionName;
         return false;
     }
 
-    m_threadConnections.setLocalData(connection.release());
+    addStats(*connection);
+    connections.setLocalData(connection.release());
 
     return true;
 }
 
-void DbConnectionPool::destroyThreadConnection()
+void DbConnectionPool::destroyThreadConnection(DbConnection::Mode mode)
 {
-    if(!m_threadConnections.hasLocalData()) {
+    auto& connections = threadConnections(mode);
+
+    if(!connections.hasLocalData()) {
         qCWarning(DB_POOL) << "Thread connection not found";
     }
 
-    m_threadConnections.setLocalData(nullptr);
+    connections.setLocalData(nullptr);
 }
 
-DbConnection* DbConnectionPool::threadConnection() const
+QThreadStorage<DbConnection*>& DbConnectionPool::threadConnections(DbConnection::Mode mode)
 {
-    return m_threadConnections.localData();
+    return mode == DbConnection::Mode::ReadOnly ? m_readConnections : m_threadConnections;
+}
+
+const QThreadStorage<DbConnection*>& DbConnectionPool::threadConnections(DbConnection::Mode mode) const
+{
+    return mode == DbConnection::Mode::ReadOnly ? m_readConnections : m_threadConnections;
+}
+
+void DbConnectionPool::addStats(const DbConnection& connection)
+{
+    const std::scoped_lock lock{m_statsMutex};
+
+    // Fold connections which have since been destroyed into the totals
+    std::erase_if(m_stats, [this](const StatsEntry& entry) {
+        if(entry.stats.use_count() > 1) {
+            return false;
+        }
+        addTotals(m_closedStats.at(modeIndex(entry.mode)), *entry.stats);
+        return true;
+    });
+
+    m_stats.push_back({.name = connection.name(), .mode = connection.mode(), .stats = connection.stats()});
 }
 } // namespace Fooyin
@@ -29,29 +29,48 @@ DbConnectionProvider::DbConnectionProvider()
     : DbConnectionProvider{nullptr}
 { }
 
-DbConnectionProvider::DbConnectionProvider(DbConnectionPoolPtr pool)
+DbConnectionProvider::DbConnectionProvider(DbConnectionPoolPtr pool, DbConnection::Mode mode)
     : m_connectionPool{std::move(pool)}
+    , m_mode{mode}
 { }
 
 QSqlDatabase DbConnectionProvider::db() const
+{
+    const DbConnection* connection = this->connection();
+    return connection ? connection->db() : QSqlDatabase{};
+}
+
+DbQuery& DbConnectionProvider::cachedQuery(const QString& statement) const
+{
+    if(DbConnection* connection = this->connection()) {
+        return connection->cachedQuery(statement);
+    }
+
+    // Fails on exec, as a query on an invalid database would
+    thread_local DbQuery invalidQuery;
+    invalidQuery = DbQuery{};
+    return invalidQuery;
+}
+
+DbConnection* DbConnectionProvider::connection() const
 {
     if(!m_connectionPool) {
         qCWarning(DB_CONPROV) << "No connection pool";
-        return {};
+        return nullptr;
     }
 
-    const DbConnection* connection = m_connectionPool->threadConnection();
+    DbConnection* connection = m_connectionPool->threadConnection(m_mode);
 
     if(!connection) {
         qCWarning(DB_CONPROV) << "Thread connection not found";
-        return {};
+        return nullptr;
     }
 
     if(!connection->isOpen() && !connection->db().open()) {
         qCWarning(DB_CONPROV) << "Thread connection could not be opened";
-        return {};
+        return nullptr;
     }
 
-    return connection->db();
+    return connection;
 }
 } // namespace Fooyin
@@ -23,6 +23,9 @@
 #include <QRegularExpression>
 #include <QSqlError>
 
+#include <mutex>
+#include <unordered_map>
+
 Q_LOGGING_CATEGORY(DB_QRY, "fy.db")
 
 using namespace Qt::StringLiterals;
@@ -63,9 +66,72 @@ QString lastExecutedQuery(const QSqlQuery& query)
 
     return sql;
 }
+
+bool isLockError(const QSqlError& error)
+{
+    bool ok{false};
+    const int code = error.nativeErrorCode().toInt(&ok);
+    if(!ok) {
+        return false;
+    }
+
+    // SQLITE_BUSY and SQLITE_LOCKED, including their extended codes
+    const int primaryCode = code & 0xff;
+    return primaryCode == 5 || primaryCode == 6;
+}
+
+std::mutex& statsMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::unordered_map<QString, std::shared_ptr<Fooyin::DbQueryStats>>& connectionStats()
+{
+    static std::unordered_map<QString, std::shared_ptr<Fooyin::DbQueryStats>> stats;
+    return stats;
+}
 } // namespace
 
 namespace Fooyin {
+void DbQueryStats::record(std::chrono::nanoseconds time, bool lockFailure)
+{
+    statements.fetch_add(1, std::memory_order_relaxed);
+    if(lockFailure) {
+        lockFailures.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    const auto count = static_cast<int64_t>(time.count());
+    execTime.fetch_add(count, std::memory_order_relaxed);
+
+    int64_t longest = longestExec.load(std::memory_order_relaxed);
+    while(count > longest && !longestExec.compare_exchange_weak(longest, count, std::memory_order_relaxed)) { }
+}
+
+std::shared_ptr<DbQueryStats> DbQueryStats::find(const QString& connectionName)
+{
+    const std::scoped_lock lock{statsMutex()};
+
+    const auto& stats = connectionStats();
+    if(const auto statsIt = stats.find(connectionName); statsIt != stats.cend()) {
+        return statsIt->second;
+    }
+
+    return {};
+}
+
+std::shared_ptr<DbQueryStats> DbQueryStats::registerConnection(const QString& connectionName)
+{
+    const std::scoped_lock lock{statsMutex()};
+    return connectionStats().insert_or_assign(connectionName, std::make_shared<DbQueryStats>()).first->second;
+}
+
+void DbQueryStats::unregisterConnection(const QString& connectionName)
+{
+    const std::scoped_lock lock{statsMutex()};
+    connectionStats().erase(connectionName);
+}
+
 DbQuery::DbQuery()
     : m_status{Status::None}
 { }
@@ -73,6 +139,7 @@ DbQuery::DbQuery()
 DbQuery::DbQuery(const QSqlDatabase& database, const QString& statement)
     : m_query{database}
     , m_status{Status::None}
+    , m_stats{DbQueryStats::find(database.connectionName())}
 {
     if(prepareQuery(m_query, statement)) {
         m_status = Status::Prepared;
@@ -99,6 +166,14 @@ QSqlError DbQuery::lastError() const
     return m_query.lastError();
 }
 
+void DbQuery::reset()
+{
+    m_query.finish();
+    if(m_status == Status::Success) {
+        m_status = Status::Prepared;
+    }
+}
+
 void DbQuery::bindValue(const QString& placeholder, const QVariant& value)
 {
     m_query.bindValue(placeholder, value);
@@ -111,7 +186,14 @@ QString DbQuery::executedQuery() const
 
 bool DbQuery::exec()
 {
-    if(m_query.exec()) {
+    const auto start   = std::chrono::steady_clock::now();
+    const bool success = m_query.exec();
+
+    if(m_stats) {
+        m_stats->record(std::chrono::steady_clock::now() - start, !success && isLockError(lastError()));
+    }
+
+    if(success) {
         m_status = Status::Success;
         return true;
     }
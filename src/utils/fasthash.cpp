@@ -0,0 +1,183 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <utils/fasthash.h>
+
+#include <QtEndian>
+
+#include <bit>
+#include <cstring>
+
+// Reference: https://github.com/Cyan4973/xxHash/blob/dev/doc/xxhash_spec.md
+
+constexpr uint64_t Prime1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t Prime2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t Prime3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t Prime4 = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64_t Prime5 = 0x27D4EB2F165667C5ULL;
+
+constexpr size_t StripeSize = 32;
+
+namespace {
+uint64_t read64(const unsigned char* data)
+{
+    uint64_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return qFromLittleEndian(value);
+}
+
+uint32_t read32(const unsigned char* data)
+{
+    uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return qFromLittleEndian(value);
+}
+
+uint64_t roundAcc(uint64_t acc, uint64_t input)
+{
+    acc += input * Prime2;
+    acc = std::rotl(acc, 31);
+    return acc * Prime1;
+}
+
+uint64_t mergeRound(uint64_t acc, uint64_t value)
+{
+    acc ^= roundAcc(0, value);
+    return acc * Prime1 + Prime4;
+}
+} // namespace
+
+namespace Fooyin {
+FastHash::FastHash(uint64_t seed)
+    : m_seed{seed}
+    , m_acc{}
+    , m_buffer{}
+    , m_bufferSize{0}
+    , m_totalSize{0}
+{
+    reset();
+}
+
+void FastHash::reset()
+{
+    m_acc        = {m_seed + Prime1 + Prime2, m_seed + Prime2, m_seed, m_seed - Prime1};
+    m_bufferSize = 0;
+    m_totalSize  = 0;
+}
+
+void FastHash::addData(const void* data, size_t size)
+{
+    if(!data || size == 0) {
+        return;
+    }
+
+    const auto* input = static_cast<const unsigned char*>(data);
+    m_totalSize += size;
+
+    if(m_bufferSize + size < StripeSize) {
+        std::memcpy(m_buffer.data() + m_bufferSize, input, size);
+        m_bufferSize += size;
+        return;
+    }
+
+    if(m_bufferSize > 0) {
+        const size_t fill = StripeSize - m_bufferSize;
+        std::memcpy(m_buffer.data() + m_bufferSize, input, fill);
+        processStripe(m_buffer.data());
+        input += fill;
+        size -= fill;
+        m_bufferSize = 0;
+    }
+
+    while(size >= StripeSize) {
+        processStripe(input);
+        input += StripeSize;
+        size -= StripeSize;
+    }
+
+    if(size > 0) {
+        std::memcpy(m_buffer.data(), input, size);
+        m_bufferSize = size;
+    }
+}
+
+void FastHash::addData(QByteArrayView data)
+{
+    addData(data.data(), static_cast<size_t>(data.size()));
+}
+
+void FastHash::addData(QStringView str)
+{
+    addData(str.utf16(), static_cast<size_t>(str.size()) * sizeof(char16_t));
+}
+
+uint64_t FastHash::result() const
+{
+    uint64_t hash{0};
+
+    if(m_totalSize >= StripeSize) {
+        hash = std::rotl(m_acc[0], 1) + std::rotl(m_acc[1], 7) + std::rotl(m_acc[2], 12) + std::rotl(m_acc[3], 18);
+        for(const uint64_t acc : m_acc) {
+            hash = mergeRound(hash, acc);
+        }
+    }
+    else {
+        hash = m_seed + Prime5;
+    }
+
+    hash += m_totalSize;
+
+    const unsigned char* input = m_buffer.data();
+    size_t remaining           = m_bufferSize;
+
+    while(remaining >= 8) {
+        hash ^= roundAcc(0, read64(input));
+        hash = std::rotl(hash, 27) * Prime1 + Prime4;
+        input += 8;
+        remaining -= 8;
+    }
+    if(remaining >= 4) {
+        hash ^= static_cast<uint64_t>(read32(input)) * Prime1;
+        hash = std::rotl(hash, 23) * Prime2 + Prime3;
+        input += 4;
+        remaining -= 4;
+    }
+    while(remaining > 0) {
+        hash ^= (*input) * Prime5;
+        hash = std::rotl(hash, 11) * Prime1;
+        ++input;
+        --remaining;
+    }
+
+    hash ^= hash >> 33;
+    hash *= Prime2;
+    hash ^= hash >> 29;
+    hash *= Prime3;
+    hash ^= hash >> 32;
+
+    return hash;
+}
+
+void FastHash::processStripe(const unsigned char* stripe)
+{
+    for(size_t i{0}; i < m_acc.size(); ++i) {
+        m_acc.at(i) = roundAcc(m_acc.at(i), read64(stripe + (i * 8)));
+    }
+}
+} // namespace Fooyin
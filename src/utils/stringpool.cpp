@@ -0,0 +1,128 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <utils/stringpool.h>
+
+#include <utils/stringutils.h>
+
+using namespace Qt::StringLiterals;
+
+namespace {
+size_t stringBytes(const QString& str)
+{
+    return static_cast<size_t>(str.size()) * sizeof(QChar);
+}
+} // namespace
+
+namespace Fooyin {
+StringPool& StringPool::instance()
+{
+    static StringPool pool;
+    return pool;
+}
+
+QString StringPool::intern(const QString& str)
+{
+    if(str.isEmpty()) {
+        return str;
+    }
+
+    m_lookups.fetch_add(1, std::memory_order_relaxed);
+
+    Shard& shard = m_shards[qHash(str) % ShardCount];
+    const std::scoped_lock lock{shard.mutex};
+
+    if(const auto it = shard.strings.find(str); it != shard.strings.cend()) {
+        m_hits.fetch_add(1, std::memory_order_relaxed);
+        if(it->constData() != str.constData()) {
+            m_bytesSaved.fetch_add(stringBytes(str), std::memory_order_relaxed);
+        }
+        return *it;
+    }
+
+    // Avoid keeping any spare capacity alive for as long as the string is pooled
+    const QString& pooled = str.capacity() > str.size() ? *shard.strings.emplace(str.constData(), str.size()).first
+                                                        : *shard.strings.emplace(str).first;
+    shard.bytes += stringBytes(pooled);
+    return pooled;
+}
+
+QStringList StringPool::intern(const QStringList& strs)
+{
+    QStringList interned;
+    interned.reserve(strs.size());
+
+    for(const QString& str : strs) {
+        interned.append(intern(str));
+    }
+
+    return interned;
+}
+
+size_t StringPool::prune()
+{
+    size_t removed{0};
+
+    for(Shard& shard : m_shards) {
+        const std::scoped_lock lock{shard.mutex};
+
+        // Copies are only made under the lock, so a detached string can't gain a reference here
+        removed += std::erase_if(shard.strings, [&shard](const QString& str) {
+            if(str.isDetached()) {
+                shard.bytes -= stringBytes(str);
+                return true;
+            }
+            return false;
+        });
+    }
+
+    return removed;
+}
+
+StringPool::Stats StringPool::stats() const
+{
+    Stats stats;
+
+    for(const Shard& shard : m_shards) {
+        const std::scoped_lock lock{shard.mutex};
+        stats.strings += shard.strings.size();
+        stats.bytes += shard.bytes;
+    }
+
+    stats.lookups    = m_lookups.load(std::memory_order_relaxed);
+    stats.hits       = m_hits.load(std::memory_order_relaxed);
+    stats.bytesSaved = m_bytesSaved.load(std::memory_order_relaxed);
+
+    return stats;
+}
+
+QString StringPool::report() const
+{
+    const Stats poolStats = stats();
+    const double hitRate
+        = poolStats.lookups > 0 ? 100.0 * static_cast<double>(poolStats.hits) / static_cast<double>(poolStats.lookups)
+                                : 0.0;
+
+    return u"String pool: %1 strings (%2), %3 lookups (%4% shared), %5 saved"_s.arg(poolStats.strings)
+        .arg(Utils::formatFileSize(poolStats.bytes))
+        .arg(poolStats.lookups)
+        .arg(hitRate, 0, 'f', 1)
+        .arg(Utils::formatFileSize(poolStats.bytesSaved));
+}
+} // namespace Fooyin
@@ -0,0 +1,91 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "core/database/database.h"
+
+#include <utils/database/dbconnectionprovider.h>
+
+#include <gtest/gtest.h>
+
+#include <QSqlQuery>
+#include <QTemporaryDir>
+
+using namespace Qt::StringLiterals;
+
+namespace Fooyin::Testing {
+class DbQueryPlanTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(m_dir.isValid());
+        m_database = std::make_unique<Database>(m_dir.filePath(u"fooyin.db"_s), u"queryplan"_s);
+        ASSERT_EQ(Database::Status::Ok, m_database->status());
+    }
+
+    // Fails if the plan of @p statement scans the whole of @p table
+    void expectNoScan(const QString& statement, const QString& table) const
+    {
+        const DbConnectionProvider dbProvider{m_database->connectionPool()};
+
+        QSqlQuery query{dbProvider.db()};
+        ASSERT_TRUE(query.exec(u"EXPLAIN QUERY PLAN "_s + statement)) << statement.toStdString();
+
+        // Older SQLite versions use 'SCAN TABLE <table>'
+        const QStringList scans{u"SCAN %1"_s.arg(table), u"SCAN TABLE %1"_s.arg(table)};
+
+        while(query.next()) {
+            const QString detail = query.value(u"detail"_s).toString();
+            for(const QString& scan : scans) {
+                EXPECT_FALSE(detail == scan || detail.startsWith(scan + u" "_s))
+                    << statement.toStdString() << ": " << detail.toStdString();
+            }
+        }
+    }
+
+private:
+    QTemporaryDir m_dir;
+    std::unique_ptr<Database> m_database;
+};
+
+TEST_F(DbQueryPlanTest, TrackLookups)
+{
+    expectNoScan(u"SELECT TrackID FROM Tracks WHERE FilePath = :path AND Subsong = :subsong;"_s, u"Tracks"_s);
+    expectNoScan(u"SELECT * FROM TracksView WHERE TrackID = :trackId;"_s, u"Tracks"_s);
+    expectNoScan(u"SELECT * FROM TracksView WHERE TrackHash = :trackHash;"_s, u"Tracks"_s);
+    expectNoScan(u"SELECT TrackID FROM Tracks WHERE LibraryID = :libraryId AND TrackID "
+                 "NOT IN (SELECT TrackID FROM PlaylistTracks);"_s,
+                 u"Tracks"_s);
+    expectNoScan(u"UPDATE Tracks SET LibraryID = :nonLibraryId WHERE LibraryID = :libraryId;"_s, u"Tracks"_s);
+}
+
+TEST_F(DbQueryPlanTest, StatsLookups)
+{
+    expectNoScan(u"SELECT * FROM TracksView WHERE TrackID = :trackId;"_s, u"TrackStats"_s);
+    expectNoScan(u"SELECT PlayCount, Rating FROM TrackStats WHERE TrackHash = :trackHash;"_s, u"TrackStats"_s);
+}
+
+TEST_F(DbQueryPlanTest, PlaylistLookups)
+{
+    expectNoScan(u"SELECT TrackID, TrackIndex FROM PlaylistTracks WHERE PlaylistID = :playlistId "
+                 "ORDER BY TrackIndex;"_s,
+                 u"PlaylistTracks"_s);
+    expectNoScan(u"DELETE FROM PlaylistTracks WHERE PlaylistID = :id;"_s, u"PlaylistTracks"_s);
+}
+} // namespace Fooyin::Testing
@@ -0,0 +1,46 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <utils/fasthash.h>
+
+#include <gtest/gtest.h>
+
+namespace Fooyin::Testing {
+TEST(FastHashTest, KnownValues)
+{
+    EXPECT_EQ(0xef46db3751d8e999ULL, FastHash::hash(QByteArrayView{""}));
+    EXPECT_EQ(0x44bc2cf5ad770999ULL, FastHash::hash(QByteArrayView{"abc"}));
+    EXPECT_EQ(0xfbcea83c8a378bf1ULL, FastHash::hash(QByteArrayView{"Nobody inspects the spammish repetition"}));
+}
+
+TEST(FastHashTest, Incremental)
+{
+    const QByteArray data{"The quick brown fox jumps over the lazy dog, then does it all over again"};
+
+    FastHash hash;
+    for(qsizetype i{0}; i < data.size(); i += 7) {
+        hash.addData(QByteArrayView{data}.sliced(i, std::min<qsizetype>(7, data.size() - i)));
+    }
+
+    EXPECT_EQ(FastHash::hash(QByteArrayView{data}), hash.result());
+
+    hash.reset();
+    EXPECT_EQ(FastHash::hash(QByteArrayView{""}), hash.result());
+}
+} // namespace Fooyin::Testing
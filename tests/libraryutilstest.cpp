@@ -0,0 +1,78 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "core/library/libraryutils.h"
+
+#include <gtest/gtest.h>
+
+using namespace Qt::StringLiterals;
+
+namespace {
+Fooyin::TrackList makeTracks(int first, int count, const QString& title = {})
+{
+    Fooyin::TrackList tracks;
+    tracks.reserve(count);
+
+    for(int id{first}; id < first + count; ++id) {
+        Fooyin::Track track{u"/music/%1.flac"_s.arg(id)};
+        track.setId(id);
+        track.setTitle(title);
+        tracks.push_back(track);
+    }
+
+    return tracks;
+}
+} // namespace
+
+namespace Fooyin::Testing {
+TEST(LibraryUtilsTest, UpdatesCommonTracks)
+{
+    TrackList tracks        = makeTracks(0, 5);
+    const TrackList updated = makeTracks(3, 4, u"Updated"_s);
+    const std::vector<int> expected{3, 4};
+
+    EXPECT_EQ(expected, Utils::updateCommonTracks(tracks, updated, Utils::CommonOperation::Update));
+    ASSERT_EQ(5U, tracks.size());
+    EXPECT_TRUE(tracks.at(2).title().isEmpty());
+    EXPECT_EQ(u"Updated"_s, tracks.at(3).title());
+    EXPECT_EQ(u"Updated"_s, tracks.at(4).title());
+}
+
+TEST(LibraryUtilsTest, RemovesCommonTracks)
+{
+    TrackList tracks        = makeTracks(0, 5);
+    const TrackList removed = makeTracks(1, 2);
+    const std::vector<int> expected{1, 2};
+
+    EXPECT_EQ(expected, Utils::updateCommonTracks(tracks, removed, Utils::CommonOperation::Remove));
+    ASSERT_EQ(3U, tracks.size());
+    EXPECT_EQ(0, tracks.at(0).id());
+    EXPECT_EQ(3, tracks.at(1).id());
+    EXPECT_EQ(4, tracks.at(2).id());
+}
+
+TEST(LibraryUtilsTest, IgnoresTracksNotInDatabase)
+{
+    TrackList tracks{Track{u"/music/a.flac"_s}, Track{u"/music/b.flac"_s}};
+    const TrackList updated{Track{u"/music/a.flac"_s}};
+
+    EXPECT_TRUE(Utils::updateCommonTracks(tracks, updated, Utils::CommonOperation::Remove).empty());
+    EXPECT_EQ(2U, tracks.size());
+}
+} // namespace Fooyin::Testing
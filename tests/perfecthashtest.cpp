@@ -0,0 +1,74 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <utils/perfecthash.h>
+
+#include <QString>
+
+#include <gtest/gtest.h>
+
+using namespace Qt::StringLiterals;
+
+namespace {
+enum class Field : uint8_t
+{
+    Title = 0,
+    Artist,
+    Album,
+};
+
+constexpr std::array fields{
+    std::pair("TITLE", Field::Title),
+    std::pair("ARTIST", Field::Artist),
+    std::pair("ARTISTS", Field::Artist),
+    std::pair("ALBUM", Field::Album),
+};
+
+constexpr Fooyin::PerfectHashMap Fields{fields};
+constexpr Fooyin::PerfectHashMap CaseSensitiveFields{fields, Qt::CaseSensitive};
+
+static_assert(Fields.find(std::string_view{"ALBUM"}) == Field::Album);
+static_assert(!Fields.contains(std::string_view{"ALBUMS"}));
+} // namespace
+
+namespace Fooyin::Testing {
+TEST(PerfectHashTest, FindsEveryKey)
+{
+    for(const auto& [key, value] : fields) {
+        EXPECT_EQ(value, Fields.find(QString::fromLatin1(key)));
+    }
+}
+
+TEST(PerfectHashTest, IgnoresCase)
+{
+    EXPECT_EQ(Field::Title, Fields.find(u"title"_s));
+    EXPECT_EQ(Field::Artist, Fields.find(u"Artists"_s));
+    EXPECT_FALSE(CaseSensitiveFields.contains(u"title"_s));
+    EXPECT_EQ(Field::Title, CaseSensitiveFields.find(u"TITLE"_s));
+}
+
+TEST(PerfectHashTest, MissingKeys)
+{
+    EXPECT_FALSE(Fields.contains(QString{}));
+    EXPECT_FALSE(Fields.contains(u"TITL"_s));
+    EXPECT_FALSE(Fields.contains(u"TITLES"_s));
+    EXPECT_FALSE(Fields.contains(u"GENRE"_s));
+    EXPECT_FALSE(Fields.contains(u"TÍTLE"_s));
+}
+} // namespace Fooyin::Testing
@@ -0,0 +1,191 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "core/database/database.h"
+#include "core/database/playlistdatabase.h"
+#include "core/database/trackdatabase.h"
+
+#include <core/playlist/playlist.h>
+#include <utils/database/dbconnectionprovider.h>
+
+#include <gtest/gtest.h>
+
+#include <QSqlQuery>
+#include <QTemporaryDir>
+
+#include <algorithm>
+
+using namespace Qt::StringLiterals;
+
+namespace Fooyin::Testing {
+class PlaylistDatabaseTest : public ::testing::Test
+{
+protected:
+    using Type = Playlist::TrackChange::Type;
+
+    void SetUp() override
+    {
+        ASSERT_TRUE(m_dir.isValid());
+        m_database = std::make_unique<Database>(m_dir.filePath(u"fooyin.db"_s), u"playlists"_s);
+        ASSERT_EQ(Database::Status::Ok, m_database->status());
+
+        const DbConnectionProvider dbProvider{m_database->connectionPool()};
+        m_trackDatabase.initialise(dbProvider);
+        m_playlistDatabase.initialise(dbProvider);
+
+        for(int i{0}; i < 10; ++i) {
+            Track track{m_dir.filePath(u"%1.flac"_s.arg(i))};
+            track.generateHash();
+            m_tracks.push_back(track);
+        }
+        ASSERT_TRUE(m_trackDatabase.storeTracks(m_tracks));
+    }
+
+    // Returns the stored tracks at @p indexes
+    [[nodiscard]] TrackList tracks(const std::vector<int>& indexes) const
+    {
+        TrackList tracks;
+        for(const int index : indexes) {
+            tracks.push_back(m_tracks.at(index));
+        }
+        return tracks;
+    }
+
+    // Creates a playlist of @p tracks which has already been saved
+    std::unique_ptr<Playlist> createPlaylist(const TrackList& tracks)
+    {
+        const int dbId = m_playlistDatabase.insertPlaylist(u"Playlist"_s, 0, false, {});
+        EXPECT_GE(dbId, 0);
+
+        auto playlist = Playlist::create(dbId, u"Playlist"_s, 0, nullptr);
+        playlist->appendTracks(tracks);
+        EXPECT_TRUE(m_playlistDatabase.savePlaylist(*playlist));
+        return playlist;
+    }
+
+    static void replaceTracks(Playlist& playlist, const TrackList& tracks)
+    {
+        playlist.replaceTracks(tracks);
+    }
+
+    static void removeTracks(Playlist& playlist, const std::vector<int>& indexes)
+    {
+        playlist.removeTracks(indexes);
+    }
+
+    // Saves @p playlist, which must have recorded @p changes, and checks the stored tracks match it
+    void saveAndCompare(Playlist& playlist, const std::vector<Type>& changes)
+    {
+        const auto trackChanges = playlist.trackChanges();
+        ASSERT_TRUE(trackChanges.has_value());
+
+        std::vector<Type> types;
+        std::ranges::transform(trackChanges.value(), std::back_inserter(types),
+                               [](const Playlist::TrackChange& change) { return change.type; });
+        EXPECT_EQ(changes, types);
+
+        ASSERT_TRUE(m_playlistDatabase.savePlaylist(playlist));
+
+        std::vector<int> expectedIds;
+        std::ranges::transform(playlist.tracks(), std::back_inserter(expectedIds), &Track::id);
+
+        const DbConnectionProvider dbProvider{m_database->connectionPool()};
+        QSqlQuery query{dbProvider.db()};
+        query.prepare(u"SELECT TrackID, TrackIndex FROM PlaylistTracks WHERE PlaylistID = :id ORDER BY TrackIndex;"_s);
+        query.bindValue(u":id"_s, playlist.dbId());
+        ASSERT_TRUE(query.exec());
+
+        std::vector<int> storedIds;
+        while(query.next()) {
+            // Stored indexes are the position of each track in the playlist
+            EXPECT_EQ(static_cast<int>(storedIds.size()), query.value(1).toInt());
+            storedIds.push_back(query.value(0).toInt());
+        }
+
+        EXPECT_EQ(expectedIds, storedIds);
+    }
+
+private:
+    QTemporaryDir m_dir;
+    std::unique_ptr<Database> m_database;
+    TrackDatabase m_trackDatabase;
+    PlaylistDatabase m_playlistDatabase;
+    TrackList m_tracks;
+};
+
+TEST_F(PlaylistDatabaseTest, InsertTracks)
+{
+    auto playlist = createPlaylist(tracks({0, 1, 2, 3, 4}));
+
+    replaceTracks(*playlist, tracks({0, 1, 5, 6, 2, 3, 4}));
+    saveAndCompare(*playlist, {Type::Insert});
+
+    replaceTracks(*playlist, tracks({7, 0, 1, 5, 6, 2, 3, 4}));
+    replaceTracks(*playlist, tracks({7, 0, 1, 5, 6, 2, 3, 4, 8}));
+    saveAndCompare(*playlist, {Type::Insert, Type::Insert});
+}
+
+TEST_F(PlaylistDatabaseTest, RemoveTracks)
+{
+    auto playlist = createPlaylist(tracks({0, 1, 2, 3, 4, 5, 6}));
+
+    removeTracks(*playlist, {1, 4});
+    saveAndCompare(*playlist, {Type::Remove, Type::Remove});
+
+    replaceTracks(*playlist, tracks({0, 2, 3}));
+    saveAndCompare(*playlist, {Type::Remove});
+}
+
+TEST_F(PlaylistDatabaseTest, MoveTracks)
+{
+    auto playlist = createPlaylist(tracks({0, 1, 2, 3, 4, 5}));
+
+    // Single track moved down
+    replaceTracks(*playlist, tracks({1, 2, 3, 0, 4, 5}));
+    saveAndCompare(*playlist, {Type::Move});
+
+    // Single track moved up
+    replaceTracks(*playlist, tracks({1, 5, 2, 3, 0, 4}));
+    saveAndCompare(*playlist, {Type::Move});
+}
+
+TEST_F(PlaylistDatabaseTest, RotateTracks)
+{
+    auto playlist = createPlaylist(tracks({0, 1, 2, 3, 4, 5, 6, 7}));
+
+    // Block of tracks swapped with a block of the same size
+    replaceTracks(*playlist, tracks({0, 4, 5, 6, 1, 2, 3, 7}));
+    saveAndCompare(*playlist, {Type::Move});
+
+    // Larger block rotated past a smaller one, which is moved instead
+    replaceTracks(*playlist, tracks({0, 3, 7, 4, 5, 6, 1, 2}));
+    saveAndCompare(*playlist, {Type::Move});
+}
+
+TEST_F(PlaylistDatabaseTest, MultipleChanges)
+{
+    auto playlist = createPlaylist(tracks({0, 1, 2, 3, 4, 5}));
+
+    replaceTracks(*playlist, tracks({0, 1, 6, 2, 3, 4, 5}));
+    removeTracks(*playlist, {0});
+    replaceTracks(*playlist, tracks({1, 6, 4, 5, 2, 3}));
+    replaceTracks(*playlist, tracks({1, 6, 4, 5, 2, 3, 7, 8}));
+    saveAndCompare(*playlist, {Type::Insert, Type::Remove, Type::Move, Type::Insert});
+}
+} // namespace Fooyin::Testing
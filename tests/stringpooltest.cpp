@@ -0,0 +1,68 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <utils/stringpool.h>
+
+#include <gtest/gtest.h>
+
+using namespace Qt::StringLiterals;
+
+namespace Fooyin::Testing {
+TEST(StringPoolTest, SharesEqualStrings)
+{
+    StringPool pool;
+
+    const QString first  = pool.intern(QString::fromLatin1("Artist"));
+    const QString second = pool.intern(u"Art"_s + u"ist"_s);
+
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(first.constData(), second.constData());
+
+    const auto stats = pool.stats();
+    EXPECT_EQ(1U, stats.strings);
+    EXPECT_EQ(2U, stats.lookups);
+    EXPECT_EQ(1U, stats.hits);
+    EXPECT_EQ(first.size() * sizeof(QChar), stats.bytesSaved);
+}
+
+TEST(StringPoolTest, InternsLists)
+{
+    StringPool pool;
+
+    const QString artist      = pool.intern(u"Artist"_s);
+    const QStringList artists = pool.intern(QStringList{u"Other"_s, u"Art"_s + u"ist"_s, QString{}});
+
+    ASSERT_EQ(3, artists.size());
+    EXPECT_EQ(artist.constData(), artists.at(1).constData());
+    EXPECT_TRUE(artists.at(2).isEmpty());
+}
+
+TEST(StringPoolTest, PruneKeepsReferencedStrings)
+{
+    StringPool pool;
+
+    // Literals aren't reference counted, so are never pruned
+    const QString kept = pool.intern(QString::fromLatin1("Kept"));
+    pool.intern(QString::fromLatin1("Dropped"));
+
+    EXPECT_EQ(1U, pool.prune());
+    EXPECT_EQ(1U, pool.stats().strings);
+    EXPECT_EQ(kept.constData(), pool.intern(u"Kept"_s).constData());
+}
+} // namespace Fooyin::Testing